@@ -0,0 +1,132 @@
+/**
+ * *acquisition-aiding.hpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/acquisition-aiding.hpp
+ * @brief   Visibility and Doppler predictions narrowing acquisition once a fix is available.
+ * @date    October 2026
+ * @ref     1. "Understanding GPS/GNSS Principles and Applications", 3rd Edition, 2017
+ *              - Kaplan & Hegarty
+ *          2. "Global Positioning System: Signals, Measurements, and Performance", 2nd Edition,
+ *              2006 - Misra & Enge
+ * =======  ========================================================================================
+ */
+
+#ifndef STURDR_ACQUISITION_AIDING_HPP
+#define STURDR_ACQUISITION_AIDING_HPP
+
+#include <Eigen/Dense>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <satutils/ephemeris.hpp>
+#include <string>
+#include <vector>
+
+#include "sturdr/acquisition.hpp"
+
+namespace sturdr {
+
+/**
+ * @brief Shared store of GPS ephemerides (decoded by the channels or loaded from an earlier run)
+ *        and of the satellite elevations and Dopplers they predict at the navigator's latest fix.
+ *        Until there is a fix every PRN is searched over the whole Doppler grid, afterwards PRNs
+ *        predicted below the elevation mask are skipped, visible ones are searched highest first
+ *        in a window of the grid around their predicted Doppler
+ */
+class AcquisitionAiding {
+ public:
+  static constexpr uint8_t N_PRN = 32;
+
+  /**
+   * *=== AcquisitionAiding ===*
+   * @brief Constructor
+   * @param elev_mask   Elevation below which a predicted satellite is not searched [rad]
+   * @param dopp_sigma  Standard deviation of a predicted Doppler [Hz]
+   * @param n_sigma     Half width of an aided Doppler window [standard deviations]
+   */
+  AcquisitionAiding(const double &elev_mask, const double &dopp_sigma, const double &n_sigma = 3.0);
+
+  /**
+   * *=== SetEphemeris ===*
+   * @brief Stores (or replaces) the ephemeris of 'prn'
+   * @param prn Satellite PRN (1-32)
+   * @param eph Broadcast ephemeris
+   */
+  void SetEphemeris(const uint8_t &prn, const satutils::KeplerElements<double> &eph);
+
+  /**
+   * *=== LoadEphemerides ===*
+   * @brief Reads an ephemeris log of an earlier run (records of a PRN byte followed by its
+   *        elements, as the navigator writes them), the last record of each PRN is kept
+   * @param fname Ephemeris log file
+   * @return Number of PRNs loaded
+   */
+  std::size_t LoadEphemerides(const std::string &fname);
+
+  /**
+   * *=== Predict ===*
+   * @brief Predicts the elevation and Doppler of every PRN with an ephemeris at a receiver fix
+   * @param tow       GPS time of week of the fix [s]
+   * @param xyz       Receiver ECEF position [m]
+   * @param xyzv      Receiver ECEF velocity [m/s]
+   * @param clk_drift Receiver clock drift [m/s]
+   */
+  void Predict(
+      const double &tow,
+      const Eigen::Vector3d &xyz,
+      const Eigen::Vector3d &xyzv,
+      const double &clk_drift);
+
+  /**
+   * *=== HasFix ===*
+   * @brief True once predictions have been made
+   */
+  bool HasFix() const;
+
+  /**
+   * *=== Generation ===*
+   * @brief Number of predictions made (0 until there is a fix), read without locking so users of
+   *        the search order only copy it when it changed
+   */
+  uint32_t Generation() const;
+
+  /**
+   * *=== SearchOrder ===*
+   * @brief PRNs worth searching, predicted visible ones by decreasing elevation followed by those
+   *        without an ephemeris (every PRN in order until there is a fix)
+   */
+  std::vector<uint8_t> SearchOrder() const;
+
+  /**
+   * *=== Window ===*
+   * @brief Doppler bins of the search grid covering the prediction of 'prn' (the whole grid when
+   *        there is no prediction)
+   * @param prn     Satellite PRN (1-32)
+   * @param d_range Max doppler frequency of the grid [Hz]
+   * @param d_step  Frequency step of the grid [Hz]
+   */
+  DopplerWindow Window(const uint8_t &prn, const double &d_range, const double &d_step) const;
+
+ private:
+  struct Prediction {
+    bool valid;
+    double elevation;  // [rad]
+    double doppler;    // [Hz]
+  };
+
+  mutable std::mutex mtx_;
+  double elev_mask_;
+  double dopp_sigma_;
+  double n_sigma_;
+  bool has_fix_;
+  std::atomic<uint32_t> generation_;
+  std::array<bool, N_PRN> has_eph_;
+  std::array<satutils::KeplerEphem<double>, N_PRN> sv_;
+  std::array<Prediction, N_PRN> pred_;
+};
+
+}  // namespace sturdr
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * *acquisition-engine.hpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/acquisition-engine.hpp
+ * @brief   Worker pool searching sample snapshots outside of the tracking barrier.
+ * @date    October 2026
+ * @ref     1. "Understanding GPS/GNSS Principles and Applications", 3rd Edition, 2017
+ *              - Kaplan & Hegarty
+ * =======  ========================================================================================
+ */
+
+#ifndef STURDR_ACQUISITION_ENGINE_HPP
+#define STURDR_ACQUISITION_ENGINE_HPP
+
+#include <Eigen/Dense>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "sturdr/acquisition-workspace.hpp"
+#include "sturdr/acquisition.hpp"
+#include "sturdr/concurrent-queue.hpp"
+#include "sturdr/sample-ring.hpp"
+
+namespace sturdr {
+
+/**
+ * @brief One asynchronous search, a private copy of the samples it covers and, once 'done' is
+ *        set, the result of every requested PRN
+ */
+struct AcquisitionJob {
+  uint64_t ptr;  // ring sample the snapshot starts at
+  std::vector<uint8_t> prns;
+  std::vector<DopplerWindow> windows;  // Doppler bins searched per PRN (all when missing)
+  Eigen::VectorXcd data;
+  Eigen::VectorXcf data_f;
+  std::vector<AcquisitionResult> results;
+  std::atomic<bool> done{false};
+};
+
+/**
+ * @brief Channels hand their acquisition searches to this pool instead of running PcpsSearch
+ *        between the tracking barriers. A submitted job owns a snapshot of its samples, so the
+ *        channel keeps consuming the ring while the search runs and re-aligns to the code period
+ *        found once the job completes
+ */
+class AcquisitionEngine {
+ public:
+  /**
+   * *=== AcquisitionEngine ===*
+   * @brief Constructor, starts the workers
+   * @param ctx       Shared acquisition context
+   * @param ctx_f     Shared single precision acquisition context (nullptr to search in double)
+   * @param pool      Shared workspaces of 'ctx' (borrowed per job)
+   * @param pool_f    Shared workspaces of 'ctx_f'
+   * @param c_per     Number of coherent integrations to perform
+   * @param nc_per    Number of non-coherent periods to accumulate
+   * @param n_workers Number of search threads (>= 1)
+   */
+  AcquisitionEngine(
+      std::shared_ptr<AcquisitionContext> ctx,
+      std::shared_ptr<AcquisitionContextF> ctx_f,
+      std::shared_ptr<AcquisitionWorkspacePool> pool,
+      std::shared_ptr<AcquisitionWorkspacePoolF> pool_f,
+      const uint8_t &c_per,
+      const uint8_t &nc_per,
+      const uint16_t &n_workers);
+
+  /**
+   * *=== ~AcquisitionEngine ===*
+   * @brief Destructor, drops pending jobs and joins the workers
+   */
+  ~AcquisitionEngine();
+
+  /**
+   * *=== Submit ===*
+   * @brief Copies 'n_samp' samples of the first antenna of 'rfdata' at 'ptr' and queues a search
+   *        of 'prns' over them (must be called while the ring segment is valid)
+   * @param rfdata  Shared sample ring
+   * @param ptr     First sample in the ring
+   * @param n_samp  Number of samples to search
+   * @param prns    Satellite PRNs to search for
+   * @param windows Doppler bins to search for each PRN (every bin when empty)
+   * @return Handle polled by the channel for completion
+   */
+  std::shared_ptr<AcquisitionJob> Submit(
+      const SampleRing &rfdata,
+      const uint64_t &ptr,
+      const uint64_t &n_samp,
+      const std::vector<uint8_t> &prns,
+      const std::vector<DopplerWindow> &windows = {});
+
+  /**
+   * *=== Stop ===*
+   * @brief Stops accepting jobs and joins the workers
+   */
+  void Stop();
+
+ private:
+  std::shared_ptr<AcquisitionContext> ctx_;
+  std::shared_ptr<AcquisitionContextF> ctx_f_;
+  std::shared_ptr<AcquisitionWorkspacePool> pool_;
+  std::shared_ptr<AcquisitionWorkspacePoolF> pool_f_;
+  uint8_t c_per_;
+  uint8_t nc_per_;
+  ConcurrentQueue queue_;
+  std::vector<std::thread> workers_;
+
+  /**
+   * *=== Work ===*
+   * @brief Worker thread, searches queued jobs until the queue is finished
+   */
+  void Work();
+};
+
+}  // namespace sturdr
+
+#endif
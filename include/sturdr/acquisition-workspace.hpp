@@ -0,0 +1,187 @@
+/**
+ * *acquisition-workspace.hpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/acquisition-workspace.hpp
+ * @brief   Preallocated buffers for acquisition searches and a bounded pool sharing them.
+ * @date    October 2026
+ * @ref     1. "Understanding GPS/GNSS Principles and Applications", 3rd Edition, 2017
+ *              - Kaplan & Hegarty
+ * =======  ========================================================================================
+ */
+
+#ifndef STURDR_ACQUISITION_WORKSPACE_HPP
+#define STURDR_ACQUISITION_WORKSPACE_HPP
+
+#include <Eigen/Dense>
+#include <complex>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "sturdr/peak-detector.hpp"
+
+namespace sturdr {
+
+/**
+ * @brief Every buffer one search writes, sized once and zeroed at construction so each page is
+ *        resident before the first search (Eigen aligns them to EIGEN_MAX_ALIGN_BYTES). Buffers
+ *        the configured searches never touch are left empty (a search resizes them if needed)
+ */
+template <typename Real>
+struct BasicAcquisitionWorkspace {
+  using VectorXc = Eigen::VectorX<std::complex<Real>>;
+  using MatrixXc = Eigen::MatrixX<std::complex<Real>>;
+
+  MatrixXc x_carr;                     // code wiped spectra / inverse transforms (n_samp x n_bins)
+  MatrixXc coh_sum;                    // coherent sum (n_samp x n_bins, c_per > 1)
+  Eigen::MatrixX<Real> corr_map;       // non-coherent power (n_samp x n_bins, or empty)
+  MatrixXc spec;                       // wiped spectra of one period (n_samp x n_spec, freq_domain)
+  std::vector<MatrixXc> period_spec;   // wiped spectra of every period (batched PcpsSearchMany)
+  VectorXc fft_buf;                    // one aligned transform (n_samp)
+  VectorXc dec_data;                   // decimated samples of a search (n_samp * n_per, decimating)
+  std::vector<ColumnStats> col_stats;  // per Doppler column statistics (n_bins)
+  PeakDetector detector;               // statistics and candidates of the last detection
+
+  /**
+   * *=== BasicAcquisitionWorkspace ===*
+   * @brief Constructor
+   * @param n_samp      Samples per code period (at the acquisition rate)
+   * @param n_bins      Number of Doppler bins
+   * @param n_spec      Columns of the wiped spectra (see BasicAcquisitionContext::SpectraCols)
+   * @param c_per       Coherent periods per search
+   * @param nc_per      Non-coherent periods per search
+   * @param decimation  Front end samples per acquisition sample (see
+   *                    BasicAcquisitionContext::Decimation)
+   * @param freq_domain Searches rotate the spectrum of one period (see
+   *                    BasicAcquisitionContext::FreqDomain)
+   * @param batched     Searches run through PcpsSearchMany (asynchronous acquisition engine)
+   * @param keep_map    False leaves the power map empty, enough when searches only detect (see
+   *                    PcpsDetect) over a single non-coherent period
+   * @param top_k       Doppler bin candidates kept by the detector
+   */
+  BasicAcquisitionWorkspace(
+      const uint64_t &n_samp,
+      const uint64_t &n_bins,
+      const uint64_t &n_spec,
+      const uint8_t &c_per,
+      const uint8_t &nc_per,
+      const uint64_t &decimation = 1,
+      const bool &freq_domain = false,
+      const bool &batched = false,
+      const bool &keep_map = true,
+      const std::size_t &top_k = 1)
+      : x_carr{MatrixXc::Zero(n_samp, n_bins)},
+        coh_sum{MatrixXc::Zero(c_per > 1 ? n_samp : 0, c_per > 1 ? n_bins : 0)},
+        corr_map{Eigen::MatrixX<Real>::Zero(keep_map ? n_samp : 0, keep_map ? n_bins : 0)},
+        spec{MatrixXc::Zero(freq_domain ? n_samp : 0, freq_domain ? n_spec : 0)},
+        period_spec(
+            batched ? static_cast<std::size_t>(c_per) * nc_per : 0,
+            MatrixXc::Zero(batched ? n_samp : 0, batched ? n_spec : 0)),
+        fft_buf{VectorXc::Zero(n_samp)},
+        dec_data{VectorXc::Zero(decimation > 1 ? n_samp * c_per * nc_per : 0)},
+        col_stats(n_bins),
+        detector(top_k) {};
+};
+
+// double precision (default) and single precision workspaces
+using AcquisitionWorkspace = BasicAcquisitionWorkspace<double>;
+using AcquisitionWorkspaceF = BasicAcquisitionWorkspace<float>;
+
+/**
+ * @brief Fixed set of workspaces lent to searching threads. All workspaces are built up front and
+ *        a borrower blocks while every one is in use, so the number of concurrent acquisitions,
+ *        and with it the acquisition memory, is bounded by the pool size
+ */
+template <typename Real>
+class BasicAcquisitionWorkspacePool {
+ public:
+  using Workspace = BasicAcquisitionWorkspace<Real>;
+
+  /**
+   * *=== BasicAcquisitionWorkspacePool ===*
+   * @brief Constructor, builds and touches every workspace
+   * @param n_samp          Samples per code period
+   * @param n_bins          Number of Doppler bins
+   * @param n_spec          Columns of the wiped spectra
+   * @param c_per           Coherent periods per search
+   * @param nc_per          Non-coherent periods per search
+   * @param decimation      Front end samples per acquisition sample
+   * @param freq_domain     Searches rotate the spectrum of one period
+   * @param batched         Searches run through PcpsSearchMany
+   * @param max_concurrent  Number of workspaces (>= 1)
+   * @param keep_map        Allocate the power maps (see BasicAcquisitionWorkspace)
+   * @param top_k           Doppler bin candidates kept by each detector
+   */
+  BasicAcquisitionWorkspacePool(
+      const uint64_t &n_samp,
+      const uint64_t &n_bins,
+      const uint64_t &n_spec,
+      const uint8_t &c_per,
+      const uint8_t &nc_per,
+      const uint64_t &decimation,
+      const bool &freq_domain,
+      const bool &batched,
+      const uint16_t &max_concurrent,
+      const bool &keep_map = true,
+      const std::size_t &top_k = 1) {
+    for (uint16_t i = 0; i < (max_concurrent > 0 ? max_concurrent : 1); i++) {
+      all_.push_back(std::make_unique<Workspace>(
+          n_samp,
+          n_bins,
+          n_spec,
+          c_per,
+          nc_per,
+          decimation,
+          freq_domain,
+          batched,
+          keep_map,
+          top_k));
+      free_.push_back(all_.back().get());
+    }
+  };
+
+  /**
+   * *=== Borrow ===*
+   * @brief Blocks until a workspace is free and lends it, it returns to the pool when the last
+   *        copy of the handle is released (the pool must outlive its handles)
+   * @return Workspace handle
+   */
+  std::shared_ptr<Workspace> Borrow() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    cv_.wait(lock, [this] { return !free_.empty(); });
+    Workspace *ws = free_.back();
+    free_.pop_back();
+    return std::shared_ptr<Workspace>(ws, [this](Workspace *w) { Return(w); });
+  };
+
+  /**
+   * *=== Size ===*
+   * @brief Number of workspaces in the pool
+   */
+  std::size_t Size() const {
+    return all_.size();
+  };
+
+ private:
+  std::vector<std::unique_ptr<Workspace>> all_;
+  std::vector<Workspace *> free_;
+  std::mutex mtx_;
+  std::condition_variable cv_;
+
+  void Return(Workspace *ws) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    free_.push_back(ws);
+    cv_.notify_one();
+  };
+};
+
+// double precision (default) and single precision pools
+using AcquisitionWorkspacePool = BasicAcquisitionWorkspacePool<double>;
+using AcquisitionWorkspacePoolF = BasicAcquisitionWorkspacePool<float>;
+
+}  // namespace sturdr
+
+#endif
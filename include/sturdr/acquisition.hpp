@@ -20,8 +20,14 @@
 
 #include <Eigen/Dense>
 #include <array>
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
+#include "sturdr/acquisition-workspace.hpp"
 #include "sturdr/fftw-wrapper.hpp"
+#include "sturdr/worker-pool.hpp"
 
 namespace sturdr {
 
@@ -60,17 +66,300 @@ namespace sturdr {
 //     const double &code_freq,
 //     const double &intmd_freq);
 
+/**
+ * @brief Read-only acquisition constants shared by every channel. Holds the fft plans, the
+ *        conjugated, normalized spectrum of every GPS L1 C/A code at the front end sampling
+ *        rate and the carrier replica of every Doppler bin, so a search only transforms data.
+ *        The coherent search length is always one code period (coherent integrations are summed
+ *        one period at a time), so one spectrum per PRN serves every configured 'c_per'. With an
+ *        acquisition rate below the front end rate, searches first mix their samples to baseband
+ *        and decimate them (see Decimate), so every spectrum and transform is that much shorter
+ */
+template <typename Real>
+class BasicAcquisitionContext {
+ public:
+  using VectorXc = Eigen::VectorX<std::complex<Real>>;
+  using MatrixXc = Eigen::MatrixX<std::complex<Real>>;
+
+  static constexpr uint8_t N_PRN = 32;
+
+  /**
+   * *=== BasicAcquisitionContext ===*
+   * @brief Constructor, builds all code spectra and (unless 'cache_carrier' is false) the carrier
+   *        replica, must be called before channel threads share it
+   * @param plans         FFT plans of the chosen precision (plans of one searched code period
+   *                      are created here)
+   * @param samp_freq     Front end sampling frequency [Hz]
+   * @param code_freq     GNSS signal code frequency [Hz]
+   * @param intmd_freq    Intermediate frequency of the RF signal [Hz]
+   * @param d_range       Max doppler frequency to search [Hz]
+   * @param d_step        Frequency step for doppler search [Hz]
+   * @param cache_carrier Store the n_samp x n_bins carrier replica (false generates it on the fly
+   *                      with a phasor recurrence on every search)
+   * @param freq_domain   Search Doppler by rotating data spectra instead of wiping every bin in
+   *                      time (see WipedSpectra), the replica is then never built
+   * @param acq_freq      Lowest acquisition sampling frequency [Hz], the front end rate is divided
+   *                      by the largest factor of its samples per code period that stays above it
+   *                      (0 searches at the front end rate)
+   */
+  BasicAcquisitionContext(
+      std::shared_ptr<BasicFftwWrapper<Real>> plans,
+      const double &samp_freq,
+      const double &code_freq,
+      const double &intmd_freq,
+      const double &d_range,
+      const double &d_step,
+      const bool &cache_carrier = true,
+      const bool &freq_domain = false,
+      const double &acq_freq = 0.0);
+
+  /**
+   * *=== Decimate ===*
+   * @brief Acquisition front end, mixes front end samples by the intermediate frequency and
+   *        integrates and dumps every Decimation() of them, output sample 'k' sums inputs
+   *        [FullRateSample(k), FullRateSample(k + 1)). Integrate-and-dump is a sinc low-pass, not
+   *        a compensated FIR/CIC decimator: white front end noise stays white and loses nothing
+   *        (the sum is matched to the rectangular chips), but noise and interference beyond
+   *        +/-fs/(2*D) alias onto the baseband with only the sinc sidelobe rejection (13 dB at the
+   *        first), so coloured front end noise or an out-of-band interferer raises the noise floor.
+   *        The coarser code phase grid adds straddle loss, measured from 8.184 to 2.046 MS/s as
+   *        ~1.1 dB on average and 2.5 dB at half an output sample
+   * @param rfdata  Front end samples (a whole number of code periods)
+   * @param out     Output at the acquisition rate (resized to rfdata.size() / Decimation())
+   */
+  void Decimate(const Eigen::Ref<const VectorXc> &rfdata, VectorXc &out) const;
+
+  /**
+   * *=== FullRateSample ===*
+   * @brief Front end sample of a code phase found at the acquisition rate (the decimated code
+   *        spectra sample the code at every Decimation()'th front end instant, so a lag of one
+   *        acquisition sample is exactly Decimation() front end samples)
+   * @param samp  Code phase [acquisition rate samples]
+   * @return Code phase [front end samples]
+   */
+  int FullRateSample(const int &samp) const {
+    return samp * static_cast<int>(decim_);
+  }
+
+  /**
+   * *=== WipeCarrier ===*
+   * @brief Mixes one code period of data with the carrier of every Doppler bin
+   * @param rfdata  One code period of data samples
+   * @param x_carr  Output, one column per Doppler bin (resized to n_samp x n_bins)
+   * @param col     First Doppler bin of a block (x_carr must already be sized)
+   * @param ncol    Number of Doppler bins of the block (-1 for all bins)
+   */
+  void WipeCarrier(
+      const Eigen::Ref<const VectorXc> &rfdata,
+      MatrixXc &x_carr,
+      const Eigen::Index &col = 0,
+      const Eigen::Index &ncol = -1) const;
+
+  /**
+   * *=== WipedSpectra ===*
+   * @brief PRN independent half of a search, the carrier wiped spectra of one code period. In the
+   *        time domain every bin is carrier wiped and transformed (one column per bin). In the
+   *        frequency domain a bin 'k' fft bins plus a residue 'r' away from zero is the spectrum
+   *        of the data wiped by 'r' rotated by 'k', so only one forward transform per distinct
+   *        residue of the Doppler grid (the fractional sub-grid, e.g. 4 for 250 Hz steps of 1 kHz
+   *        fft bins) is needed (one column per residue)
+   * @param rfdata  One code period of data samples
+   * @param spec    Output wiped spectra (n_samp x SpectraCols(), resized as needed)
+   * @param buf     Aligned scratch of one transform (n_samp, resized as needed)
+   */
+  void WipedSpectra(const Eigen::Ref<const VectorXc> &rfdata, MatrixXc &spec, VectorXc &buf) const;
+
+  /**
+   * *=== CodeWipe ===*
+   * @brief PRN dependent half of a search, multiplies the wiped spectra by the code spectrum of
+   *        'prn' (rotating residue spectra to their bins in the frequency domain)
+   * @param spec    Wiped spectra from WipedSpectra (may be 'x_carr' in the time domain)
+   * @param prn     Satellite PRN
+   * @param x_carr  Output, one column per Doppler bin ready for the inverse transform
+   * @param col     First Doppler bin of a block (x_carr must already be sized)
+   * @param ncol    Number of Doppler bins of the block (-1 for all bins)
+   */
+  void CodeWipe(
+      const MatrixXc &spec,
+      const uint8_t &prn,
+      MatrixXc &x_carr,
+      const Eigen::Index &col = 0,
+      const Eigen::Index &ncol = -1) const;
+
+  /**
+   * *=== SetWorkers ===*
+   * @brief Splits the Doppler bins of every search into one block per thread of 'workers' and
+   *        creates the FFT plans of those blocks (call before channel threads share the context)
+   * @param workers Shared worker pool (nullptr searches every bin in the calling thread)
+   */
+  void SetWorkers(std::shared_ptr<WorkerPool> workers);
+
+  /**
+   * *=== Workers ===*
+   * @brief Worker pool splitting the Doppler bins, or nullptr
+   */
+  WorkerPool *Workers() const {
+    return workers_.get();
+  }
+
+  /**
+   * *=== Plans ===*
+   * @brief Shared FFT plans
+   */
+  BasicFftwWrapper<Real> &Plans() const {
+    return *plans_;
+  }
+
+  /**
+   * *=== CodeSpectrum ===*
+   * @brief Conjugated code spectrum of 'prn' (1-32) divided by the samples per code period
+   */
+  const VectorXc &CodeSpectrum(const uint8_t &prn) const {
+    return code_fft_[prn - 1];
+  }
+
+  /**
+   * *=== SampFreq ===*
+   * @brief Sampling frequency the spectra were built for (the acquisition rate) [Hz]
+   */
+  const double &SampFreq() const {
+    return samp_freq_;
+  }
+
+  /**
+   * *=== PeriodSamples ===*
+   * @brief Samples of one code period at the acquisition rate
+   */
+  const uint64_t &PeriodSamples() const {
+    return n_samp_;
+  }
+
+  /**
+   * *=== Decimation ===*
+   * @brief Front end samples per acquisition sample (1 when searching at the front end rate)
+   */
+  const uint64_t &Decimation() const {
+    return decim_;
+  }
+
+  /**
+   * *=== DopplerBins ===*
+   * @brief Searched carrier frequencies, including the intermediate frequency unless it is mixed
+   *        out by Decimate [Hz]
+   */
+  const Eigen::VectorXd &DopplerBins() const {
+    return dopp_bins_;
+  }
+
+  /**
+   * *=== SpectraCols ===*
+   * @brief Columns written by WipedSpectra (residues in the frequency domain, bins otherwise)
+   */
+  Eigen::Index SpectraCols() const {
+    return freq_domain_ ? res_carr_.cols() : dopp_bins_.size();
+  }
+
+  /**
+   * *=== CachesCarrier ===*
+   * @brief True when the carrier replica is stored rather than generated per search
+   */
+  bool CachesCarrier() const {
+    return carr_rep_.size() > 0;
+  }
+
+  /**
+   * *=== FreqDomain ===*
+   * @brief True when Doppler bins are searched as rotations of the data spectrum
+   */
+  const bool &FreqDomain() const {
+    return freq_domain_;
+  }
+
+ private:
+  std::shared_ptr<BasicFftwWrapper<Real>> plans_;
+  uint64_t decim_;   // front end samples per acquisition sample
+  double mix_freq_;  // carrier removed before decimating [Hz]
+  double samp_freq_;
+  uint64_t n_samp_;
+  Eigen::VectorXd dopp_bins_;
+  std::array<VectorXc, N_PRN> code_fft_;
+  MatrixXc carr_rep_;
+
+  // frequency domain search, residue carriers and each bin's residue and whole fft bin rotation
+  bool freq_domain_;
+  MatrixXc res_carr_;
+  std::vector<Eigen::Index> bin_res_;
+  std::vector<Eigen::Index> bin_shift_;
+
+  std::shared_ptr<WorkerPool> workers_;
+};
+
+// double precision (default) and single precision acquisition constants
+using AcquisitionContext = BasicAcquisitionContext<double>;
+using AcquisitionContextF = BasicAcquisitionContext<float>;
+
+/**
+ * *=== CodeSpectrum ===*
+ * @brief Upsamples one code period and returns its conjugated spectrum divided by the number of
+ *        samples, the form PcpsSearch multiplies the data spectrum by
+ * @param    p           FFT plans of the chosen precision
+ * @param    code        Local code (not upsampled)
+ * @param    samp_freq   Front end sampling frequency [Hz]
+ * @param    code_freq   GNSS signal code frequency [Hz]
+ * @return Conjugated, normalized code spectrum
+ */
+template <typename Real>
+Eigen::VectorX<std::complex<Real>> CodeSpectrum(
+    BasicFftwWrapper<Real> &p,
+    const bool code[1023],
+    const double &samp_freq,
+    const double &code_freq);
+
+/**
+ * *=== CarrierReplica ===*
+ * @brief Carrier wipeoff replica exp(-i*2*pi*f*t) of one code period for every Doppler bin
+ * @param    dopp_bins   Carrier frequencies, including the intermediate frequency [Hz]
+ * @param    samp_freq   Front end sampling frequency [Hz]
+ * @return n_samp x n_bins carrier replica
+ */
+template <typename Real>
+Eigen::MatrixX<std::complex<Real>> CarrierReplica(
+    const Eigen::VectorXd &dopp_bins, const double &samp_freq);
+
+/**
+ * @brief Contiguous Doppler bins of a search, an aided search narrows the grid to the bins around
+ *        a predicted Doppler
+ */
+struct DopplerWindow {
+  int first_bin = 0;
+  int num_bins = -1;  // -1 for every bin from 'first_bin' on
+};
+
+/**
+ * @brief Peak of one PRN's correlation map
+ */
+struct AcquisitionResult {
+  uint8_t prn;
+  int peak_idx[2];  // code phase [samples], Doppler bin
+  double metric;
+  double code_phase = 0.0;  // interpolated code phase [front end samples]
+  double bin = 0.0;         // interpolated Doppler bin
+  double code_var = 0.0;    // variance of 'code_phase' [samples^2]
+  double bin_var = 0.0;     // variance of 'bin' [bins^2]
+};
+
 //! === SerialSearch ===
 
 /**
  * *=== PcpsSearch ===*
- * @brief Implementation of the parallel code phase search (PCPS) method
+ * @brief Implementation of the parallel code phase search (PCPS) method, in double or single
+ *        precision depending on the fftw plans passed (replicas are always built in double)
+ * @param    p           FFT plans of the chosen precision
  * @param    rfdata      Data samples recorded by the RF front end
- * @param    code        Local code (not upsampled)
+ * @param    code_fft    Conjugated code spectrum (see CodeSpectrum/BasicAcquisitionContext)
  * @param    d_range     Max doppler frequency to search [Hz]
  * @param    d_step      Frequency step for doppler search [Hz]
  * @param    samp_freq   Front end sampling frequency [Hz]
- * @param    code_freq   GNSS signal code frequency [Hz]
  * @param    intmd_freq  Intermediate frequency of the RF signal [Hz]
  * @param    c_per       Number of coherent integrations to perform, by default 1
  * @param    nc_per      Number of non-coherent periods to accumulate, by default 1
@@ -82,28 +371,126 @@ namespace sturdr {
 //     const uint8_t &nc_per,
 //     const uint8_t &prn,
 //     AcquisitionSetup &acq_setup);
-Eigen::MatrixXd PcpsSearch(
-    FftwWrapper &p,
-    const Eigen::VectorXcd &rfdata,
-    const bool code[1023],
+template <typename Real>
+Eigen::MatrixX<Real> PcpsSearch(
+    BasicFftwWrapper<Real> &p,
+    const Eigen::Ref<const Eigen::VectorX<std::complex<Real>>> &rfdata,
+    const Eigen::Ref<const Eigen::VectorX<std::complex<Real>>> &code_fft,
     const double &d_range,
     const double &d_step,
     const double &samp_freq,
-    const double &code_freq,
     const double &intmd_freq,
     const uint8_t &c_per,
     const uint8_t &nc_per);
 
+/**
+ * *=== PcpsSearch ===*
+ * @brief Parallel code phase search with the shared plans, code spectra and carrier replica of an
+ *        acquisition context, every intermediate lives in the workspace so nothing is allocated
+ *        (the map has one row per acquisition rate sample, see BasicAcquisitionContext::Decimate)
+ * @param    ctx         Shared acquisition context of the chosen precision
+ * @param    ws          Workspace sized for 'ctx' (see BasicAcquisitionWorkspacePool)
+ * @param    rfdata      Data samples recorded by the RF front end
+ * @param    prn         Satellite PRN to search for
+ * @param    c_per       Number of coherent integrations to perform, by default 1
+ * @param    nc_per      Number of non-coherent periods to accumulate, by default 1
+ * @return 2D correlation results (the workspace map, valid until its next search)
+ */
+template <typename Real>
+const Eigen::MatrixX<Real> &PcpsSearch(
+    const BasicAcquisitionContext<Real> &ctx,
+    BasicAcquisitionWorkspace<Real> &ws,
+    const Eigen::Ref<const Eigen::VectorX<std::complex<Real>>> &rfdata,
+    const uint8_t &prn,
+    const uint8_t &c_per,
+    const uint8_t &nc_per);
+
+/**
+ * *=== PcpsDetect ===*
+ * @brief Parallel code phase search reduced to its peak as the inverse transforms complete. The
+ *        workspace detector streams the peak, mean, variance (and input power for GlrtMetric) of
+ *        every Doppler column and keeps its strongest bins as candidates, so the map is never read
+ *        back and is only stored when asked for (or needed to sum several non-coherent periods)
+ * @param    ctx         Shared acquisition context of the chosen precision
+ * @param    ws          Workspace sized for 'ctx', holds the detector after the search
+ * @param    rfdata      Data samples recorded by the RF front end
+ * @param    prn         Satellite PRN to search for
+ * @param    c_per       Number of coherent integrations to perform, by default 1
+ * @param    nc_per      Number of non-coherent periods to accumulate, by default 1
+ * @param    keep_map    Also leave the full map in 'ws.corr_map'
+ * @param    window      Doppler bins searched (the whole grid by default), the noise floor is
+ *                       estimated over the window only
+ * @return Peak (code phase in front end samples, Doppler bin of the whole grid) and
+ *         Peak2NoiseFloorTest metric, refined between cells by parabolas through the peak power
+ *         and its code and Doppler neighbours
+ */
+template <typename Real>
+AcquisitionResult PcpsDetect(
+    const BasicAcquisitionContext<Real> &ctx,
+    BasicAcquisitionWorkspace<Real> &ws,
+    const Eigen::Ref<const Eigen::VectorX<std::complex<Real>>> &rfdata,
+    const uint8_t &prn,
+    const uint8_t &c_per,
+    const uint8_t &nc_per,
+    const bool &keep_map = false,
+    const DopplerWindow &window = {});
+
+/**
+ * *=== PcpsSearchMany ===*
+ * @brief Parallel code phase search of several PRNs over the same samples. The carrier wiped
+ *        spectra of every period are computed once and only the code multiply and inverse
+ *        transforms are repeated per PRN, each map is streamed into the workspace detector (see
+ *        PcpsDetect) and reduced to its Peak2NoiseFloorTest result without being stored
+ * @param    ctx         Shared acquisition context of the chosen precision
+ * @param    ws          Workspace sized for 'ctx' and 'c_per * nc_per' periods
+ * @param    rfdata      Data samples recorded by the RF front end
+ * @param    prns        Satellite PRNs to search for
+ * @param    c_per       Number of coherent integrations to perform, by default 1
+ * @param    nc_per      Number of non-coherent periods to accumulate, by default 1
+ * @param    windows     Doppler bins searched for each PRN (empty searches the whole grid)
+ * @return Peak (code phase in front end samples), refined peak (see PcpsDetect) and metric of
+ *         every PRN (in the order of 'prns')
+ */
+template <typename Real>
+std::vector<AcquisitionResult> PcpsSearchMany(
+    const BasicAcquisitionContext<Real> &ctx,
+    BasicAcquisitionWorkspace<Real> &ws,
+    const Eigen::Ref<const Eigen::VectorX<std::complex<Real>>> &rfdata,
+    const std::vector<uint8_t> &prns,
+    const uint8_t &c_per,
+    const uint8_t &nc_per,
+    const std::vector<DopplerWindow> &windows = {});
+
+/**
+ * *=== AdvanceCodePhase ===*
+ * @brief Moves a result found in an earlier block of samples to a later one. The code rate is
+ *        scaled by the same Doppler as the carrier, so a code period is 'doppler / carr_freq' of a
+ *        period short and the code phase slides back by that fraction of the elapsed samples
+ * @param result    Search result, its integer and interpolated code phases are advanced in place
+ * @param doppler   Carrier Doppler of the result [Hz]
+ * @param carr_freq Carrier frequency of the signal [Hz]
+ * @param elapsed   Samples from the start of the searched code period to the later one
+ * @param n_samp    Samples per code period [front end samples]
+ */
+void AdvanceCodePhase(
+    AcquisitionResult &result,
+    const double &doppler,
+    const double &carr_freq,
+    const uint64_t &elapsed,
+    const uint64_t &n_samp);
+
 //! === Peak2PeakTest ===
 
 /**
  * *=== Peak2NoiseFloorTest ===*
- * @brief Compares the two highest peak to the noise floor of the acquisition plane
+ * @brief Compares the two highest peak to the noise floor of the acquisition plane (statistics
+ *        are always summed in double)
  * @param corr_map       2D-array from correlation method
  * @param peak_idx       Indexes of highest correlation peak
  * @param metric         Ratio between the highest peak and noise
  */
-void Peak2NoiseFloorTest(const Eigen::MatrixXd &corr_map, int peak_idx[2], double &metric);
+template <typename Real>
+void Peak2NoiseFloorTest(const Eigen::MatrixX<Real> &corr_map, int peak_idx[2], double &metric);
 
 /**
  * *=== GlrtTest ===*
@@ -0,0 +1,69 @@
+/**
+ * *array-correlator.hpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/array-correlator.hpp
+ * @brief   Antenna-parallel early/prompt/late correlators on antenna-interleaved sample blocks.
+ * @date    October 2026
+ * @ref     1. "Intel 64 and IA-32 Architectures Optimization Reference Manual", 2023 - Intel
+ *          2. "Understanding GPS/GNSS Principles and Applications", 3rd Edition, 2017
+ *              - Kaplan & Hegarty
+ * =======  ========================================================================================
+ */
+
+#ifndef STURDR_ARRAY_CORRELATOR_HPP
+#define STURDR_ARRAY_CORRELATOR_HPP
+
+#include <complex>
+#include <cstdint>
+
+#include "sturdr/carrier-nco.hpp"
+
+namespace sturdr {
+
+// samples x antennas held in one interleaved block (16 kB of re/im planes, stays in L1)
+constexpr int ARRAY_BLOCK_VALUES = 1024;
+
+/**
+ * *=== AccumulateEPLArraySoa ===*
+ * @brief Early/prompt/late accumulation for every antenna of an array at once. Each block of
+ *        samples is transposed from the per-antenna columns into sample-major re/im planes
+ *        (value (k, a) at k*n_ant + a) and correlated with one carrier and code replica, vectorized
+ *        across antennas and samples (dedicated kernels for 2, 4 and 8 elements)
+ * @param nco             Carrier generator to reuse across calls
+ * @param rfdata          First sample of each antenna (n_ant pointers)
+ * @param n_ant           Number of antennas
+ * @param n_samp          Number of samples to accumulate
+ * @param code            Expanded +/-1.0 chip table (CodeReplica::f64_expanded)
+ * @param rem_code_phase  Initial fractional phase of the code [chips]
+ * @param d_code          Code phase increment per sample [chips]
+ * @param rem_carr_phase  Initial fractional phase of the carrier [rad]
+ * @param d_carr          Carrier phase increment per sample [rad]
+ * @param n_first_half    Number of leading samples that belong to the first prompt half
+ * @param t_space         Spacing between correlator taps [chips]
+ * @param E               Early correlators (n_ant)
+ * @param P1              Prompt first-half correlators (n_ant)
+ * @param P2              Prompt second-half correlators (n_ant)
+ * @param L               Late correlators (n_ant)
+ */
+template <typename T>
+void AccumulateEPLArraySoa(
+    CarrierNco &nco,
+    const T *const rfdata[],
+    const int &n_ant,
+    const uint64_t &n_samp,
+    const double *code,
+    double &rem_code_phase,
+    const double &d_code,
+    double &rem_carr_phase,
+    const double &d_carr,
+    const uint64_t &n_first_half,
+    const double &t_space,
+    std::complex<double> *E,
+    std::complex<double> *P1,
+    std::complex<double> *P2,
+    std::complex<double> *L);
+
+}  // namespace sturdr
+
+#endif
@@ -0,0 +1,128 @@
+/**
+ * *batch-correlator.hpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/batch-correlator.hpp
+ * @brief   Correlates the shared memory block of several tracking channels in a single pass.
+ * @date    October 2026
+ * @ref     1. "Flat Combining and the Synchronization-Parallelism Tradeoff", 2010
+ *              - Hendler, Incze, Shavit, Tzafrir
+ * =======  ========================================================================================
+ */
+
+#ifndef STURDR_BATCH_CORRELATOR_HPP
+#define STURDR_BATCH_CORRELATOR_HPP
+
+#include <complex>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "sturdr/carrier-nco.hpp"
+#include "sturdr/code-replica.hpp"
+#include "sturdr/sample-ring.hpp"
+
+namespace sturdr {
+
+/**
+ * @brief Channels submit their early/prompt/late accumulation requests here instead of streaming
+ *        'shm_' themselves. Whichever thread finds the engine idle correlates every pending request
+ *        tile by tile (the channel NCO states are kept in SoA arrays), so each tile of samples is
+ *        brought into cache once and reused by all channels that need it
+ */
+class BatchCorrelator {
+ public:
+  // number of samples correlated against every pending channel before moving on
+  static constexpr uint64_t TILE = 512;
+
+  /**
+   * *=== BatchCorrelator ===*
+   * @brief Constructor
+   * @param shared_array  Shared sample buffer (only the first antenna is correlated)
+   * @param max_channels  Number of channel slots
+   */
+  BatchCorrelator(std::shared_ptr<SampleRing> shared_array, const uint8_t &max_channels);
+
+  /**
+   * *=== Accumulate ===*
+   * @brief Same as AccumulateEPL on 'n_samp' samples of 'shm_' at 'shm_ptr', blocks until the
+   *        request has been correlated (by this thread or by the thread currently combining)
+   * @param slot            Channel slot (0 to max_channels - 1)
+   * @param shm_ptr         First sample in the shared buffer
+   * @param n_samp          Number of samples to accumulate
+   * @param code            Local code tables
+   * @param rem_code_phase  Initial fractional phase of the code
+   * @param code_freq       GNSS signal code frequency [Hz]
+   * @param rem_carr_phase  Initial fractional phase of the carrier [rad]
+   * @param carr_freq       Current carrier frequency (including intermediate frequency) [rad/s]
+   * @param carr_jit        Current carrier frequency jitter [rad/s^2]
+   * @param samp_freq       GNSS receiver front end sampling frequency [Hz]
+   * @param half_samp       Number of samples in half the TOTAL accumulation period
+   * @param samp_remaining  Number of samples remaining to be accumulated inside TOTAL period
+   * @param t_space         Spacing between correlator taps
+   * @param E               Early correlator
+   * @param P1              Prompt first-half correlator
+   * @param P2              Prompt second-half correlator
+   * @param L               Late correlator
+   */
+  void Accumulate(
+      const uint8_t &slot,
+      const uint64_t &shm_ptr,
+      const uint64_t &n_samp,
+      const CodeReplica &code,
+      double &rem_code_phase,
+      const double &code_freq,
+      double &rem_carr_phase,
+      const double &carr_freq,
+      const double &carr_jit,
+      const double &samp_freq,
+      const uint64_t &half_samp,
+      uint64_t &samp_remaining,
+      const double &t_space,
+      std::complex<double> &E,
+      std::complex<double> &P1,
+      std::complex<double> &P2,
+      std::complex<double> &L);
+
+ private:
+  std::shared_ptr<SampleRing> shm_;
+
+  /**
+   * @brief per channel request state (structure of arrays, indexed by slot)
+   */
+  std::vector<uint8_t> state_;
+  std::vector<uint64_t> start_;
+  std::vector<uint64_t> n_samp_;
+  std::vector<uint64_t> n_first_half_;
+  std::vector<const double *> code_;
+  std::vector<double> rem_code_phase_;
+  std::vector<double> d_code_;
+  std::vector<double> rem_carr_phase_;
+  std::vector<double> d_carr_;
+  std::vector<double> t_space_;
+  std::vector<std::complex<double>> E_;
+  std::vector<std::complex<double>> P1_;
+  std::vector<std::complex<double>> P2_;
+  std::vector<std::complex<double>> L_;
+  std::vector<CarrierNco> nco_;
+
+  /**
+   * @brief combiner synchronization
+   */
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  bool busy_;
+
+  /**
+   * *=== Process ===*
+   * @brief Correlates every request in 'batch', sweeping the shared buffer one tile at a time
+   * @param batch Slots to process
+   */
+  void Process(const std::vector<uint8_t> &batch);
+};
+
+}  // namespace sturdr
+
+#endif
@@ -0,0 +1,109 @@
+/**
+ * *carrier-nco.hpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/carrier-nco.hpp
+ * @brief   Carrier replica generator that avoids a transcendental call per sample.
+ * @date    October 2026
+ * @ref     1. "Understanding GPS/GNSS Principles and Applications", 3rd Edition, 2017
+ *              - Kaplan & Hegarty
+ *          2. "Digital Signal Processing: Principles, Algorithms, and Applications", 4th Edition,
+ *              2007 - Proakis & Manolakis
+ * =======  ========================================================================================
+ */
+
+#ifndef STURDR_CARRIER_NCO_HPP
+#define STURDR_CARRIER_NCO_HPP
+
+#include <complex>
+#include <cstdint>
+
+namespace sturdr {
+
+namespace CarrierNcoMode {
+enum CarrierNcoMode { EXACT = 0, LUT = 1, ROTATOR = 2 };
+};  // namespace CarrierNcoMode
+
+/**
+ * *=== GetCarrierNcoMode ===*
+ * @brief Returns the carrier generation mode used by the correlators
+ * @return Active carrier NCO mode
+ */
+CarrierNcoMode::CarrierNcoMode GetCarrierNcoMode();
+
+/**
+ * *=== SetCarrierNcoMode ===*
+ * @brief Overrides the carrier generation mode used by the correlators (ROTATOR by default)
+ * @param mode  Requested carrier NCO mode
+ */
+void SetCarrierNcoMode(const CarrierNcoMode::CarrierNcoMode &mode);
+
+class CarrierNco {
+ public:
+  // number of fractional bits used to index the sin/cos table
+  static constexpr int LUT_BITS = 10;
+  static constexpr int LUT_SIZE = 1 << LUT_BITS;
+
+  // number of interleaved phasor lanes in the rotator
+  static constexpr int LANES = 8;
+
+  /**
+   * *=== CarrierNco ===*
+   * @brief Carrier replica generator
+   * @param mode            EXACT (std::exp per sample), LUT (32-bit phase accumulator indexing a
+   *                        sin/cos table), or ROTATOR (recursive phasor rotation)
+   * @param renorm_interval Number of samples between re-anchoring the rotator to the exact phase
+   */
+  CarrierNco(
+      const CarrierNcoMode::CarrierNcoMode &mode = CarrierNcoMode::ROTATOR,
+      const uint64_t &renorm_interval = 512);
+
+  /**
+   * *=== Generate ===*
+   * @brief Writes 'n' samples of exp(-i*(phase + k*d_phase)) and advances the phase by n*d_phase
+   * @param out     Output carrier replica (length >= n)
+   * @param n       Number of samples to generate
+   * @param phase   Initial phase of the carrier [rad]
+   * @param d_phase Phase increment per sample [rad]
+   */
+  void Generate(std::complex<double> *out, const uint64_t &n, double &phase, const double &d_phase);
+
+  /**
+   * *=== PhaseErrorBound ===*
+   * @brief Worst case phase error of a replica produced by a single call to Generate, relative to
+   *        exact evaluation of 'phase + k*d_phase' (excluding the rounding of the phase itself)
+   * @param n Number of samples generated
+   * @return Residual phase error bound [rad]
+   */
+  double PhaseErrorBound(const uint64_t &n) const;
+
+  /**
+   * *=== Mode ===*
+   * @brief Returns the carrier generation mode
+   */
+  CarrierNcoMode::CarrierNcoMode Mode() const {
+    return mode_;
+  };
+
+ private:
+  CarrierNcoMode::CarrierNcoMode mode_;
+  uint64_t renorm_;
+
+  // rotator state, recomputed only when the phase increment changes
+  double d_cached_;
+  double lane_re_[LANES];
+  double lane_im_[LANES];
+  double step_re_;
+  double step_im_;
+
+  void GenerateExact(
+      std::complex<double> *out, const uint64_t &n, const double &phase, const double &d_phase);
+  void GenerateLut(
+      std::complex<double> *out, const uint64_t &n, const double &phase, const double &d_phase);
+  void GenerateRotator(
+      std::complex<double> *out, const uint64_t &n, const double &phase, const double &d_phase);
+};
+
+}  // namespace sturdr
+
+#endif
@@ -18,6 +18,7 @@
 #define STURDR_CHANNEL_GPS_L1CA_ARRAY_HPP
 
 #include <Eigen/Dense>
+#include <vector>
 
 #include "sturdr/beamformer.hpp"
 #include "sturdr/channel-gps-l1ca.hpp"
@@ -32,6 +33,7 @@ class ChannelGpsL1caArray : public ChannelGpsL1ca {
   Eigen::VectorXcd p2_array_;
   Eigen::VectorXcd e_array_;
   Eigen::VectorXcd l_array_;
+  std::vector<FixedEPL> fixed_array_;
   BeamFormer bf_;
   bool is_bf_;
 
@@ -44,12 +46,18 @@ class ChannelGpsL1caArray : public ChannelGpsL1ca {
       Config &conf,
       uint8_t &n,
       std::shared_ptr<bool> running,
-      std::shared_ptr<Eigen::MatrixXcd> shared_array,
+      std::shared_ptr<SampleRing> shared_array,
       std::shared_ptr<ConcurrentBarrier> barrier1,
       std::shared_ptr<ConcurrentBarrier> barrier2,
       std::shared_ptr<ConcurrentQueue> nav_queue,
-      std::shared_ptr<FftwWrapper> fftw_plans,
-      std::function<void(uint8_t &)> &GetNewPrnFunc);
+      std::shared_ptr<AcquisitionContext> acq_ctx,
+      std::shared_ptr<AcquisitionContextF> acq_ctx_f,
+      std::shared_ptr<AcquisitionWorkspacePool> acq_pool,
+      std::shared_ptr<AcquisitionWorkspacePoolF> acq_pool_f,
+      std::shared_ptr<AcquisitionEngine> acq_engine,
+      std::shared_ptr<AcquisitionAiding> acq_aiding,
+      std::shared_ptr<BatchCorrelator> batch_correlator,
+      std::shared_ptr<PrnScheduler> prn_scheduler);
 
   /**
    * *=== ~ChannelGpsL1caArray ===*
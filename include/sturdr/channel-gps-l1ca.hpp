@@ -19,11 +19,17 @@
 
 #include <array>
 #include <complex>
+#include <memory>
 #include <satutils/gps-lnav.hpp>
 
 #include "sturdr/channel.hpp"
+#include "sturdr/code-replica.hpp"
 #include "sturdr/fftw-wrapper.hpp"
+#include "sturdr/fixed-correlator.hpp"
 #include "sturdr/lock-detectors.hpp"
+#include "sturdr/multi-correlator.hpp"
+#include "sturdr/packed-correlator.hpp"
+#include "sturdr/reacquisition.hpp"
 #include "sturdr/tracking.hpp"
 
 namespace sturdr {
@@ -33,7 +39,7 @@ class ChannelGpsL1ca : public Channel {
   /**
    * @brief local replica properties and statistics
    */
-  std::array<bool, 1023> code_;
+  const CodeReplica *code_;
   double intmd_freq_rad_;
   double rem_code_phase_;
   double code_doppler_;
@@ -71,6 +77,10 @@ class ChannelGpsL1ca : public Channel {
   std::complex<double> P1_;
   std::complex<double> P2_;
   std::complex<double> P_old_;
+  bool fixed_point_;
+  bool packed_;
+  FixedEPL fixed_epl_;
+  std::unique_ptr<MultiCorrelator> multi_;
 
   /**
    * @brief counters and telemetry
@@ -84,6 +94,17 @@ class ChannelGpsL1ca : public Channel {
   uint8_t bit_sync_hist_[20];
   satutils::GpsLnav<double> gps_lnav_;
 
+  /**
+   * @brief loss of lock and reacquisition
+   */
+  uint64_t track_start_cnt_;
+  Reacquisition reacq_;
+
+  /**
+   * @brief search pending in the acquisition engine
+   */
+  std::shared_ptr<AcquisitionJob> acq_job_;
+
  public:
   /**
    * *=== ChannelGpsL1ca ===*
@@ -93,12 +114,18 @@ class ChannelGpsL1ca : public Channel {
       Config &conf,
       uint8_t &n,
       std::shared_ptr<bool> running,
-      std::shared_ptr<Eigen::MatrixXcd> shared_array,
+      std::shared_ptr<SampleRing> shared_array,
       std::shared_ptr<ConcurrentBarrier> barrier1,
       std::shared_ptr<ConcurrentBarrier> barrier2,
       std::shared_ptr<ConcurrentQueue> nav_queue,
-      std::shared_ptr<FftwWrapper> fftw_plans,
-      std::function<void(uint8_t &)> &GetNewPrnFunc);
+      std::shared_ptr<AcquisitionContext> acq_ctx,
+      std::shared_ptr<AcquisitionContextF> acq_ctx_f,
+      std::shared_ptr<AcquisitionWorkspacePool> acq_pool,
+      std::shared_ptr<AcquisitionWorkspacePoolF> acq_pool_f,
+      std::shared_ptr<AcquisitionEngine> acq_engine,
+      std::shared_ptr<AcquisitionAiding> acq_aiding,
+      std::shared_ptr<BatchCorrelator> batch_correlator,
+      std::shared_ptr<PrnScheduler> prn_scheduler);
 
   /**
    * *=== ~ChannelGpsL1ca ===*
@@ -113,12 +140,81 @@ class ChannelGpsL1ca : public Channel {
    */
   void NewCodePeriod();
 
+  /**
+   * *=== Idle ===*
+   * @brief Keeps up with the writer and returns to acquisition once the scheduler has a PRN out of
+   *        its back-off (at once when back-offs are disabled)
+   */
+  void Idle();
+
   /**
    * *=== Acquire ===*
    * @brief Trys to acquire current satellite
    */
   void Acquire();
 
+  /**
+   * *=== AcquireAsync ===*
+   * @brief Submits the search to the acquisition engine, then skips samples until it completes
+   *        and re-aligns to the code period it found
+   */
+  void AcquireAsync();
+
+  /**
+   * *=== AlignToSnapshot ===*
+   * @brief Moves the read pointer from the newest sample to the next code period found by an
+   *        asynchronous search, advancing the result by the code Doppler drift since its snapshot
+   * @param result  Search result, its code phase is advanced in place
+   * @param job_ptr Sample the searched snapshot started at
+   */
+  void AlignToSnapshot(AcquisitionResult &result, const uint64_t &job_ptr);
+
+  /**
+   * *=== Search ===*
+   * @brief Searches the newest samples for the current PRN in a pooled workspace
+   * @param window  Doppler bins to search
+   * @return Search result (not yet compared to the threshold)
+   */
+  AcquisitionResult Search(const DopplerWindow &window);
+
+  /**
+   * *=== AcquisitionWindow ===*
+   * @brief Doppler bins to search for the current PRN (every bin without aiding or a prediction)
+   */
+  DopplerWindow AcquisitionWindow() const;
+
+  /**
+   * *=== SetPrn ===*
+   * @brief Points the replica and packets at a new PRN
+   * @param prn Satellite PRN (0 for none)
+   */
+  void SetPrn(const uint8_t &prn);
+
+  /**
+   * *=== NextPrn ===*
+   * @brief Switches to a new PRN after a failed search
+   * @param metric  Detection metric of the failed search
+   * @return False when the channel gave up (too many failed attempts or no PRN available)
+   */
+  bool NextPrn(const double &metric);
+
+  /**
+   * *=== AcquiredDoppler ===*
+   * @brief Carrier Doppler of a search result, interpolated when fine acquisition is enabled
+   * @param result  Search result
+   * @return Doppler [Hz]
+   */
+  double AcquiredDoppler(const AcquisitionResult &result) const;
+
+  /**
+   * *=== StartTracking ===*
+   * @brief Initializes tracking from a successful search (the read pointer must already be at the
+   *        sample of the correlation peak), from the interpolated peak and its variances when fine
+   *        acquisition is enabled
+   * @param result  Search result
+   */
+  void StartTracking(const AcquisitionResult &result);
+
   /**
    * *=== Track ===*
    * @brief Trys to track current satellite
@@ -128,6 +224,35 @@ class ChannelGpsL1ca : public Channel {
   void Dump();
   void Status();
 
+  /**
+   * *=== LossOfLock ===*
+   * @brief Drops the current track, the reacquisition centers on the Doppler of the last epoch
+   *        with code lock
+   */
+  void LossOfLock();
+
+  /**
+   * *=== Reacquire ===*
+   * @brief Searches a Doppler window around the last tracked Doppler that widens with the time
+   *        since the loss of lock, falls back to a full acquisition after a timeout
+   */
+  void Reacquire();
+
+  /**
+   * *=== ReacquireAsync ===*
+   * @brief Submits the reacquisition search to the acquisition engine, then skips samples until it
+   *        completes and re-aligns to the code period it found
+   */
+  void ReacquireAsync();
+
+  /**
+   * *=== ReacquisitionFailed ===*
+   * @brief Logs a failed reacquisition search and moves to the state it leads to, a full
+   *        acquisition once it has timed out
+   * @param metric  Detection metric of the failed search
+   */
+  void ReacquisitionFailed(const double &metric);
+
   /**
    * *=== NavDataSync ===*
    * @brief Trys to synchronize to the data bit and extend the integration periods
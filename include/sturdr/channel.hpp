@@ -21,14 +21,18 @@
 
 #include <Eigen/Dense>
 #include <fstream>
-#include <functional>
 #include <memory>
 #include <string>
 #include <thread>
 
+#include "sturdr/acquisition-aiding.hpp"
+#include "sturdr/acquisition-engine.hpp"
+#include "sturdr/acquisition.hpp"
+#include "sturdr/batch-correlator.hpp"
 #include "sturdr/concurrent-barrier.hpp"
 #include "sturdr/concurrent-queue.hpp"
-#include "sturdr/fftw-wrapper.hpp"
+#include "sturdr/prn-scheduler.hpp"
+#include "sturdr/sample-ring.hpp"
 #include "sturdr/structs-enums.hpp"
 
 namespace sturdr {
@@ -42,17 +46,25 @@ class Channel {
   std::shared_ptr<bool> running_;
   uint64_t samp_per_ms_;
   uint8_t acq_fail_cnt_;
-  std::shared_ptr<FftwWrapper> fftw_plans_;
-  std::function<void(uint8_t &)> new_prn_func_;
+  std::shared_ptr<AcquisitionContext> acq_ctx_;
+  std::shared_ptr<AcquisitionContextF> acq_ctx_f_;
+  std::shared_ptr<AcquisitionWorkspacePool> acq_pool_;
+  std::shared_ptr<AcquisitionWorkspacePoolF> acq_pool_f_;
+  std::shared_ptr<AcquisitionEngine> acq_engine_;
+  std::shared_ptr<AcquisitionAiding> acq_aiding_;
+  std::shared_ptr<BatchCorrelator> batch_correlator_;
+  std::shared_ptr<PrnScheduler> prn_scheduler_;
 
   /**
    * @brief thread syncronization
    */
-  std::shared_ptr<Eigen::MatrixXcd> shm_;
+  std::shared_ptr<SampleRing> shm_;
   uint64_t shm_ptr_;
   uint64_t shm_writer_ptr_;
   uint64_t shm_file_size_samp_;
   uint64_t shm_read_size_samp_;
+  Eigen::MatrixXcd shm_scratch_;
+  Eigen::MatrixXcf shm_scratch_f_;
   std::shared_ptr<ConcurrentBarrier> barrier1_;
   std::shared_ptr<ConcurrentBarrier> barrier2_;
   std::shared_ptr<ConcurrentQueue> q_nav_;
@@ -77,25 +89,43 @@ class Channel {
    * @param start_barrier Synchronization for when new data is available
    * @param eph_queue     Queue for sending parsed ephemerides
    * @param nav_queue     Queue for sending navigation updates
-   * @param fftw_plans    Shared FFT plans for acquisition using fftw
-   * @param GetNewPrnFunc Function pointer for channel capability to switch PRNs
+   * @param acq_ctx       Shared acquisition plans and code spectra
+   * @param acq_ctx_f     Shared single precision acquisition context (nullptr to acquire in double)
+   * @param acq_pool      Shared acquisition workspaces (bounds concurrent searches)
+   * @param acq_pool_f    Shared single precision acquisition workspaces
+   * @param acq_engine    Shared acquisition worker pool (nullptr to acquire in this thread)
+   * @param acq_aiding    Shared satellite predictions (nullptr to always search every Doppler bin)
+   * @param batch_correlator  Shared multi-channel correlator (nullptr to correlate in this thread)
+   * @param prn_scheduler Shared PRN assignment (with the failures of every channel)
    */
   Channel(
       Config &conf,
       uint8_t &n,
       std::shared_ptr<bool> running,
-      std::shared_ptr<Eigen::MatrixXcd> shared_array,
+      std::shared_ptr<SampleRing> shared_array,
       std::shared_ptr<ConcurrentBarrier> barrier1,
       std::shared_ptr<ConcurrentBarrier> barrier2,
       std::shared_ptr<ConcurrentQueue> nav_queue,
-      std::shared_ptr<FftwWrapper> fftw_plans,
-      std::function<void(uint8_t &)> &GetNewPrnFunc)
+      std::shared_ptr<AcquisitionContext> acq_ctx,
+      std::shared_ptr<AcquisitionContextF> acq_ctx_f,
+      std::shared_ptr<AcquisitionWorkspacePool> acq_pool,
+      std::shared_ptr<AcquisitionWorkspacePoolF> acq_pool_f,
+      std::shared_ptr<AcquisitionEngine> acq_engine,
+      std::shared_ptr<AcquisitionAiding> acq_aiding,
+      std::shared_ptr<BatchCorrelator> batch_correlator,
+      std::shared_ptr<PrnScheduler> prn_scheduler)
       : conf_{conf},
         running_{running},
         samp_per_ms_{static_cast<uint64_t>(conf_.rfsignal.samp_freq) / 1000},
         acq_fail_cnt_{0},
-        fftw_plans_{fftw_plans},
-        new_prn_func_{GetNewPrnFunc},
+        acq_ctx_{acq_ctx},
+        acq_ctx_f_{acq_ctx_f},
+        acq_pool_{acq_pool},
+        acq_pool_f_{acq_pool_f},
+        acq_engine_{acq_engine},
+        acq_aiding_{acq_aiding},
+        batch_correlator_{batch_correlator},
+        prn_scheduler_{prn_scheduler},
         shm_{shared_array},
         shm_ptr_{0},
         shm_writer_ptr_{0},
@@ -166,6 +196,7 @@ class Channel {
       barrier2_->Wait();
       switch (file_pkt_.ChannelStatus) {
         case ChannelState::IDLE:
+          Idle();
           break;
         case ChannelState::ACQUIRING:
           Acquire();
@@ -173,6 +204,9 @@ class Channel {
         case ChannelState::TRACKING:
           Track();
           break;
+        case ChannelState::REACQUIRING:
+          Reacquire();
+          break;
       }
 
       // wait for new shm data
@@ -183,6 +217,12 @@ class Channel {
   };
 
  protected:
+  /**
+   * *=== Idle ===*
+   * @brief Waits for a satellite worth searching
+   */
+  virtual void Idle() = 0;
+
   /**
    * *=== Acquire ===*
    * @brief Trys to acquire current satellite
@@ -194,6 +234,12 @@ class Channel {
    * @brief Trys to track current satellite
    */
   virtual void Track() = 0;
+
+  /**
+   * *=== Reacquire ===*
+   * @brief Trys to recover the current satellite after a loss of lock
+   */
+  virtual void Reacquire() = 0;
   virtual void Integrate(const uint64_t &samp_to_read) = 0;
   virtual void Dump() = 0;
 
@@ -0,0 +1,93 @@
+/**
+ * *code-replica.hpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/code-replica.hpp
+ * @brief   Precomputed spreading code chip tables shared by all channels.
+ * @date    October 2026
+ * @ref     1. "IS-GPS-200N: Navstar GPS Space Segment/Navigation User Segment Interfaces", 2022
+ *          2. "A Software-Defined GPS and Galileo Receiver: A Single-Frequency Approach", 2007
+ *              - Borre, Akos, Bertelsen, Rinder, Jensen
+ * =======  ========================================================================================
+ */
+
+#ifndef STURDR_CODE_REPLICA_HPP
+#define STURDR_CODE_REPLICA_HPP
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace sturdr {
+
+/**
+ * @brief +/-1 chip tables of one spreading code. The 'expanded' tables hold two code periods plus
+ *        PAD guard chips on either side, so a code phase wrapped once into [0, 1023) can be
+ *        advanced by up to one period and offset by an early/late tap without any per-sample modulo
+ */
+struct CodeReplica {
+  static constexpr int LENGTH = 1023;
+  static constexpr int PAD = 4;
+  static constexpr int EXPANDED_LENGTH = 2 * LENGTH + 2 * PAD;
+
+  std::array<bool, LENGTH> bits;
+  std::array<int8_t, LENGTH> i8;
+  std::array<float, LENGTH> f32;
+  std::array<int8_t, EXPANDED_LENGTH> i8_expanded;
+  std::array<float, EXPANDED_LENGTH> f32_expanded;
+  std::array<double, EXPANDED_LENGTH> f64_expanded;
+
+  CodeReplica() = default;
+
+  /**
+   * *=== CodeReplica ===*
+   * @brief Builds every table from a code given as bits (true = +1, false = -1)
+   * @param code  Spreading code
+   */
+  explicit CodeReplica(const bool code[1023]);
+
+  /**
+   * *=== WrapPhase ===*
+   * @brief Wraps a code phase into [0, 1023)
+   * @param phase Code phase [chips]
+   * @return Wrapped code phase [chips]
+   */
+  static double WrapPhase(const double &phase) {
+    return phase - static_cast<double>(LENGTH) * std::floor(phase / static_cast<double>(LENGTH));
+  };
+
+  /**
+   * *=== ExpandedIndex ===*
+   * @brief Index into the expanded tables of the chip nearest to 'phase', valid for phases in
+   *        [-PAD, 2*1023 + PAD)
+   * @param phase Code phase [chips]
+   * @return Expanded table index
+   */
+  static int ExpandedIndex(const double &phase) {
+    return static_cast<int>(phase + (static_cast<double>(PAD) + 0.5));
+  };
+
+  /**
+   * *=== MaxBlockLength ===*
+   * @brief Number of samples that can be read from the expanded tables after a single wrap
+   * @param d_code  Code phase increment per sample [chips]
+   * @return Maximum block length [samples]
+   */
+  static uint64_t MaxBlockLength(const double &d_code) {
+    double n = std::floor(static_cast<double>(LENGTH) / std::abs(d_code));
+    return (n < 1.0) ? 1 : ((n > 1e9) ? 1000000000 : static_cast<uint64_t>(n));
+  };
+};
+
+/**
+ * *=== GpsL1caReplica ===*
+ * @brief Returns the shared, read-only chip tables of a GPS L1 C/A PRN (all 32 PRNs are generated
+ *        together on first use), throws std::out_of_range for any other PRN
+ * @param prn Satellite PRN (1-32)
+ * @return Code replica tables
+ */
+const CodeReplica &GpsL1caReplica(const uint8_t &prn);
+
+}  // namespace sturdr
+
+#endif
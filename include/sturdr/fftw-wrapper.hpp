@@ -15,23 +15,164 @@
 #include <fftw3.h>
 
 #include <Eigen/Dense>
+#include <complex>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <tuple>
 
 namespace sturdr {
 
-class FftwWrapper {
+/**
+ * @brief FFTW3 interface of one precision, 'double' maps to fftw_* and 'float' to fftwf_*
+ */
+template <typename Real>
+struct FftwApi;
+template <>
+struct FftwApi<double> {
+  using plan = fftw_plan;
+  using complex = fftw_complex;
+  static constexpr auto plan_dft_1d = &fftw_plan_dft_1d;
+  static constexpr auto plan_many_dft = &fftw_plan_many_dft;
+  static constexpr auto execute_dft = &fftw_execute_dft;
+  static constexpr auto destroy_plan = &fftw_destroy_plan;
+  static constexpr auto make_planner_thread_safe = &fftw_make_planner_thread_safe;
+  static constexpr auto malloc = &fftw_malloc;
+  static constexpr auto free = &fftw_free;
+  static constexpr auto alignment_of = &fftw_alignment_of;
+  static constexpr auto estimate_cost = &fftw_estimate_cost;
+  static constexpr auto import_wisdom_from_filename = &fftw_import_wisdom_from_filename;
+  static constexpr auto export_wisdom_to_filename = &fftw_export_wisdom_to_filename;
+  static constexpr const char *suffix = "";
+#ifdef STURDR_FFTW_THREADS
+  static constexpr auto init_threads = &fftw_init_threads;
+  static constexpr auto plan_with_nthreads = &fftw_plan_with_nthreads;
+#endif
+};
+template <>
+struct FftwApi<float> {
+  using plan = fftwf_plan;
+  using complex = fftwf_complex;
+  static constexpr auto plan_dft_1d = &fftwf_plan_dft_1d;
+  static constexpr auto plan_many_dft = &fftwf_plan_many_dft;
+  static constexpr auto execute_dft = &fftwf_execute_dft;
+  static constexpr auto destroy_plan = &fftwf_destroy_plan;
+  static constexpr auto make_planner_thread_safe = &fftwf_make_planner_thread_safe;
+  static constexpr auto malloc = &fftwf_malloc;
+  static constexpr auto free = &fftwf_free;
+  static constexpr auto alignment_of = &fftwf_alignment_of;
+  static constexpr auto estimate_cost = &fftwf_estimate_cost;
+  static constexpr auto import_wisdom_from_filename = &fftwf_import_wisdom_from_filename;
+  static constexpr auto export_wisdom_to_filename = &fftwf_export_wisdom_to_filename;
+  static constexpr const char *suffix = "f";
+#ifdef STURDR_FFTW_THREADS
+  static constexpr auto init_threads = &fftwf_init_threads;
+  static constexpr auto plan_with_nthreads = &fftwf_plan_with_nthreads;
+#endif
+};
+
+/**
+ * @brief Registry of the FFTW plans of one precision. Plans are created on demand and cached by
+ *        their (length, howmany, stride, dist, direction) layout, so searches of any coherent
+ *        length or sampling rate share the same object. Lookups are thread-safe, planning is
+ *        serialized, and every execution picks the SIMD-aligned plan when its buffers allow it
+ */
+template <typename Real>
+class BasicFftwWrapper {
  public:
-  fftw_plan fft_;
-  fftw_plan ifft_;
-  fftw_plan fft_many_;
-  fftw_plan ifft_many_;
+  using Plan = typename FftwApi<Real>::plan;
+  using MatrixXc = Eigen::Matrix<std::complex<Real>, Eigen::Dynamic, Eigen::Dynamic>;
 
-  FftwWrapper() = default;
-  ~FftwWrapper();
+  // plans of the last Create1dFftPlan/CreateManyFftPlan calls (owned by the registry)
+  Plan fft_ = nullptr;
+  Plan ifft_ = nullptr;
+  Plan fft_many_ = nullptr;
+  Plan ifft_many_ = nullptr;
+
+  BasicFftwWrapper() = default;
+  ~BasicFftwWrapper();
 
   //! === ThreadSafety ===
   /// @brief Ensures the creation of FFT planners does not conflict with other processes
   void ThreadSafety();
 
+  //! === SetThreads ===
+  /// @brief Number of threads FFTW splits each many-FFT plan created afterwards across (needs the
+  ///        fftw3_threads libraries, STURDR_FFTW_THREADS, otherwise plans stay single threaded)
+  /// @param n_threads  threads per many-FFT execution (>= 1)
+  void SetThreads(const int n_threads);
+
+  //! === SetPlannerEffort ===
+  /// @brief Planning rigor of every plan created afterwards, "estimate" (default, instant),
+  ///        "measure", "patient" or "exhaustive" (timed plans, much faster for lengths with large
+  ///        prime factors but slow to create unless loaded from wisdom)
+  /// @param effort name of the FFTW planner flag
+  /// @return False if 'effort' is not recognized (the effort is left unchanged)
+  bool SetPlannerEffort(const std::string &effort);
+
+  //! === ImportWisdom ===
+  /// @brief Loads the wisdom of this precision and host from 'dir' (see WisdomFile), plans of
+  ///        the same size, layout and rigor are then created without being timed again
+  /// @param dir  wisdom cache directory
+  /// @return True if a wisdom file was read
+  bool ImportWisdom(const std::string &dir);
+
+  //! === ExportWisdom ===
+  /// @brief Saves the accumulated wisdom of this precision and host to 'dir'
+  /// @param dir  wisdom cache directory (must exist)
+  /// @return True if the wisdom file was written
+  bool ExportWisdom(const std::string &dir);
+
+  //! === WisdomFile ===
+  /// @brief Wisdom file of this precision inside 'dir', keyed by the host CPU (plans timed on one
+  ///        processor are not reused on another, FFTW keys the entries by size and layout)
+  /// @param dir  wisdom cache directory
+  static std::string WisdomFile(const std::string &dir);
+
+  //! === Warmup ===
+  /// @brief Executes every created plan once on scratch data, so twiddle tables and codelets are
+  ///        resident before the first acquisition
+  void Warmup();
+
+  //! === GetPlan ===
+  /// @brief Cached plan of 'howmany' transforms of length 'len', created on first use (planned on
+  ///        FFTW-aligned scratch, so the data is never overwritten by timed planning)
+  /// @param len      length of fft
+  /// @param howmany  number of transforms
+  /// @param stride   distance between the samples of one transform
+  /// @param dist     distance between the first samples of consecutive transforms
+  /// @param is_fft   boolean to decide whether to create FFT or IFFT plan
+  /// @param in_place input and output are the same buffer
+  /// @param aligned  false creates an FFTW_UNALIGNED plan that runs on any buffer
+  /// @return plan owned by the registry
+  Plan GetPlan(
+      const int len,
+      const int howmany,
+      const int stride,
+      const int dist,
+      const bool is_fft = true,
+      const bool in_place = true,
+      const bool aligned = true);
+
+  //! === NumPlans ===
+  /// @brief Number of plans in the registry
+  std::size_t NumPlans() const;
+
+  //! === IsAligned ===
+  /// @brief True if 'p' has the SIMD alignment of FFTW-allocated buffers, aligned plans may only
+  ///        run on such data
+  static bool IsAligned(const std::complex<Real> *p);
+
+  //! === SmoothSize ===
+  /// @brief Smallest length >= 'n' whose prime factors are all 2, 3, 5 or 7
+  static int SmoothSize(const int n);
+
+  //! === PaddedSize ===
+  /// @brief 'SmoothSize(n)' if FFTW estimates a transform of that length to be cheaper than one of
+  ///        length 'n' (large prime factors), otherwise 'n'. Only for transforms that tolerate
+  ///        zero padding (linear correlation, or a free choice of the sampling rate)
+  int PaddedSize(const int n);
+
   //! === CreateFftPlan ===
   /// @brief Create a complex-to-complex 1d FFT plan
   /// @param in   input data stream
@@ -52,21 +193,67 @@ class FftwWrapper {
   void CreateManyFftPlan(
       const int nrow, const int ncol, const bool is_fft = true, const bool is_rowwise = true);
 
+  //! === CreateColumnPlans ===
+  /// @brief Create the FFT/IFFT plans of every block 'ExecuteColumns' uses when 'ncol' columns of
+  ///        length 'nrow' are split into 'n_split' contiguous blocks (blocks starting off the SIMD
+  ///        alignment get unaligned plans)
+  /// @param nrow     length of fft
+  /// @param ncol     number of columns split
+  /// @param n_split  number of blocks
+  void CreateColumnPlans(const int nrow, const int ncol, const int n_split);
+
+  //! === ExecuteColumns ===
+  /// @brief In-place column-wise FFT/IFFT of 'ncol' columns of 'x' starting at 'col' (a missing
+  ///        plan is created on demand, see CreateColumnPlans)
+  /// @param x      column-wise data (nrow x columns)
+  /// @param col    first column
+  /// @param ncol   number of columns
+  /// @param is_fft boolean to decide whether to perform FFT or IFFT
+  void ExecuteColumns(
+      Eigen::Ref<MatrixXc> x, const int col, const int ncol, const bool is_fft = true);
+
   //! === ExecuteFftPlan ===
-  /// @brief Perform a complex-to-complex 1d FFT/IFFT
-  /// @param p    Generated fftw_plan
+  /// @brief Perform a complex-to-complex 1d FFT/IFFT of the contiguous 'in' (or of each of its
+  ///        rows/columns as laid out by the last CreateManyFftPlan), 'out' has the layout of 'in'
+  /// @param in           input data stream
+  /// @param out          fft result data stream (may be 'in')
+  /// @param is_fft       boolean to decide whether to perform FFT or IFFT
+  /// @param is_many_fft  boolean to decide whether to perform 1d or many transforms
   /// @return True|False based on success
   bool ExecuteFftPlan(
-      Eigen::Ref<Eigen::MatrixXcd> in,
-      Eigen::Ref<Eigen::MatrixXcd> out,
+      Eigen::Ref<MatrixXc> in,
+      Eigen::Ref<MatrixXc> out,
       const bool is_fft = true,
       const bool is_many_fft = false);
   // bool ExecuteFftPlan(
   //     const fftw_plan &p, Eigen::Ref<Eigen::VectorXcd> in, Eigen::Ref<Eigen::VectorXcd> out);
   // bool ExecuteManyFftPlan(
   //     const fftw_plan &p, Eigen::Ref<Eigen::MatrixXcd> in, Eigen::Ref<Eigen::MatrixXcd> out);
+
+ private:
+  // (len, howmany, stride, dist, is_fft, in_place, aligned), precision is the template's
+  using PlanKey = std::tuple<int, int, int, int, bool, bool, bool>;
+
+  int n_threads_ = 1;
+  unsigned flags_ = FFTW_ESTIMATE;
+  bool many_rowwise_ = true;
+  std::map<PlanKey, Plan> plans_;
+  mutable std::shared_mutex mtx_;  // shared for lookups, exclusive for planning
+
+  void Execute(
+      const int len,
+      const int howmany,
+      const int stride,
+      const int dist,
+      const bool is_fft,
+      std::complex<Real> *in,
+      std::complex<Real> *out);
 };
 
+// double precision plans (default) and single precision plans (fftwf)
+using FftwWrapper = BasicFftwWrapper<double>;
+using FftwWrapperF = BasicFftwWrapper<float>;
+
 }  // end namespace sturdr
 
 #endif
\ No newline at end of file
@@ -0,0 +1,146 @@
+/**
+ * *fixed-correlator.hpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/fixed-correlator.hpp
+ * @brief   Fixed-point early/prompt/late correlators operating on the raw quantized samples.
+ * @date    October 2026
+ * @ref     1. "Understanding GPS/GNSS Principles and Applications", 3rd Edition, 2017
+ *              - Kaplan & Hegarty
+ *          2. "A Software-Defined GPS and Galileo Receiver: A Single-Frequency Approach", 2007
+ *              - Borre, Akos, Bertelsen, Rinder, Jensen
+ * =======  ========================================================================================
+ */
+
+#ifndef STURDR_FIXED_CORRELATOR_HPP
+#define STURDR_FIXED_CORRELATOR_HPP
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+#include "sturdr/code-replica.hpp"
+#include "sturdr/sample-ring.hpp"
+
+namespace sturdr {
+
+// phase bits of the quantized carrier table (64 phases, ~0.02 dB correlation loss)
+constexpr int FIXED_CARR_BITS = 6;
+constexpr int FIXED_CARR_SIZE = 1 << FIXED_CARR_BITS;
+
+// amplitude of the quantized carrier table
+constexpr int FIXED_CARR_AMP = 64;
+
+// fractional bits of the code phase (12 integer bits cover the whole expanded table)
+constexpr int CODE_FRAC_BITS = 20;
+
+// samples accumulated in int32 before flushing to the int64 totals (no overflow for int16 input)
+constexpr uint64_t FIXED_BLOCK = 256;
+
+/**
+ * @brief Integer early/prompt/late accumulators, in units of sample LSB * FIXED_CARR_AMP
+ */
+struct FixedEPL {
+  int64_t IE = 0;
+  int64_t QE = 0;
+  int64_t IP1 = 0;
+  int64_t QP1 = 0;
+  int64_t IP2 = 0;
+  int64_t QP2 = 0;
+  int64_t IL = 0;
+  int64_t QL = 0;
+};
+
+/**
+ * *=== PhaseToFixed ===*
+ * @brief Converts a phase into a 32-bit fraction of a cycle
+ * @param phase Carrier phase [rad]
+ * @return Phase [cycles / 2^32]
+ */
+inline uint32_t PhaseToFixed(const double &phase) {
+  double cycles = phase / 6.283185307179586476925286766559;
+  cycles -= std::floor(cycles);
+  return static_cast<uint32_t>(static_cast<uint64_t>(std::llround(cycles * 4294967296.0)));
+}
+
+/**
+ * *=== ChipsToFixed ===*
+ * @brief Converts a non-negative code phase into 12.20 fixed point
+ * @param chips Code phase [chips]
+ * @return Code phase [chips / 2^CODE_FRAC_BITS]
+ */
+inline uint32_t ChipsToFixed(const double &chips) {
+  return static_cast<uint32_t>(std::lround(chips * static_cast<double>(1 << CODE_FRAC_BITS)));
+}
+
+/**
+ * *=== WidenEPL ===*
+ * @brief Adds the integer accumulators (rescaled to a unit amplitude carrier) to the double
+ *        precision correlators and clears them
+ * @param fixed Integer accumulators
+ * @param E     Early correlator
+ * @param P1    Prompt first-half correlator
+ * @param P2    Prompt second-half correlator
+ * @param L     Late correlator
+ */
+void WidenEPL(
+    FixedEPL &fixed,
+    std::complex<double> &E,
+    std::complex<double> &P1,
+    std::complex<double> &P2,
+    std::complex<double> &L);
+
+/**
+ * *=== AccumulateEPLFixed ===*
+ * @brief Accumulates 'n_samp' samples of the current integration period in fixed point, directly
+ *        on the native integer samples of the ring (INT8, INT16, CINT8 or CINT16 formats)
+ * @param rfdata          Shared sample ring (first antenna)
+ * @param ptr             First sample in the ring
+ * @param n_samp          Number of samples to accumulate
+ * @param code            Local code tables
+ * @param rem_code_phase  Initial fractional phase of the code
+ * @param code_freq       GNSS signal code frequency [Hz]
+ * @param rem_carr_phase  Initial fractional phase of the carrier [rad]
+ * @param carr_freq       Current carrier frequency (including intermediate frequency) [rad/s]
+ * @param carr_jit        Current carrier frequency jitter [rad/s^2]
+ * @param samp_freq       GNSS receiver front end sampling frequency [Hz]
+ * @param half_samp       Number of samples in half the TOTAL accumulation period
+ * @param samp_remaining  Number of samples remaining to be accumulated inside TOTAL period
+ * @param t_space         Spacing between correlator taps
+ * @param epl             Integer accumulators (one per antenna for the array version)
+ */
+void AccumulateEPLFixed(
+    const SampleRing &rfdata,
+    const uint64_t &ptr,
+    const uint64_t &n_samp,
+    const CodeReplica &code,
+    double &rem_code_phase,
+    double &code_freq,
+    double &rem_carr_phase,
+    double &carr_freq,
+    double &carr_jit,
+    double &samp_freq,
+    uint64_t &half_samp,
+    uint64_t &samp_remaining,
+    double &t_space,
+    FixedEPL &epl);
+void AccumulateEPLArrayFixed(
+    const SampleRing &rfdata,
+    const uint64_t &ptr,
+    const uint64_t &n_samp,
+    const CodeReplica &code,
+    double &rem_code_phase,
+    double &code_freq,
+    double &rem_carr_phase,
+    double &carr_freq,
+    double &carr_jit,
+    double &samp_freq,
+    uint64_t &half_samp,
+    uint64_t &samp_remaining,
+    double &t_space,
+    std::vector<FixedEPL> &epl);
+
+}  // namespace sturdr
+
+#endif
@@ -19,6 +19,9 @@
 #include <Eigen/Dense>
 #include <complex>
 
+#include "sturdr/code-replica.hpp"
+#include "sturdr/sample-ring.hpp"
+
 namespace sturdr {
 
 /**
@@ -33,8 +36,11 @@ Eigen::VectorXcd CircShift(const Eigen::Ref<const Eigen::VectorXcd> &vec, int sh
 /**
  * *=== AccumulateEPL ===*
  * @brief Accumulates 'n_samp' samples of the current integration period
- * @param rfdata          Recorded signal data
- * @param code            Local code to upsample
+ * @param rfdata          Recorded signal data (or the shared ring, first antenna for the single
+ *                        antenna versions and every antenna for the array versions)
+ * @param ptr             First sample in the ring
+ * @param n_samp          Number of samples to accumulate from the ring
+ * @param code            Local code to upsample (shared chip tables, or bits)
  * @param rem_code_phase  Initial fractional phase of the code
  * @param code_freq       GNSS signal code frequency [Hz]
  * @param rem_carr_phase  Initial fractional phase of the carrier [rad]
@@ -49,6 +55,22 @@ Eigen::VectorXcd CircShift(const Eigen::Ref<const Eigen::VectorXcd> &vec, int sh
  * @param P2              Prompt second-half correlator
  * @param L               Late correlator
  */
+void AccumulateEPL(
+    const Eigen::Ref<const Eigen::VectorXcd> &rfdata,
+    const CodeReplica &code,
+    double &rem_code_phase,
+    double &code_freq,
+    double &rem_carr_phase,
+    double &carr_freq,
+    double &carr_jit,
+    double &samp_freq,
+    uint64_t &half_samp,
+    uint64_t &samp_remaining,
+    double &t_space,
+    std::complex<double> &E,
+    std::complex<double> &P1,
+    std::complex<double> &P2,
+    std::complex<double> &L);
 void AccumulateEPL(
     const Eigen::Ref<const Eigen::VectorXcd> &rfdata,
     const bool code[1023],
@@ -65,9 +87,45 @@ void AccumulateEPL(
     std::complex<double> &P1,
     std::complex<double> &P2,
     std::complex<double> &L);
+void AccumulateEPL(
+    const SampleRing &rfdata,
+    const uint64_t &ptr,
+    const uint64_t &n_samp,
+    const CodeReplica &code,
+    double &rem_code_phase,
+    double &code_freq,
+    double &rem_carr_phase,
+    double &carr_freq,
+    double &carr_jit,
+    double &samp_freq,
+    uint64_t &half_samp,
+    uint64_t &samp_remaining,
+    double &t_space,
+    std::complex<double> &E,
+    std::complex<double> &P1,
+    std::complex<double> &P2,
+    std::complex<double> &L);
 void AccumulateEPLArray(
     const Eigen::Ref<const Eigen::MatrixXcd> &rfdata,
-    const bool code[1023],
+    const CodeReplica &code,
+    double &rem_code_phase,
+    double &code_freq,
+    double &rem_carr_phase,
+    double &carr_freq,
+    double &carr_jit,
+    double &samp_freq,
+    uint64_t &half_samp,
+    uint64_t &samp_remaining,
+    double &t_space,
+    Eigen::Ref<Eigen::VectorXcd> E,
+    Eigen::Ref<Eigen::VectorXcd> P1,
+    Eigen::Ref<Eigen::VectorXcd> P2,
+    Eigen::Ref<Eigen::VectorXcd> L);
+void AccumulateEPLArray(
+    const SampleRing &rfdata,
+    const uint64_t &ptr,
+    const uint64_t &n_samp,
+    const CodeReplica &code,
     double &rem_code_phase,
     double &code_freq,
     double &rem_carr_phase,
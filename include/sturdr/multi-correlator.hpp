@@ -0,0 +1,115 @@
+/**
+ * *multi-correlator.hpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/multi-correlator.hpp
+ * @brief   Bank of N evenly spaced code correlators sharing one carrier wipeoff.
+ * @date    October 2026
+ * @ref     1. "Understanding GPS/GNSS Principles and Applications", 3rd Edition, 2017
+ *              - Kaplan & Hegarty
+ *          2. "Intel 64 and IA-32 Architectures Optimization Reference Manual", 2023 - Intel
+ * =======  ========================================================================================
+ */
+
+#ifndef STURDR_MULTI_CORRELATOR_HPP
+#define STURDR_MULTI_CORRELATOR_HPP
+
+#include <Eigen/Dense>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+#include "sturdr/carrier-nco.hpp"
+#include "sturdr/code-replica.hpp"
+#include "sturdr/sample-ring.hpp"
+
+namespace sturdr {
+
+/**
+ * @brief Multi-correlator for multipath monitoring and correlation shape analysis. Each block of
+ *        samples is carrier wiped once into L1-resident re/im planes, then every tap is a
+ *        vectorized gather + multiply-accumulate over that block against the shared expanded chip
+ *        table, so adding taps costs no extra carrier generation or sample reads
+ */
+class MultiCorrelator {
+ public:
+  // number of samples carrier wiped per block
+  static constexpr uint64_t BLOCK = 512;
+
+  // widest span the expanded chip tables can serve without wrapping [chips]
+  static constexpr double MAX_SPAN = static_cast<double>(CodeReplica::PAD - 1);
+
+  /**
+   * *=== MultiCorrelator ===*
+   * @brief Constructor
+   * @param n_taps  Number of taps (>= 1)
+   * @param span    Offset of the outermost taps from prompt [chips], clamped to MAX_SPAN
+   */
+  MultiCorrelator(const uint16_t &n_taps, const double &span);
+
+  /**
+   * *=== Accumulate ===*
+   * @brief Adds 'n_samp' samples of the first antenna of 'rfdata' at 'ptr' to every tap. The
+   *        phases are only read, the channel's own correlator is expected to advance them
+   * @param rfdata          Shared sample ring
+   * @param ptr             First sample in the ring
+   * @param n_samp          Number of samples to accumulate
+   * @param code            Local code tables
+   * @param rem_code_phase  Initial fractional phase of the code [chips]
+   * @param code_freq       GNSS signal code frequency [Hz]
+   * @param rem_carr_phase  Initial fractional phase of the carrier [rad]
+   * @param carr_freq       Current carrier frequency (including intermediate frequency) [rad/s]
+   * @param carr_jit        Current carrier frequency jitter [rad/s^2]
+   * @param samp_freq       GNSS receiver front end sampling frequency [Hz]
+   */
+  void Accumulate(
+      const SampleRing &rfdata,
+      const uint64_t &ptr,
+      const uint64_t &n_samp,
+      const CodeReplica &code,
+      const double &rem_code_phase,
+      const double &code_freq,
+      const double &rem_carr_phase,
+      const double &carr_freq,
+      const double &carr_jit,
+      const double &samp_freq);
+
+  /**
+   * *=== Dump ===*
+   * @brief Copies the accumulated taps (most late to most early) and resets them to zero
+   * @param taps  Output correlators (resized to the number of taps)
+   */
+  void Dump(Eigen::VectorXcd &taps);
+
+  /**
+   * *=== Offsets ===*
+   * @brief Code offset of each tap relative to prompt, positive taps are early [chips]
+   */
+  const std::vector<double> &Offsets() const {
+    return offsets_;
+  }
+
+ private:
+  std::vector<double> offsets_;
+  std::vector<double> acc_re_;
+  std::vector<double> acc_im_;
+  CarrierNco nco_;
+
+  /**
+   * *=== AccumulateBlocks ===*
+   * @brief Carrier wipes and correlates 'n_samp' samples of 'rfdata' one block at a time
+   */
+  template <typename T>
+  void AccumulateBlocks(
+      const T *rfdata,
+      const uint64_t &n_samp,
+      const double *code,
+      const double &rem_code_phase,
+      const double &d_code,
+      const double &rem_carr_phase,
+      const double &d_carr);
+};
+
+}  // namespace sturdr
+
+#endif
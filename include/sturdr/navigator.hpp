@@ -32,6 +32,7 @@
 #include <sturdins/kinematic-nav.hpp>
 #include <thread>
 
+#include "sturdr/acquisition-aiding.hpp"
 #include "sturdr/concurrent-queue.hpp"
 #include "sturdr/structs-enums.hpp"
 
@@ -56,6 +57,8 @@ class Navigator {
   double receive_time_;
   uint64_t ms_elapsed_;
   std::map<uint8_t, ChannelNavData> ch_data_;
+  std::shared_ptr<AcquisitionAiding> acq_aiding_;
+  double aid_time_;
 
   std::shared_ptr<spdlog::logger> log_;
   std::shared_ptr<std::ofstream> nav_log_;
@@ -70,7 +73,11 @@ class Navigator {
   // std::mutex dds_mtx_;
 
  public:
-  Navigator(Config& conf, std::shared_ptr<ConcurrentQueue> queue, std::shared_ptr<bool> running);
+  Navigator(
+      Config& conf,
+      std::shared_ptr<ConcurrentQueue> queue,
+      std::shared_ptr<bool> running,
+      std::shared_ptr<AcquisitionAiding> acq_aiding = nullptr);
   ~Navigator();
 
   void NavThread();
@@ -78,6 +85,7 @@ class Navigator {
   void ChannelUpdate(ChannelNavPacket& msg);
   void EphemUpdate(ChannelEphemPacket& msg);
   void ScalarUpdate();
+  void AidingUpdate();
   bool VectorUpdate();
   void LogNavData();
   void LogDDSMsg();
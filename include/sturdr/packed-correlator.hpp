@@ -0,0 +1,87 @@
+/**
+ * *packed-correlator.hpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/packed-correlator.hpp
+ * @brief   Bit-packed early/prompt/late correlators for 1-bit and 2-bit front ends.
+ * @date    October 2026
+ * @ref     1. "Understanding GPS/GNSS Principles and Applications", 3rd Edition, 2017
+ *              - Kaplan & Hegarty
+ *          2. "Global Positioning System: Signals, Measurements, and Performance", 2nd Edition,
+ *              2006 - Misra & Enge
+ * =======  ========================================================================================
+ */
+
+#ifndef STURDR_PACKED_CORRELATOR_HPP
+#define STURDR_PACKED_CORRELATOR_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "sturdr/code-replica.hpp"
+#include "sturdr/fixed-correlator.hpp"
+#include "sturdr/sample-ring.hpp"
+
+namespace sturdr {
+
+// samples per carrier and code pattern block (8 words of 64 samples)
+constexpr uint64_t PACKED_BLOCK = 512;
+
+/**
+ * *=== AccumulateEPLPacked ===*
+ * @brief Accumulates 'n_samp' samples of the current integration period on the sign/magnitude
+ *        bit planes of a packed ring (see PackedPlane). The carrier is reduced to the sign of its
+ *        cosine and sine and the code to its chip sign, each packed 64 samples to a word, so a
+ *        word of products is one XOR and its sum two popcounts:
+ *          sum(mag * (-1)^p) = n - 2*pop(p) + 2*pop(m) - 4*pop(m & p),  mag = 1 + 2*m
+ *        Results are exact integer sums of the +/-1 and +/-3 samples against the square wave
+ *        carrier, scaled by FIXED_CARR_AMP so WidenEPL converts them like the fixed-point path
+ * @param rfdata          Shared sample ring (first antenna, must be packed)
+ * @param ptr             First sample in the ring
+ * @param n_samp          Number of samples to accumulate
+ * @param code            Local code tables
+ * @param rem_code_phase  Initial fractional phase of the code
+ * @param code_freq       GNSS signal code frequency [Hz]
+ * @param rem_carr_phase  Initial fractional phase of the carrier [rad]
+ * @param carr_freq       Current carrier frequency (including intermediate frequency) [rad/s]
+ * @param carr_jit        Current carrier frequency jitter [rad/s^2]
+ * @param samp_freq       GNSS receiver front end sampling frequency [Hz]
+ * @param half_samp       Number of samples in half the TOTAL accumulation period
+ * @param samp_remaining  Number of samples remaining to be accumulated inside TOTAL period
+ * @param t_space         Spacing between correlator taps
+ * @param epl             Integer accumulators (one per antenna for the array version)
+ */
+void AccumulateEPLPacked(
+    const SampleRing &rfdata,
+    const uint64_t &ptr,
+    const uint64_t &n_samp,
+    const CodeReplica &code,
+    double &rem_code_phase,
+    double &code_freq,
+    double &rem_carr_phase,
+    double &carr_freq,
+    double &carr_jit,
+    double &samp_freq,
+    uint64_t &half_samp,
+    uint64_t &samp_remaining,
+    double &t_space,
+    FixedEPL &epl);
+void AccumulateEPLArrayPacked(
+    const SampleRing &rfdata,
+    const uint64_t &ptr,
+    const uint64_t &n_samp,
+    const CodeReplica &code,
+    double &rem_code_phase,
+    double &code_freq,
+    double &rem_carr_phase,
+    double &carr_freq,
+    double &carr_jit,
+    double &samp_freq,
+    uint64_t &half_samp,
+    uint64_t &samp_remaining,
+    double &t_space,
+    std::vector<FixedEPL> &epl);
+
+}  // namespace sturdr
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * *peak-detector.hpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/peak-detector.hpp
+ * @brief   Streaming peak and noise floor statistics of an acquisition correlation map.
+ * @date    October 2026
+ * @ref     1. "Understanding GPS/GNSS Principles and Applications", 3rd Edition, 2017
+ *              - Kaplan & Hegarty
+ *          2. "A Software-Defined GPS and Galileo Receiver: A Single-Frequency Approach", 2007
+ *              - Borre, Akos, Bertelsen, Rinder, Jensen
+ * =======  ========================================================================================
+ */
+
+#ifndef STURDR_PEAK_DETECTOR_HPP
+#define STURDR_PEAK_DETECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sturdr {
+
+/**
+ * @brief Strongest cell of one Doppler bin
+ */
+struct AcquisitionCandidate {
+  int peak_idx[2];  // code phase [samples], Doppler bin
+  double power;
+};
+
+/**
+ * @brief Peak, sum and sum of squares of one Doppler column (see PeakDetector::AddColumn)
+ */
+struct ColumnStats {
+  int peak_samp;
+  double peak;
+  double sum;
+  double sum2;
+};
+
+/**
+ * @brief Reduces a correlation map to the statistics of Peak2NoiseFloorTest and GlrtTest one
+ *        Doppler column at a time, so the map never has to be stored or read back. The strongest
+ *        cell of each column competes for the 'top_k' candidates (one per Doppler bin), sums and
+ *        sums of squares are kept in double
+ */
+class PeakDetector {
+ public:
+  /**
+   * *=== PeakDetector ===*
+   * @brief Constructor
+   * @param top_k   Number of Doppler bin candidates to keep (>= 1)
+   */
+  explicit PeakDetector(const std::size_t &top_k = 1);
+
+  /**
+   * *=== Reset ===*
+   * @brief Clears the statistics before a new map
+   */
+  void Reset();
+
+  /**
+   * *=== AddColumn ===*
+   * @brief Merges the statistics of one Doppler column
+   * @param bin       Doppler bin index
+   * @param peak_samp Code phase of the column maximum [samples]
+   * @param peak      Column maximum
+   * @param sum       Sum of the column
+   * @param sum2      Sum of the squares of the column
+   * @param n         Number of cells in the column
+   */
+  void AddColumn(
+      const int &bin,
+      const int &peak_samp,
+      const double &peak,
+      const double &sum,
+      const double &sum2,
+      const uint64_t &n);
+
+  /**
+   * *=== AddInputPower ===*
+   * @brief Accumulates the power of the searched samples (GlrtTest)
+   * @param sum_abs2  Sum of the squared magnitude of the samples
+   * @param n         Number of samples
+   */
+  void AddInputPower(const double &sum_abs2, const uint64_t &n);
+
+  /**
+   * *=== Candidates ===*
+   * @brief Strongest Doppler bins, highest first
+   */
+  const std::vector<AcquisitionCandidate> &Candidates() const {
+    return cands_;
+  }
+
+  /**
+   * *=== Mean ===*
+   * @brief Mean of the map
+   */
+  double Mean() const;
+
+  /**
+   * *=== Sigma ===*
+   * @brief Sample standard deviation of the map
+   */
+  double Sigma() const;
+
+  /**
+   * *=== Metric ===*
+   * @brief Peak to noise floor ratio, equal to Peak2NoiseFloorTest of the full map
+   * @param peak_idx  Indexes of highest correlation peak
+   * @return (peak - mean) / sigma
+   */
+  double Metric(int peak_idx[2]) const;
+
+  /**
+   * *=== GlrtMetric ===*
+   * @brief General likelihood ratio, equal to GlrtTest of the full map and searched samples
+   */
+  double GlrtMetric() const;
+
+ private:
+  std::size_t top_k_;
+  std::vector<AcquisitionCandidate> cands_;
+  double sum_;
+  double sum2_;
+  uint64_t n_;
+  uint64_t n_rows_;
+  double in_pow_;
+  uint64_t n_in_;
+};
+
+}  // namespace sturdr
+
+#endif
@@ -0,0 +1,128 @@
+/**
+ * *prn-scheduler.hpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/prn-scheduler.hpp
+ * @brief   Assignment of PRNs to channels remembering the searches that failed.
+ * @date    October 2026
+ * =======  ========================================================================================
+ */
+
+#ifndef STURDR_PRN_SCHEDULER_HPP
+#define STURDR_PRN_SCHEDULER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "sturdr/acquisition-aiding.hpp"
+
+namespace sturdr {
+
+/**
+ * @brief Hands PRNs to the channels without locking. PRNs in use are bits of an atomic word
+ *        claimed with a single read-modify-write. A failed search puts its PRN in a back-off
+ *        that doubles with every consecutive failure (up to a maximum), and is forgotten once the
+ *        PRN has not failed for twice that maximum. PRNs without a remembered failure are handed
+ *        out first (in the aided search order once there is a fix, round robin otherwise),
+ *        PRNs out of their back-off after them, the one that came closest to detection first.
+ *        The aided order is copied from the aiding once per prediction, behind a sequence
+ *        counter the claims read it with
+ */
+class PrnScheduler {
+ public:
+  static constexpr uint8_t N_PRN = 32;
+
+  /**
+   * *=== PrnScheduler ===*
+   * @brief Constructor
+   * @param backoff_ms      Back-off after a first failed search [ms] (0 to retry at once)
+   * @param max_backoff_ms  Longest back-off [ms]
+   * @param acq_aiding      Shared satellite predictions (nullptr to search PRNs in order)
+   */
+  PrnScheduler(
+      const uint64_t &backoff_ms,
+      const uint64_t &max_backoff_ms,
+      std::shared_ptr<AcquisitionAiding> acq_aiding = nullptr);
+
+  /**
+   * *=== SetTime ===*
+   * @brief Advances the clock the back-offs are measured with, and publishes the aided search
+   *        order when the aiding made new predictions
+   * @param ms  Receiver time [ms]
+   */
+  void SetTime(const uint64_t &ms);
+
+  /**
+   * *=== Claim ===*
+   * @brief Takes the PRN of highest priority that is neither in use nor backing off
+   * @return Claimed PRN (0 when none is available)
+   */
+  uint8_t Claim();
+
+  /**
+   * *=== Release ===*
+   * @brief Returns a PRN without recording a failure
+   * @param prn Satellite PRN (1-32)
+   */
+  void Release(const uint8_t &prn);
+
+  /**
+   * *=== Failed ===*
+   * @brief Records a failed search of 'prn' and returns it
+   * @param prn     Satellite PRN (1-32)
+   * @param metric  Detection metric of the search
+   */
+  void Failed(const uint8_t &prn, const double &metric);
+
+ private:
+  /**
+   * *=== TryClaim ===*
+   * @brief Sets the in-use bit of 'prn'
+   * @return False when another channel holds it
+   */
+  bool TryClaim(const uint8_t &prn);
+
+  /**
+   * *=== PublishOrder ===*
+   * @brief Copies the aided search order of prediction 'generation' for the claims to read
+   */
+  void PublishOrder(const uint32_t &generation);
+
+  /**
+   * *=== LoadOrder ===*
+   * @brief Copies the published search order (every PRN round robin until there is one)
+   * @param order PRNs in search order
+   * @return Number of PRNs in 'order'
+   */
+  uint8_t LoadOrder(std::array<uint8_t, N_PRN> &order) const;
+
+  /**
+   * *=== Backoff ===*
+   * @brief Back-off after 'n_fail' consecutive failures [ms]
+   */
+  uint64_t Backoff(const uint16_t &n_fail) const;
+
+  uint64_t backoff_ms_;
+  uint64_t max_backoff_ms_;
+  std::shared_ptr<AcquisitionAiding> acq_aiding_;
+  std::atomic<uint32_t> in_use_;
+  std::atomic<uint64_t> now_ms_;
+  std::atomic<uint8_t> rr_ptr_;
+
+  // aided search order, odd 'order_seq_' while it is being written
+  std::atomic<uint32_t> order_seq_;
+  std::atomic<uint32_t> order_gen_;
+  std::atomic<uint8_t> n_order_;
+  std::array<std::atomic<uint8_t>, N_PRN> order_;
+
+  // written by the channel holding the PRN before it releases it
+  std::array<std::atomic<uint16_t>, N_PRN> n_fail_;
+  std::array<std::atomic<uint64_t>, N_PRN> fail_ms_;
+  std::array<std::atomic<double>, N_PRN> fail_metric_;
+};
+
+}  // namespace sturdr
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ * *reacquisition.hpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/reacquisition.hpp
+ * @brief   Loss of lock detection and the reacquisition search window that follows it.
+ * @date    October 2026
+ * =======  ========================================================================================
+ */
+
+#ifndef STURDR_REACQUISITION_HPP
+#define STURDR_REACQUISITION_HPP
+
+#include <cstdint>
+
+#include "sturdr/acquisition.hpp"
+#include "sturdr/structs-enums.hpp"
+
+namespace sturdr {
+
+/**
+ * @brief Decides when a track is lost and where to look for it again. A track is lost after
+ *        'loss_ms' without code lock (not counting the time its loops get to converge). The
+ *        reacquisition searches the Doppler bins around the last epoch that had code lock, widened
+ *        by the drift the satellite may have had since, and gives up on them after 'timeout_ms'
+ */
+class Reacquisition {
+ public:
+  /**
+   * *=== Reacquisition ===*
+   * @brief Constructor
+   * @param loss_ms     Time without code lock before the track is lost [ms] (0 never loses it)
+   * @param timeout_ms  Time to reacquire before falling back to a full acquisition [ms]
+   * @param width       Half width of the first search window [Hz]
+   * @param rate        Widening of the half width [Hz/s]
+   * @param d_range     Max Doppler of the acquisition grid [Hz]
+   * @param d_step      Doppler step of the acquisition grid [Hz]
+   */
+  Reacquisition(
+      const uint64_t &loss_ms,
+      const uint64_t &timeout_ms,
+      const double &width,
+      const double &rate,
+      const double &d_range,
+      const double &d_step);
+
+  /**
+   * *=== Start ===*
+   * @brief Begins a new track
+   * @param doppler     Acquired Doppler, the window center until the first lock [Hz]
+   * @param converge_ms Time the loops get to lock before a missing lock counts [ms]
+   */
+  void Start(const double &doppler, const uint64_t &converge_ms);
+
+  /**
+   * *=== Update ===*
+   * @brief Counts one tracking epoch, keeping the Doppler of epochs with code lock
+   * @param code_lock True when the epoch had code lock
+   * @param doppler   Tracked Doppler [Hz]
+   * @param ms        Length of the epoch [ms]
+   * @return True when the track is lost (the reacquisition time starts over)
+   */
+  bool Update(const bool &code_lock, const double &doppler, const uint64_t &ms);
+
+  /**
+   * *=== Elapse ===*
+   * @brief Counts samples skipped or searched while reacquiring, widening the window
+   * @param ms  Time since the last call [ms]
+   */
+  void Elapse(const uint64_t &ms);
+
+  /**
+   * *=== Window ===*
+   * @brief Doppler bins around the last locked Doppler for the time spent reacquiring (the code
+   *        phase is not narrowed, a circular correlation costs the same over fewer lags)
+   * @return Doppler bins to search
+   */
+  DopplerWindow Window() const;
+
+  /**
+   * *=== Width ===*
+   * @brief Half width of the window for the time spent reacquiring [Hz]
+   */
+  double Width() const;
+
+  /**
+   * *=== Searched ===*
+   * @brief Channel state after a reacquisition search
+   * @param found True when the search detected the satellite
+   * @return TRACKING when found, ACQUIRING once timed out, REACQUIRING otherwise
+   */
+  ChannelState::ChannelState Searched(const bool &found) const;
+
+  /**
+   * *=== Doppler ===*
+   * @brief Doppler the window is centered on [Hz]
+   */
+  double Doppler() const {
+    return doppler_;
+  }
+
+  /**
+   * *=== Elapsed ===*
+   * @brief Time spent reacquiring [ms]
+   */
+  uint64_t Elapsed() const {
+    return reacq_ms_;
+  }
+
+ private:
+  uint64_t loss_ms_;
+  uint64_t timeout_ms_;
+  double width_;
+  double rate_;
+  double d_range_;
+  double d_step_;
+  int64_t lost_ms_;
+  uint64_t reacq_ms_;
+  double doppler_;
+};
+
+}  // namespace sturdr
+
+#endif
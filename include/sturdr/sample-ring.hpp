@@ -0,0 +1,238 @@
+/**
+ * *sample-ring.hpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/sample-ring.hpp
+ * @brief   Shared ring buffer of front end samples, stored as complex doubles/floats or natively.
+ * @date    October 2026
+ * =======  ========================================================================================
+ */
+
+#ifndef STURDR_SAMPLE_RING_HPP
+#define STURDR_SAMPLE_RING_HPP
+
+#include <Eigen/Dense>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "sturdr/data-type-adapters.hpp"
+
+namespace sturdr {
+
+/**
+ * @brief Storage format of the shared ring buffer
+ */
+namespace SampleFormat {
+enum SampleFormat : uint8_t {
+  CDOUBLE = 0,  // complex<double>, 16 bytes per sample (input converted by the reader)
+  INT8 = 1,     // real int8, 1 byte per sample
+  INT16 = 2,    // real int16, 2 bytes per sample
+  CINT8 = 3,    // interleaved int8 I/Q, 2 bytes per sample
+  CINT16 = 4,   // interleaved int16 I/Q, 4 bytes per sample
+  CFLOAT = 5,   // complex<float>, 8 bytes per sample (single precision pipeline)
+};
+}  // namespace SampleFormat
+
+/**
+ * @brief Bit planes of a packed ring, a sample 'x' is stored as its sign (x < 0) and magnitude
+ *        (|x| > 1) bits, i.e. the sign/magnitude code of a 1-bit (+/-1) or 2-bit (+/-1, +/-3) front
+ *        end
+ */
+namespace PackedPlane {
+enum PackedPlane : uint8_t { I_SIGN = 0, I_MAG = 1, Q_SIGN = 2, Q_MAG = 3 };
+}  // namespace PackedPlane
+
+/**
+ * *=== NativeSampleFormat ===*
+ * @brief Compact ring format able to hold the front end samples without conversion
+ * @param is_complex  Whether the recorded samples are I/Q
+ * @param bit_depth   Bits per (real or imaginary) sample
+ * @return Native format, or CDOUBLE when the samples are not integers
+ */
+inline SampleFormat::SampleFormat NativeSampleFormat(
+    const bool &is_complex, const uint8_t &bit_depth) {
+  if (bit_depth == 8) {
+    return is_complex ? SampleFormat::CINT8 : SampleFormat::INT8;
+  } else if (bit_depth == 16) {
+    return is_complex ? SampleFormat::CINT16 : SampleFormat::INT16;
+  }
+  return SampleFormat::CDOUBLE;
+}
+
+/**
+ * @brief Sample buffer shared between the file reader and the channels (one column per antenna).
+ *        In a native format the reader copies samples straight in and the correlators widen them
+ *        to double a block at a time, cutting ring memory and read bandwidth by 4-16x. 8 bit rings
+ *        can also keep sign/magnitude bit planes for the packed (XOR/popcount) correlators
+ */
+class SampleRing {
+ public:
+  /**
+   * *=== SampleRing ===*
+   * @brief Constructor
+   * @param n_samp  Number of samples per antenna
+   * @param n_ant   Number of antennas
+   * @param format  Storage format
+   * @param packed  Also keep sign/magnitude bit planes of the samples (INT8 and CINT8 only)
+   */
+  SampleRing(
+      const uint64_t &n_samp,
+      const uint8_t &n_ant,
+      const SampleFormat::SampleFormat &format,
+      const bool &packed = false);
+
+  /**
+   * *=== Write ===*
+   * @brief Stores 'len' samples of one antenna starting at 'ptr' (must not wrap around the ring).
+   *        Each antenna must have a single writer (the file reader): bit plane words are shared by
+   *        64 neighbouring samples, so concurrent writes to one antenna could lose samples
+   * @param in  Samples read from the front end (T or std::complex<T>)
+   * @param ant Antenna index
+   * @param ptr First sample in the ring
+   * @param len Number of samples
+   */
+  template <typename T>
+  void Write(const T in[], const uint8_t &ant, const uint64_t &ptr, const uint64_t &len) {
+    if (format_ == SampleFormat::CDOUBLE) {
+      if constexpr (std::is_arithmetic_v<T>) {
+        TypeToIDouble<T>(in, cd_.col(ant).segment(ptr, len).data(), static_cast<int>(len));
+      } else {
+        ITypeToIDouble<typename T::value_type>(
+            in, cd_.col(ant).segment(ptr, len).data(), static_cast<int>(len));
+      }
+    } else if (format_ == SampleFormat::CFLOAT) {
+      std::complex<float> *out = cf_.col(ant).data() + ptr;
+      for (uint64_t i = 0; i < len; i++) {
+        if constexpr (std::is_arithmetic_v<T>) {
+          out[i] = std::complex<float>(static_cast<float>(in[i]), 0.0f);
+        } else {
+          out[i] = std::complex<float>(
+              static_cast<float>(in[i].real()), static_cast<float>(in[i].imag()));
+        }
+      }
+    } else if constexpr (std::is_same_v<T, int8_t> || std::is_same_v<T, std::complex<int8_t>>) {
+      std::memcpy(Int8(ant, ptr), in, len * sizeof(T));
+      if (IsPacked()) {
+        Pack(ant, ptr, len);
+      }
+    } else if constexpr (std::is_same_v<T, int16_t> || std::is_same_v<T, std::complex<int16_t>>) {
+      std::memcpy(Int16(ant, ptr), in, len * sizeof(T));
+    }
+  }
+
+  /**
+   * *=== Read ===*
+   * @brief Copies 'len' samples of one antenna starting at 'ptr', converted to complex double
+   *        (Real = double) or complex float (Real = float)
+   * @param out Output samples
+   * @param ant Antenna index
+   * @param ptr First sample in the ring
+   * @param len Number of samples
+   */
+  template <typename Real>
+  void Read(
+      std::complex<Real> out[], const uint8_t &ant, const uint64_t &ptr, const uint64_t &len)
+      const;
+
+  /**
+   * *=== View ===*
+   * @brief Returns a complex view of 'len' samples on 'n_ant' antennas starting at 'ptr', either
+   *        directly into the ring (CDOUBLE for double, CFLOAT for float) or converted into
+   *        'scratch'
+   * @param ptr     First sample in the ring
+   * @param len     Number of samples
+   * @param n_ant   Number of antennas (columns)
+   * @param scratch Conversion buffer, resized as needed
+   * @return Block of samples (len x n_ant)
+   */
+  template <typename Real>
+  Eigen::Ref<const Eigen::MatrixX<std::complex<Real>>> View(
+      const uint64_t &ptr,
+      const uint64_t &len,
+      const uint8_t &n_ant,
+      Eigen::MatrixX<std::complex<Real>> &scratch) const;
+
+  /**
+   * *=== Accessors ===*
+   * @brief Raw storage, 'Matrix' for CDOUBLE, 'MatrixF' for CFLOAT, 'Int8' for INT8/CINT8 and
+   *        'Int16' for INT16/CINT16 (I/Q interleaved for the complex formats)
+   */
+  SampleFormat::SampleFormat Format() const {
+    return format_;
+  }
+  bool IsComplex() const {
+    return format_ != SampleFormat::INT8 && format_ != SampleFormat::INT16;
+  }
+  bool IsInteger() const {
+    return format_ != SampleFormat::CDOUBLE && format_ != SampleFormat::CFLOAT;
+  }
+  bool IsPacked() const {
+    return !bits_.empty();
+  }
+  uint64_t Rows() const {
+    return n_samp_;
+  }
+  uint8_t Cols() const {
+    return n_ant_;
+  }
+  std::size_t Bytes() const;
+  const Eigen::MatrixXcd &Matrix() const {
+    return cd_;
+  }
+  const Eigen::MatrixXcf &MatrixF() const {
+    return cf_;
+  }
+  int8_t *Int8(const uint8_t &ant, const uint64_t &ptr) {
+    return i8_.data() + Offset(ant, ptr);
+  }
+  const int8_t *Int8(const uint8_t &ant, const uint64_t &ptr) const {
+    return i8_.data() + Offset(ant, ptr);
+  }
+  int16_t *Int16(const uint8_t &ant, const uint64_t &ptr) {
+    return i16_.data() + Offset(ant, ptr);
+  }
+  const int16_t *Int16(const uint8_t &ant, const uint64_t &ptr) const {
+    return i16_.data() + Offset(ant, ptr);
+  }
+
+  /**
+   * *=== BitPlane ===*
+   * @brief One bit per sample, sample 'k' at bit (k % 64) of word (k / 64), followed by a zero
+   *        guard word so any 64 consecutive samples can be read with two loads
+   * @param plane Plane index (see PackedPlane)
+   * @param ant   Antenna index
+   * @return First word of the plane
+   */
+  const uint64_t *BitPlane(const uint8_t &plane, const uint8_t &ant) const {
+    return bits_.data() + (static_cast<uint64_t>(ant) * 4 + plane) * n_words_;
+  }
+
+ private:
+  SampleFormat::SampleFormat format_;
+  uint64_t n_samp_;
+  uint8_t n_ant_;
+  Eigen::MatrixXcd cd_;
+  Eigen::MatrixXcf cf_;
+  std::vector<int8_t> i8_;
+  std::vector<int16_t> i16_;
+  std::vector<uint64_t> bits_;
+  uint64_t n_words_;
+
+  // *=== Pack ===*
+  // rebuilds the whole bit plane words holding 'len' INT8/CINT8 samples of one antenna starting at
+  // 'ptr'
+  void Pack(const uint8_t &ant, const uint64_t &ptr, const uint64_t &len);
+
+  // index of the first value of a sample inside the native storage
+  uint64_t Offset(const uint8_t &ant, const uint64_t &ptr) const {
+    uint64_t stride = IsComplex() ? 2 : 1;
+    return stride * (static_cast<uint64_t>(ant) * n_samp_ + ptr);
+  }
+};
+
+}  // namespace sturdr
+
+#endif
@@ -0,0 +1,146 @@
+/**
+ * *simd-correlator.hpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/simd-correlator.hpp
+ * @brief   Vectorized correlator kernels selected at runtime by CPU feature detection.
+ * @date    October 2026
+ * @ref     1. "Intel 64 and IA-32 Architectures Optimization Reference Manual", 2023 - Intel
+ *          2. "A Software-Defined GPS and Galileo Receiver: A Single-Frequency Approach", 2007
+ *              - Borre, Akos, Bertelsen, Rinder, Jensen
+ * =======  ========================================================================================
+ */
+
+#ifndef STURDR_SIMD_CORRELATOR_HPP
+#define STURDR_SIMD_CORRELATOR_HPP
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+
+#include "sturdr/carrier-nco.hpp"
+
+// x86 kernels are compiled with per-function target attributes and chosen at runtime
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define STURDR_SIMD_X86 1
+#endif
+
+namespace sturdr {
+
+namespace SimdLevel {
+enum SimdLevel { SCALAR = 0, GENERIC = 1, SSE2 = 2, AVX2 = 3, AVX512 = 4 };
+};  // namespace SimdLevel
+
+/**
+ * *=== DetectSimdLevel ===*
+ * @brief Queries the CPU for the widest vector instruction set the kernels can use
+ * @return Highest supported SIMD level
+ */
+SimdLevel::SimdLevel DetectSimdLevel();
+
+/**
+ * *=== GetSimdLevel ===*
+ * @brief Returns the SIMD level currently used by the correlators
+ * @return Active SIMD level
+ */
+SimdLevel::SimdLevel GetSimdLevel();
+
+/**
+ * *=== SetSimdLevel ===*
+ * @brief Overrides the SIMD level used by the correlators (clamped to what the CPU supports),
+ *        SCALAR selects the per-sample reference implementation and GENERIC the portable blocked
+ *        kernel
+ * @param level Requested SIMD level
+ */
+void SetSimdLevel(const SimdLevel::SimdLevel &level);
+
+/**
+ * *=== ChipIndex ===*
+ * @brief Rounds a code phase to the nearest chip and wraps it into [0, 1023)
+ * @param phase Code phase [chips]
+ * @return Chip index
+ */
+inline int ChipIndex(const double &phase) {
+  double idx = std::floor(phase + 0.5);
+  idx -= 1023.0 * std::floor(idx / 1023.0);
+  return static_cast<int>(idx);
+}
+
+/**
+ * *=== AccumulateEPLSimd ===*
+ * @brief Vectorized early/prompt/late accumulation (up to 8 samples per iteration)
+ * @note  The carrier is generated in 512 sample blocks by CarrierNco (see GetCarrierNcoMode) and
+ *        phases are computed as 'phase0 + k*d' instead of by repeated addition, so results differ
+ *        from the per-sample loop by ~1e-9 relative (the loop's own phase rounding)
+ * @param nco             Carrier generator to reuse across calls (optional)
+ * @param rfdata          Recorded signal data
+ * @param n_samp          Number of samples to accumulate
+ * @param code            Expanded +/-1.0 chip table (CodeReplica::f64_expanded)
+ * @param rem_code_phase  Initial fractional phase of the code [chips]
+ * @param d_code          Code phase increment per sample [chips]
+ * @param rem_carr_phase  Initial fractional phase of the carrier [rad]
+ * @param d_carr          Carrier phase increment per sample [rad]
+ * @param n_first_half    Number of leading samples that belong to the first prompt half
+ * @param t_space         Spacing between correlator taps [chips]
+ * @param E               Early correlator
+ * @param P1              Prompt first-half correlator
+ * @param P2              Prompt second-half correlator
+ * @param L               Late correlator
+ */
+void AccumulateEPLSimd(
+    const std::complex<double> *rfdata,
+    const uint64_t &n_samp,
+    const double *code,
+    double &rem_code_phase,
+    const double &d_code,
+    double &rem_carr_phase,
+    const double &d_carr,
+    const uint64_t &n_first_half,
+    const double &t_space,
+    std::complex<double> &E,
+    std::complex<double> &P1,
+    std::complex<double> &P2,
+    std::complex<double> &L);
+
+void AccumulateEPLSimd(
+    CarrierNco &nco,
+    const std::complex<double> *rfdata,
+    const uint64_t &n_samp,
+    const double *code,
+    double &rem_code_phase,
+    const double &d_code,
+    double &rem_carr_phase,
+    const double &d_carr,
+    const uint64_t &n_first_half,
+    const double &t_space,
+    std::complex<double> &E,
+    std::complex<double> &P1,
+    std::complex<double> &P2,
+    std::complex<double> &L);
+
+/**
+ * *=== AccumulateEPLSimd ===*
+ * @brief Same as above for samples kept in their native front end type (int8_t, int16_t and their
+ *        std::complex I/Q pairs) or in single precision (std::complex<float>), each chunk is
+ *        widened to double just before it is correlated
+ */
+template <typename T>
+void AccumulateEPLSimd(
+    CarrierNco &nco,
+    const T *rfdata,
+    const uint64_t &n_samp,
+    const double *code,
+    double &rem_code_phase,
+    const double &d_code,
+    double &rem_carr_phase,
+    const double &d_carr,
+    const uint64_t &n_first_half,
+    const double &t_space,
+    std::complex<double> &E,
+    std::complex<double> &P1,
+    std::complex<double> &P2,
+    std::complex<double> &L);
+
+}  // namespace sturdr
+
+#endif
@@ -59,7 +59,7 @@ enum MeasurementType { UNKNOWN = 0, PSEUDORANGE = 1, DOPPLER = 2, PHASE = 4, CNO
 };  // namespace MeasurementType
 
 namespace ChannelState {
-enum ChannelState { OFF = 0, IDLE = 1, ACQUIRING = 2, TRACKING = 4 };
+enum ChannelState { OFF = 0, IDLE = 1, ACQUIRING = 2, TRACKING = 4, REACQUIRING = 8 };
 };  // namespace ChannelState
 
 namespace TrackingFlags {
@@ -101,6 +101,8 @@ struct RfSignalConfig {
   uint8_t bit_depth;
   std::string signals;
   uint8_t max_channels;
+  bool compact_ring = false;
+  bool single_precision = false;
 };
 struct AcquisitionConfig {
   double threshold;
@@ -109,6 +111,24 @@ struct AcquisitionConfig {
   uint8_t num_coh_per;
   uint8_t num_noncoh_per;
   uint16_t max_failed_attempts;
+  bool cache_carrier = true;
+  bool freq_domain_search = false;
+  bool async_acquisition = false;
+  uint16_t acquisition_workers = 1;
+  uint16_t max_acquisitions = 2;
+  uint16_t fftw_threads = 1;
+  uint16_t acquisition_threads = 1;
+  std::string fft_planning = "estimate";
+  std::string fft_wisdom_dir = "";
+  bool fft_warmup = false;
+  double acquisition_rate = 0.0;
+  bool aided_acquisition = false;
+  std::string ephemeris_file = "";
+  double elevation_mask = 5.0;
+  double aided_doppler_sigma = 50.0;
+  bool fine_acquisition = true;
+  uint32_t prn_backoff_ms = 2000;
+  uint32_t prn_backoff_max_ms = 30000;
 };
 struct TrackingConfig {
   uint16_t min_converg_time_ms;
@@ -125,6 +145,15 @@ struct TrackingConfig {
   double pll_bw_narrow;
   double fll_bw_narrow;
   double cno_alpha = 0.005;
+  bool batch_correlate = false;
+  bool fixed_point_correlate = false;
+  bool packed_correlate = false;
+  uint16_t multi_correlator_taps = 0;
+  double multi_correlator_span = 1.5;
+  uint16_t loss_of_lock_ms = 1000;
+  uint16_t reacq_timeout_ms = 5000;
+  double reacq_doppler_width = 250.0;
+  double reacq_doppler_rate = 500.0;
 };
 struct NavigationConfig {
   bool use_psr;
@@ -197,8 +226,13 @@ struct ChannelPacket {
   double QP_A1{std::nan("1")};
   double QP_A2{std::nan("1")};
   double QP_A3{std::nan("1")};
+  Eigen::VectorXcd Correlators;
 };
 
+// bytes of the fixed size fields of a ChannelPacket written to the binary channel logs (any
+// 'Correlators' taps are written right after them)
+constexpr std::size_t CHANNEL_PACKET_LOG_SIZE = sizeof(ChannelPacket) - sizeof(Eigen::VectorXcd);
+
 /**
  * @brief Minimal packet of ephemeris data to be sent to the navigation controller
  */
@@ -421,6 +455,9 @@ struct fmt::formatter<sturdr::ChannelState::ChannelState> : formatter<string_vie
       case sturdr::ChannelState::ChannelState::TRACKING:
         name = "TRACKING";
         break;
+      case sturdr::ChannelState::ChannelState::REACQUIRING:
+        name = "REACQUIRING";
+        break;
     }
     return formatter<string_view>::format(name, ctx);
   };
@@ -16,18 +16,22 @@
 #include <spdlog/spdlog.h>
 
 #include <Eigen/Dense>
-#include <map>
 #include <memory>
 #include <sturdio/binary-file.hpp>
 #include <sturdio/yaml-parser.hpp>
 #include <vector>
 
+#include "sturdr/acquisition-aiding.hpp"
+#include "sturdr/acquisition-engine.hpp"
+#include "sturdr/batch-correlator.hpp"
 #include "sturdr/channel-gps-l1ca-array.hpp"
 #include "sturdr/channel-gps-l1ca.hpp"
 #include "sturdr/concurrent-barrier.hpp"
 #include "sturdr/concurrent-queue.hpp"
 #include "sturdr/fftw-wrapper.hpp"
 #include "sturdr/navigator.hpp"
+#include "sturdr/prn-scheduler.hpp"
+#include "sturdr/sample-ring.hpp"
 #include "sturdr/structs-enums.hpp"
 
 namespace sturdr {
@@ -49,7 +53,7 @@ class SturDR {
   uint64_t shm_ptr_;
   uint64_t shm_file_size_samp_;
   uint64_t shm_read_size_samp_;
-  std::shared_ptr<Eigen::MatrixXcd> shm_;
+  std::shared_ptr<SampleRing> shm_;
 
   /**
    * @brief channel parameters
@@ -58,9 +62,15 @@ class SturDR {
   std::shared_ptr<bool> running_;
   uint64_t n_dopp_bins_;
   std::shared_ptr<FftwWrapper> fftw_plans_;
-  uint8_t prn_ptr_;
-  std::map<uint8_t, bool> prns_in_use_;
-  std::mutex prn_mtx_;
+  std::shared_ptr<FftwWrapperF> fftwf_plans_;
+  std::shared_ptr<AcquisitionContext> acq_ctx_;
+  std::shared_ptr<AcquisitionContextF> acq_ctx_f_;
+  std::shared_ptr<AcquisitionWorkspacePool> acq_pool_;
+  std::shared_ptr<AcquisitionWorkspacePoolF> acq_pool_f_;
+  std::shared_ptr<AcquisitionEngine> acq_engine_;
+  std::shared_ptr<AcquisitionAiding> acq_aiding_;
+  std::shared_ptr<BatchCorrelator> batch_correlator_;
+  std::shared_ptr<PrnScheduler> prn_scheduler_;
   std::vector<ChannelGpsL1ca> gps_l1ca_channels_;
   std::vector<ChannelGpsL1caArray> gps_l1ca_array_channels_;
   std::shared_ptr<ConcurrentBarrier> barrier1_;
@@ -116,12 +126,6 @@ class SturDR {
   template <typename T>
   void RunComplexArray();
 
-  /**
-   * @brief Thread safe function for a channel to request a new PRN
-   * @param prn current channel prn
-   */
-  void GetNewPrn(uint8_t &prn);
-
   /**
    * *=== InitChannels ===*
    * @brief initializes channels to be used
@@ -21,6 +21,7 @@
 #define STURDR_TRACKING_HPP
 
 #include <Eigen/Dense>
+#include <navtools/constants.hpp>
 
 namespace sturdr {
 
@@ -139,13 +140,17 @@ class TrackingKF {
    * @param init_T            Integration time [s]
    * @param intmd_freq        Intermediate frequency of the recorded signal [rad/s]
    * @param code_freq         Chipping rate of the true signal [chip/s]
+   * @param init_doppler_var  Variance of the initial doppler estimate [(rad/s)^2]
+   * @param init_code_var     Variance of the initial code phase estimate [chip^2]
    */
   void Init(
       const double &init_carr_phase,
       const double &init_carr_doppler,
       const double &init_code_phase,
       const double &intmd_freq,
-      const double &code_freq);
+      const double &code_freq,
+      const double &init_doppler_var = navtools::PI_SQU<> * 62.5e3,
+      const double &init_code_var = 5e-1);
 
   /**
    * *=== UpdateDynamicsParam ===*
@@ -0,0 +1,91 @@
+/**
+ * *worker-pool.hpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/worker-pool.hpp
+ * @brief   Persistent threads splitting one loop of independent tasks.
+ * @date    October 2026
+ * =======  ========================================================================================
+ */
+
+#ifndef STURDR_WORKER_POOL_HPP
+#define STURDR_WORKER_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sturdr {
+
+/**
+ * @brief Helper threads lent to one ParallelFor at a time. The calling thread always takes part,
+ *        and a caller finding the pool busy (another acquisition is using it) runs its loop alone
+ *        instead of waiting, so the pool only ever adds otherwise idle cores
+ */
+class WorkerPool {
+ public:
+  /**
+   * *=== WorkerPool ===*
+   * @brief Constructor, starts 'n_threads - 1' helper threads
+   * @param n_threads Threads per loop, including the caller (>= 1)
+   */
+  explicit WorkerPool(const uint16_t &n_threads);
+
+  /**
+   * *=== ~WorkerPool ===*
+   * @brief Destructor, joins the helper threads
+   */
+  ~WorkerPool();
+
+  /**
+   * *=== Size ===*
+   * @brief Threads per loop, including the caller
+   */
+  std::size_t Size() const {
+    return workers_.size() + 1;
+  }
+
+  /**
+   * *=== ParallelFor ===*
+   * @brief Runs fn(0) ... fn(n - 1) across the pool and returns once all are done, the first
+   *        exception thrown by a task is rethrown here
+   * @param n   Number of tasks
+   * @param fn  Task, must be safe to run concurrently for different indexes
+   */
+  void ParallelFor(const int &n, const std::function<void(const int &)> &fn);
+
+ private:
+  std::vector<std::thread> workers_;
+  std::mutex run_mtx_;  // held by the loop owning the helpers
+  std::mutex mtx_;
+  std::condition_variable start_cv_;
+  std::condition_variable done_cv_;
+  const std::function<void(const int &)> *fn_;
+  int n_;
+  std::atomic<int> next_;
+  std::size_t active_;
+  uint64_t gen_;
+  bool stop_;
+  std::exception_ptr err_;
+
+  /**
+   * *=== Run ===*
+   * @brief Takes task indexes until none are left
+   */
+  void Run(const std::function<void(const int &)> &fn, const int &n);
+
+  /**
+   * *=== Work ===*
+   * @brief Helper thread, joins every loop started
+   */
+  void Work();
+};
+
+}  // namespace sturdr
+
+#endif
@@ -0,0 +1,153 @@
+/**
+ * *acquisition-aiding.cpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/acquisition-aiding.cpp
+ * @brief   Visibility and Doppler predictions narrowing acquisition once a fix is available.
+ * @date    October 2026
+ * @ref     1. "Understanding GPS/GNSS Principles and Applications", 3rd Edition, 2017
+ *              - Kaplan & Hegarty
+ *          2. "Global Positioning System: Signals, Measurements, and Performance", 2nd Edition,
+ *              2006 - Misra & Enge
+ * =======  ========================================================================================
+ */
+
+#include "sturdr/acquisition-aiding.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <navtools/constants.hpp>
+#include <navtools/frames.hpp>
+#include <satutils/gnss-constants.hpp>
+
+namespace sturdr {
+
+namespace {
+
+// ephemerides further than this from their reference time are not used [s]
+constexpr double MAX_EPHEM_AGE = 86400.0;
+
+}  // namespace
+
+// *=== AcquisitionAiding ===*
+AcquisitionAiding::AcquisitionAiding(
+    const double &elev_mask, const double &dopp_sigma, const double &n_sigma)
+    : elev_mask_{elev_mask},
+      dopp_sigma_{dopp_sigma},
+      n_sigma_{n_sigma},
+      has_fix_{false},
+      generation_{0} {
+  has_eph_.fill(false);
+  pred_.fill(Prediction{false, 0.0, 0.0});
+}
+
+// *=== SetEphemeris ===*
+void AcquisitionAiding::SetEphemeris(
+    const uint8_t &prn, const satutils::KeplerElements<double> &eph) {
+  if (prn < 1 || prn > N_PRN) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mtx_);
+  sv_[prn - 1].SetEphemerides(eph);
+  has_eph_[prn - 1] = true;
+}
+
+// *=== LoadEphemerides ===*
+std::size_t AcquisitionAiding::LoadEphemerides(const std::string &fname) {
+  std::ifstream file(fname, std::ios::binary);
+  std::array<bool, N_PRN> loaded{};
+  uint8_t prn;
+  satutils::KeplerElements<double> eph;
+  while (file.read(reinterpret_cast<char *>(&prn), sizeof(uint8_t)) &&
+         file.read(reinterpret_cast<char *>(&eph), sizeof(satutils::KeplerElements<double>))) {
+    if (prn >= 1 && prn <= N_PRN) {
+      SetEphemeris(prn, eph);
+      loaded[prn - 1] = true;
+    }
+  }
+  return std::count(loaded.begin(), loaded.end(), true);
+}
+
+// *=== Predict ===*
+void AcquisitionAiding::Predict(
+    const double &tow,
+    const Eigen::Vector3d &xyz,
+    const Eigen::Vector3d &xyzv,
+    const double &clk_drift) {
+  double lambda = navtools::LIGHT_SPEED<> / satutils::GPS_L1_FREQUENCY<>;
+  Eigen::Matrix3d C_e_l = navtools::ecef2nedDcm<double>(navtools::ecef2lla<double>(xyz));
+  Eigen::Vector3d sv_clk, sv_pos, sv_vel, sv_acc;
+
+  std::unique_lock<std::mutex> lock(mtx_);
+  for (uint8_t i = 0; i < N_PRN; i++) {
+    pred_[i].valid = false;
+    if (!has_eph_[i] || sv_[i].health != 0) {
+      continue;
+    }
+    double age = std::remainder(tow - sv_[i].toe, 604800.0);
+    if (std::abs(age) > MAX_EPHEM_AGE) {
+      continue;
+    }
+
+    // line of sight from the receiver (transmit time of a nominal transit) and the range rate
+    // seen through both clock drifts
+    sv_[i].CalcNavStates<false>(sv_clk, sv_pos, sv_vel, sv_acc, tow - 0.075);
+    Eigen::Vector3d u = (sv_pos - xyz).normalized();
+    double range_rate = u.dot(sv_vel - xyzv) + clk_drift - navtools::LIGHT_SPEED<> * sv_clk(1);
+    pred_[i].elevation = -std::asin((C_e_l * u)(2));
+    pred_[i].doppler = -range_rate / lambda;
+    pred_[i].valid = true;
+  }
+  has_fix_ = true;
+  generation_.fetch_add(1, std::memory_order_release);
+}
+
+// *=== HasFix ===*
+bool AcquisitionAiding::HasFix() const {
+  std::unique_lock<std::mutex> lock(mtx_);
+  return has_fix_;
+}
+
+// *=== Generation ===*
+uint32_t AcquisitionAiding::Generation() const {
+  return generation_.load(std::memory_order_acquire);
+}
+
+// *=== SearchOrder ===*
+std::vector<uint8_t> AcquisitionAiding::SearchOrder() const {
+  std::unique_lock<std::mutex> lock(mtx_);
+  std::vector<uint8_t> visible, unknown;
+  for (uint8_t prn = 1; prn <= N_PRN; prn++) {
+    const Prediction &p = pred_[prn - 1];
+    if (!has_fix_ || !p.valid) {
+      unknown.push_back(prn);
+    } else if (p.elevation >= elev_mask_) {
+      visible.push_back(prn);
+    }
+  }
+  std::stable_sort(visible.begin(), visible.end(), [this](const uint8_t &a, const uint8_t &b) {
+    return pred_[a - 1].elevation > pred_[b - 1].elevation;
+  });
+  visible.insert(visible.end(), unknown.begin(), unknown.end());
+  return visible;
+}
+
+// *=== Window ===*
+DopplerWindow AcquisitionAiding::Window(
+    const uint8_t &prn, const double &d_range, const double &d_step) const {
+  int n_bins = 2 * static_cast<int>(d_range / d_step) + 1;
+  std::unique_lock<std::mutex> lock(mtx_);
+  if (!has_fix_ || prn < 1 || prn > N_PRN || !pred_[prn - 1].valid) {
+    return DopplerWindow{0, n_bins};
+  }
+
+  // bins within 'n_sigma' of the prediction, at least the nearest one
+  int center = static_cast<int>(std::round((pred_[prn - 1].doppler + d_range) / d_step));
+  int half = static_cast<int>(std::ceil(n_sigma_ * dopp_sigma_ / d_step));
+  int first = std::clamp(center - half, 0, n_bins - 1);
+  int last = std::clamp(center + half, first, n_bins - 1);
+  return DopplerWindow{first, last - first + 1};
+}
+
+}  // namespace sturdr
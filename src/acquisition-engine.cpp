@@ -0,0 +1,91 @@
+/**
+ * *acquisition-engine.cpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/acquisition-engine.cpp
+ * @brief   Worker pool searching sample snapshots outside of the tracking barrier.
+ * @date    October 2026
+ * @ref     1. "Understanding GPS/GNSS Principles and Applications", 3rd Edition, 2017
+ *              - Kaplan & Hegarty
+ * =======  ========================================================================================
+ */
+
+#include "sturdr/acquisition-engine.hpp"
+
+#include <algorithm>
+#include <any>
+
+namespace sturdr {
+
+// *=== AcquisitionEngine ===*
+AcquisitionEngine::AcquisitionEngine(
+    std::shared_ptr<AcquisitionContext> ctx,
+    std::shared_ptr<AcquisitionContextF> ctx_f,
+    std::shared_ptr<AcquisitionWorkspacePool> pool,
+    std::shared_ptr<AcquisitionWorkspacePoolF> pool_f,
+    const uint8_t &c_per,
+    const uint8_t &nc_per,
+    const uint16_t &n_workers)
+    : ctx_{ctx}, ctx_f_{ctx_f}, pool_{pool}, pool_f_{pool_f}, c_per_{c_per}, nc_per_{nc_per} {
+  for (uint16_t i = 0; i < std::max<uint16_t>(n_workers, 1); i++) {
+    workers_.emplace_back(&AcquisitionEngine::Work, this);
+  }
+}
+
+// *=== ~AcquisitionEngine ===*
+AcquisitionEngine::~AcquisitionEngine() {
+  Stop();
+}
+
+// *=== Submit ===*
+std::shared_ptr<AcquisitionJob> AcquisitionEngine::Submit(
+    const SampleRing &rfdata,
+    const uint64_t &ptr,
+    const uint64_t &n_samp,
+    const std::vector<uint8_t> &prns,
+    const std::vector<DopplerWindow> &windows) {
+  auto job = std::make_shared<AcquisitionJob>();
+  job->ptr = ptr;
+  job->prns = prns;
+  job->windows = windows;
+  if (ctx_f_) {
+    job->data_f.resize(n_samp);
+    rfdata.Read(job->data_f.data(), 0, ptr, n_samp);
+  } else {
+    job->data.resize(n_samp);
+    rfdata.Read(job->data.data(), 0, ptr, n_samp);
+  }
+  queue_.push(job);
+  return job;
+}
+
+// *=== Stop ===*
+void AcquisitionEngine::Stop() {
+  queue_.clear();
+  queue_.NotifyComplete();
+  for (std::thread &w : workers_) {
+    if (w.joinable()) {
+      w.join();
+    }
+  }
+}
+
+// *=== Work ===*
+void AcquisitionEngine::Work() {
+  std::any item;
+  while (queue_.pop(item)) {
+    auto job = std::any_cast<std::shared_ptr<AcquisitionJob>>(item);
+    if (ctx_f_) {
+      std::shared_ptr<AcquisitionWorkspaceF> ws = pool_f_->Borrow();
+      job->results = PcpsSearchMany<float>(
+          *ctx_f_, *ws, job->data_f, job->prns, c_per_, nc_per_, job->windows);
+    } else {
+      std::shared_ptr<AcquisitionWorkspace> ws = pool_->Borrow();
+      job->results = PcpsSearchMany<double>(
+          *ctx_, *ws, job->data, job->prns, c_per_, nc_per_, job->windows);
+    }
+    job->done.store(true, std::memory_order_release);
+  }
+}
+
+}  // namespace sturdr
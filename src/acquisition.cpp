@@ -17,13 +17,19 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <exception>
 #include <iostream>
 #include <navtools/constants.hpp>
+#include <vector>
 
+#include "sturdr/carrier-nco.hpp"
+#include "sturdr/code-replica.hpp"
 #include "sturdr/fftw-wrapper.hpp"
 #include "sturdr/gnss-signal.hpp"
+#include "sturdr/peak-detector.hpp"
 
 namespace sturdr {
 
@@ -113,93 +119,687 @@ namespace sturdr {
 //   return corr_map;
 // }
 
-Eigen::MatrixXd PcpsSearch(
-    FftwWrapper &p,
-    const Eigen::VectorXcd &rfdata,
+namespace {
+
+// *=== DecimationFactor ===*
+// largest factor of the samples per code period keeping at least 'acq_freq', a smaller factor is
+// used when it makes the period 2, 3, 5, 7 smooth (faster transforms) within twice that rate
+uint64_t DecimationFactor(const double &samp_freq, const double &acq_freq) {
+  uint64_t n = static_cast<uint64_t>(samp_freq) / 1000;
+  if (acq_freq <= 0.0 || acq_freq >= samp_freq) {
+    return 1;
+  }
+  uint64_t best = 1;
+  for (uint64_t d = 1; d <= n; d++) {
+    if (n % d == 0 && samp_freq / static_cast<double>(d) >= acq_freq) {
+      best = d;
+    }
+  }
+  for (uint64_t d = best; d > 1 && best < 2 * d; d--) {
+    int m = static_cast<int>(n / d);
+    if (n % d == 0 && FftwWrapper::SmoothSize(m) == m) {
+      return d;
+    }
+  }
+  return best;
+}
+
+// *=== AcquisitionRate ===*
+// samples of a search at the acquisition rate, decimated into the workspace when needed
+template <typename Real>
+Eigen::Ref<const Eigen::VectorX<std::complex<Real>>> AcquisitionRate(
+    const BasicAcquisitionContext<Real> &ctx,
+    BasicAcquisitionWorkspace<Real> &ws,
+    const Eigen::Ref<const Eigen::VectorX<std::complex<Real>>> &rfdata) {
+  if (ctx.Decimation() == 1) {
+    return rfdata;
+  }
+  ctx.Decimate(rfdata, ws.dec_data);
+  return ws.dec_data;
+}
+
+// *=== WindowBins ===*
+// first bin and number of bins of 'window' within a grid of 'n_bins'
+void WindowBins(
+    const DopplerWindow &window, const uint64_t &n_bins, Eigen::Index &b0, Eigen::Index &nw) {
+  b0 = std::clamp<Eigen::Index>(window.first_bin, 0, n_bins - 1);
+  nw = static_cast<Eigen::Index>(n_bins) - b0;
+  if (window.num_bins >= 0) {
+    nw = std::clamp<Eigen::Index>(window.num_bins, 1, nw);
+  }
+}
+
+// *=== ParabolicOffset ===*
+// vertex of the parabola through three equally spaced powers, relative to the middle one [cells]
+double ParabolicOffset(const double &prev, const double &peak, const double &next) {
+  double curv = prev - 2.0 * peak + next;
+  if (curv >= 0.0) {
+    return 0.0;
+  }
+  return std::clamp(0.5 * (prev - next) / curv, -0.5, 0.5);
+}
+
+// *=== PcpsAccumulate ===*
+// coherent/non-coherent correlation loop shared by all searches. Per code period 'prepare' runs
+// the serial, PRN independent work, then 'spectra' fills a block of Doppler columns of 'x_carr'
+// with the code and carrier wiped spectra. Blocks are split across 'workers' (when given), each
+// block is inverse transformed, summed and squared on its own, so a search never allocates and
+// all Doppler columns run in parallel. With 'detect' the last non-coherent period is reduced to
+// per column statistics as it leaves the inverse transform, 'corr_map' is then only written when
+// 'keep_map' is set (or earlier periods still accumulate). Only the columns of 'window' are
+// searched, the others stay zero
+template <typename Real, typename PrepareFunc, typename SpectraFunc>
+void PcpsAccumulate(
+    BasicFftwWrapper<Real> &p,
+    BasicAcquisitionWorkspace<Real> &ws,
+    const Eigen::Ref<const Eigen::VectorX<std::complex<Real>>> &rfdata,
+    const uint64_t &n_samp,
+    const uint64_t &n_bins,
+    PrepareFunc &&prepare,
+    SpectraFunc &&spectra,
+    const uint8_t &c_per,
+    const uint8_t &nc_per,
+    WorkerPool *workers = nullptr,
+    const bool &detect = false,
+    const bool &keep_map = true,
+    const DopplerWindow &window = {}) {
+  using MatrixXc = Eigen::MatrixX<std::complex<Real>>;
+
+  // Allocate correlation results map
+  bool write_map = !detect || keep_map;
+  if (write_map || nc_per > 1) {
+    ws.corr_map.setZero(n_samp, n_bins);
+  }
+  if (c_per > 1) {
+    ws.coh_sum.resize(n_samp, n_bins);
+  }
+  ws.x_carr.resize(n_samp, n_bins);
+  ws.col_stats.resize(n_bins);
+  if (detect) {
+    ws.detector.Reset();
+  }
+
+  // a single coherent period is its own sum
+  const MatrixXc &coh = (c_per > 1) ? ws.coh_sum : ws.x_carr;
+  Real inv_n = static_cast<Real>(1.0 / static_cast<double>(n_samp));
+  Real inv_n2 = inv_n * inv_n;
+  Eigen::Index b0, nw;
+  WindowBins(window, n_bins, b0, nw);
+  int n_blocks = workers ? static_cast<int>(std::min<Eigen::Index>(workers->Size(), nw)) : 1;
+
+  // Loop through each non-coherent period
+  uint64_t i_per = 0;
+  for (uint8_t i_nc = 0; i_nc < nc_per; i_nc++) {
+    bool last_nc = (i_nc + 1 == nc_per);
+
+    // Loop through each coherent period
+    for (uint8_t j_c = 0; j_c < c_per; j_c++) {
+      auto x = rfdata.segment(i_per * n_samp, n_samp);
+      prepare(i_per, x);
+      if (detect) {
+        ws.detector.AddInputPower(static_cast<double>(x.squaredNorm()), n_samp);
+      }
+
+      auto block = [&](const int &k) {
+        Eigen::Index j0 = b0 + k * nw / n_blocks;
+        Eigen::Index nj = b0 + (k + 1) * nw / n_blocks - j0;
+
+        // Wiped carrier FFT times the code FFT
+        // x_carr = carr_up.array().rowwise() * rfdata.segment(i_sig, n_samp).array().transpose();
+        spectra(i_per, x, ws.x_carr, j0, nj);
+
+        // Combined Code-Wiped Carrier IFFT
+        // ExecuteManyFftPlan(p.ifft_many, x_carr, x_carr);
+        p.ExecuteColumns(ws.x_carr, j0, nj, false);
+
+        // coherent sum
+        if (c_per > 1) {
+          if (j_c == 0) {
+            ws.coh_sum.middleCols(j0, nj) = ws.x_carr.middleCols(j0, nj);
+          } else {
+            ws.coh_sum.middleCols(j0, nj) += ws.x_carr.middleCols(j0, nj);
+          }
+        }
+        if (j_c + 1 < c_per) {
+          return;
+        }
+
+        // sum power noncoherently
+        if (!detect || !last_nc) {
+          ws.corr_map.middleCols(j0, nj) += (coh.middleCols(j0, nj) * inv_n).cwiseAbs2();
+          return;
+        }
+
+        // last period, one pass per Doppler column for the final power, its peak, sum and sum
+        // of squares
+        for (Eigen::Index j = j0; j < j0 + nj; j++) {
+          const std::complex<Real> *c = coh.col(j).data();
+          Real *m = (write_map || nc_per > 1) ? ws.corr_map.col(j).data() : nullptr;
+          ColumnStats &st = ws.col_stats[j];
+          st = ColumnStats{0, -1.0, 0.0, 0.0};
+          for (uint64_t i = 0; i < n_samp; i++) {
+            Real v = std::norm(c[i]) * inv_n2;
+            if (nc_per > 1) {
+              v += m[i];
+            }
+            if (write_map) {
+              m[i] = v;
+            }
+            st.sum += v;
+            st.sum2 += static_cast<double>(v) * v;
+            if (v > st.peak) {
+              st.peak = v;
+              st.peak_samp = static_cast<int>(i);
+            }
+          }
+        }
+      };
+      if (workers && n_blocks > 1) {
+        workers->ParallelFor(n_blocks, block);
+      } else {
+        block(0);
+      }
+      i_per++;
+    }
+  }
+
+  // merge the column statistics in order, so the result does not depend on the split
+  if (detect) {
+    for (Eigen::Index j = b0; j < b0 + nw; j++) {
+      const ColumnStats &st = ws.col_stats[j];
+      ws.detector.AddColumn(static_cast<int>(j), st.peak_samp, st.peak, st.sum, st.sum2, n_samp);
+    }
+  }
+}
+
+// *=== FineEstimate ===*
+// fine acquisition stage, interpolates the detected peak between code phase samples (circularly)
+// and Doppler bins of the window from the powers PcpsAccumulate left in the workspace (the last
+// coherent sums plus the earlier non-coherent power, or the kept map). The refined peak is taken
+// to lie within a quarter cell, a peak on the window edge within half a bin
+template <typename Real>
+void FineEstimate(
+    const BasicAcquisitionContext<Real> &ctx,
+    const BasicAcquisitionWorkspace<Real> &ws,
+    const uint8_t &c_per,
+    const uint8_t &nc_per,
+    const bool &keep_map,
+    const DopplerWindow &window,
+    AcquisitionResult &result) {
+  const Eigen::Index n = static_cast<Eigen::Index>(ctx.PeriodSamples());
+  const Eigen::MatrixX<std::complex<Real>> &coh = (c_per > 1) ? ws.coh_sum : ws.x_carr;
+  double inv_n = 1.0 / static_cast<double>(n);
+  auto power = [&](const Eigen::Index &i, const Eigen::Index &j) {
+    if (keep_map) {
+      return static_cast<double>(ws.corr_map(i, j));
+    }
+    double v = std::norm(std::complex<double>(coh(i, j))) * inv_n * inv_n;
+    return (nc_per > 1) ? v + static_cast<double>(ws.corr_map(i, j)) : v;
+  };
+
+  Eigen::Index i = result.peak_idx[0];
+  Eigen::Index j = result.peak_idx[1];
+  Eigen::Index b0, nw;
+  WindowBins(window, static_cast<uint64_t>(ctx.DopplerBins().size()), b0, nw);
+  double peak = power(i, j);
+  double di = ParabolicOffset(power((i + n - 1) % n, j), peak, power((i + 1) % n, j));
+  double d = static_cast<double>(ctx.Decimation());
+  result.code_phase = (static_cast<double>(i) + di) * d;
+  result.code_var = d * d / 48.0;
+  if (j > b0 && j + 1 < b0 + nw) {
+    result.bin = static_cast<double>(j) + ParabolicOffset(power(i, j - 1), peak, power(i, j + 1));
+    result.bin_var = 1.0 / 48.0;
+  } else {
+    result.bin = static_cast<double>(j);
+    result.bin_var = 1.0 / 12.0;
+  }
+}
+
+// *=== PcpsSingle ===*
+// one PRN over the context, the residue spectra of the frequency domain search are computed once
+// per period before the Doppler columns are split, time domain bins are wiped and transformed
+// inside their column block
+template <typename Real>
+void PcpsSingle(
+    const BasicAcquisitionContext<Real> &ctx,
+    BasicAcquisitionWorkspace<Real> &ws,
+    const Eigen::Ref<const Eigen::VectorX<std::complex<Real>>> &rfdata,
+    const uint8_t &prn,
+    const uint8_t &c_per,
+    const uint8_t &nc_per,
+    const bool &detect,
+    const bool &keep_map,
+    const DopplerWindow &window = {}) {
+  using MatrixXc = Eigen::MatrixX<std::complex<Real>>;
+  bool freq_domain = ctx.FreqDomain();
+  PcpsAccumulate<Real>(
+      ctx.Plans(),
+      ws,
+      AcquisitionRate(ctx, ws, rfdata),
+      ctx.PeriodSamples(),
+      static_cast<uint64_t>(ctx.DopplerBins().size()),
+      [&](const uint64_t &, const auto &x) {
+        if (freq_domain) {
+          ctx.WipedSpectra(x, ws.spec, ws.fft_buf);
+        }
+      },
+      [&](const uint64_t &, const auto &x, MatrixXc &x_carr, const Eigen::Index &j0,
+          const Eigen::Index &nj) {
+        if (freq_domain) {
+          ctx.CodeWipe(ws.spec, prn, x_carr, j0, nj);
+        } else {
+          ctx.WipeCarrier(x, x_carr, j0, nj);
+          ctx.Plans().ExecuteColumns(x_carr, j0, nj, true);
+          ctx.CodeWipe(x_carr, prn, x_carr, j0, nj);
+        }
+      },
+      c_per,
+      nc_per,
+      ctx.Workers(),
+      detect,
+      keep_map,
+      window);
+}
+
+}  // namespace
+
+// *=== BasicAcquisitionContext ===*
+template <typename Real>
+BasicAcquisitionContext<Real>::BasicAcquisitionContext(
+    std::shared_ptr<BasicFftwWrapper<Real>> plans,
+    const double &samp_freq,
+    const double &code_freq,
+    const double &intmd_freq,
+    const double &d_range,
+    const double &d_step,
+    const bool &cache_carrier,
+    const bool &freq_domain,
+    const double &acq_freq)
+    : plans_{plans},
+      decim_{DecimationFactor(samp_freq, acq_freq)},
+      mix_freq_{decim_ > 1 ? intmd_freq : 0.0},
+      samp_freq_{samp_freq / static_cast<double>(decim_)},
+      n_samp_{static_cast<uint64_t>(samp_freq) / 1000 / decim_},
+      dopp_bins_{
+          Eigen::VectorXd::LinSpaced(
+              2 * static_cast<uint64_t>(d_range / d_step) + 1, -d_range, d_range)
+              .array() +
+          (intmd_freq - mix_freq_)},
+      freq_domain_{freq_domain} {
+  // plans of one searched period, created once before channels share them
+  int n = static_cast<int>(n_samp_);
+  int n_bins = static_cast<int>(dopp_bins_.size());
+  for (bool is_fft : {true, false}) {
+    plans_->Create1dFftPlan(n, is_fft);
+    plans_->CreateManyFftPlan(n, n_bins, is_fft, false);
+  }
+  for (uint8_t prn = 1; prn <= N_PRN; prn++) {
+    code_fft_[prn - 1] =
+        sturdr::CodeSpectrum<Real>(*plans_, GpsL1caReplica(prn).bits.data(), samp_freq_, code_freq);
+  }
+  if (!freq_domain_) {
+    if (cache_carrier) {
+      carr_rep_ = CarrierReplica<Real>(dopp_bins_, samp_freq_);
+    }
+    return;
+  }
+
+  // split every bin into whole fft bins and a residue, residues shared by several bins are
+  // transformed once
+  double fft_bin = samp_freq_ / static_cast<double>(n_samp_);
+  std::vector<double> residues;
+  bin_res_.resize(dopp_bins_.size());
+  bin_shift_.resize(dopp_bins_.size());
+  for (Eigen::Index j = 0; j < dopp_bins_.size(); j++) {
+    double k = std::round(dopp_bins_(j) / fft_bin);
+    double r = dopp_bins_(j) - k * fft_bin;
+    auto it = std::find_if(residues.begin(), residues.end(), [&](const double &x) {
+      return std::abs(x - r) < 1e-9 * fft_bin;
+    });
+    bin_res_[j] = std::distance(residues.begin(), it);
+    if (it == residues.end()) {
+      residues.push_back(r);
+    }
+    bin_shift_[j] = ((static_cast<Eigen::Index>(k) % n) + n) % n;
+  }
+  res_carr_ = CarrierReplica<Real>(
+      Eigen::Map<const Eigen::VectorXd>(residues.data(), residues.size()), samp_freq_);
+}
+
+// *=== SetWorkers ===*
+template <typename Real>
+void BasicAcquisitionContext<Real>::SetWorkers(std::shared_ptr<WorkerPool> workers) {
+  workers_ = workers;
+  if (workers_ && workers_->Size() > 1) {
+    int n_bins = static_cast<int>(dopp_bins_.size());
+    plans_->CreateColumnPlans(
+        static_cast<int>(n_samp_), n_bins, std::min(static_cast<int>(workers_->Size()), n_bins));
+  }
+}
+
+// *=== Decimate ===*
+template <typename Real>
+void BasicAcquisitionContext<Real>::Decimate(
+    const Eigen::Ref<const VectorXc> &rfdata, VectorXc &out) const {
+  Eigen::Index n_out = rfdata.size() / static_cast<Eigen::Index>(decim_);
+  out.resize(n_out);
+
+  // the mixing carrier is generated a chunk at a time (phase continuous) and every 'decim_' mixed
+  // samples are summed into one output
+  std::array<std::complex<double>, 512> carr;
+  CarrierNco nco(CarrierNcoMode::ROTATOR);
+  double phase = 0.0;
+  double d_phase = navtools::TWO_PI<> * mix_freq_ / (samp_freq_ * static_cast<double>(decim_));
+  std::complex<Real> acc = 0.0;
+  uint64_t m = 0;
+  Eigen::Index k = 0;
+  Eigen::Index n_in = n_out * static_cast<Eigen::Index>(decim_);
+  for (Eigen::Index i0 = 0; i0 < n_in; i0 += carr.size()) {
+    uint64_t nc = std::min<uint64_t>(carr.size(), n_in - i0);
+    nco.Generate(carr.data(), nc, phase, d_phase);
+    for (uint64_t i = 0; i < nc; i++) {
+      acc += rfdata(i0 + i) * static_cast<std::complex<Real>>(carr[i]);
+      if (++m == decim_) {
+        out(k++) = acc;
+        acc = 0.0;
+        m = 0;
+      }
+    }
+  }
+}
+
+// *=== WipeCarrier ===*
+template <typename Real>
+void BasicAcquisitionContext<Real>::WipeCarrier(
+    const Eigen::Ref<const VectorXc> &rfdata,
+    MatrixXc &x_carr,
+    const Eigen::Index &col,
+    const Eigen::Index &ncol) const {
+  Eigen::Index n_bins = dopp_bins_.size();
+  Eigen::Index nj = (ncol < 0) ? n_bins : ncol;
+  if (ncol < 0) {
+    x_carr.resize(n_samp_, n_bins);
+  }
+  if (CachesCarrier()) {
+    x_carr.middleCols(col, nj) = carr_rep_.middleCols(col, nj).array().colwise() * rfdata.array();
+    return;
+  }
+
+  // low-memory mode, one bin at a time from a re-anchored phasor recurrence generated a chunk at a
+  // time (phase continuous) on the stack, blocks of the same workspace run on several threads
+  std::array<std::complex<double>, 512> carr;
+  CarrierNco nco(CarrierNcoMode::ROTATOR);
+  for (Eigen::Index j = col; j < col + nj; j++) {
+    double phase = 0.0;
+    double d_phase = navtools::TWO_PI<> * dopp_bins_(j) / samp_freq_;
+    for (uint64_t i0 = 0; i0 < n_samp_; i0 += carr.size()) {
+      uint64_t nc = std::min<uint64_t>(carr.size(), n_samp_ - i0);
+      nco.Generate(carr.data(), nc, phase, d_phase);
+      for (uint64_t i = 0; i < nc; i++) {
+        x_carr(i0 + i, j) = rfdata(i0 + i) * static_cast<std::complex<Real>>(carr[i]);
+      }
+    }
+  }
+}
+
+// *=== WipedSpectra ===*
+template <typename Real>
+void BasicAcquisitionContext<Real>::WipedSpectra(
+    const Eigen::Ref<const VectorXc> &rfdata, MatrixXc &spec, VectorXc &buf) const {
+  if (!freq_domain_) {
+    WipeCarrier(rfdata, spec);
+    plans_->ExecuteFftPlan(spec, spec, true, true);
+    return;
+  }
+
+  // one forward transform per residue of the Doppler grid (through an aligned vector, matrix
+  // columns of single precision data may not match the alignment of the 1d plan)
+  Eigen::Index n_res = res_carr_.cols();
+  buf.resize(n_samp_);
+  spec.resize(n_samp_, n_res);
+  for (Eigen::Index r = 0; r < n_res; r++) {
+    buf = res_carr_.col(r).cwiseProduct(rfdata);
+    plans_->ExecuteFftPlan(buf, buf, true, false);
+    spec.col(r) = buf;
+  }
+}
+
+// *=== CodeWipe ===*
+template <typename Real>
+void BasicAcquisitionContext<Real>::CodeWipe(
+    const MatrixXc &spec,
+    const uint8_t &prn,
+    MatrixXc &x_carr,
+    const Eigen::Index &col,
+    const Eigen::Index &ncol) const {
+  const VectorXc &code_fft = code_fft_[prn - 1];
+  Eigen::Index n = static_cast<Eigen::Index>(n_samp_);
+  Eigen::Index nj = (ncol < 0) ? dopp_bins_.size() : ncol;
+  if (ncol < 0) {
+    x_carr.resize(n, dopp_bins_.size());
+  }
+  if (!freq_domain_) {
+    x_carr.middleCols(col, nj) = spec.middleCols(col, nj).array().colwise() * code_fft.array();
+    return;
+  }
+
+  // each bin rotates its residue spectrum by whole fft bins (the rotation of CircShift, fused with
+  // the code product so no shifted copy is made)
+  for (Eigen::Index j = col; j < col + nj; j++) {
+    auto x = spec.col(bin_res_[j]);
+    Eigen::Index k = bin_shift_[j];
+    x_carr.col(j).head(n - k) = x.tail(n - k).cwiseProduct(code_fft.head(n - k));
+    x_carr.col(j).tail(k) = x.head(k).cwiseProduct(code_fft.tail(k));
+  }
+}
+
+// *=== CodeSpectrum ===*
+template <typename Real>
+Eigen::VectorX<std::complex<Real>> CodeSpectrum(
+    BasicFftwWrapper<Real> &p,
     const bool code[1023],
+    const double &samp_freq,
+    const double &code_freq) {
+  uint64_t n_samp = static_cast<uint64_t>(samp_freq) / 1000;
+  double rem_phase = 0.0;
+  Eigen::VectorX<std::complex<Real>> code_up =
+      CodeNCO(code, code_freq, samp_freq, rem_phase, n_samp).template cast<std::complex<Real>>();
+  p.ExecuteFftPlan(code_up, code_up, true, false);
+  return code_up.conjugate() / static_cast<Real>(n_samp);
+}
+
+// *=== CarrierReplica ===*
+template <typename Real>
+Eigen::MatrixX<std::complex<Real>> CarrierReplica(
+    const Eigen::VectorXd &dopp_bins, const double &samp_freq) {
+  uint64_t n_samp = static_cast<uint64_t>(samp_freq) / 1000;
+  Eigen::VectorXd phases =
+      Eigen::VectorXd::LinSpaced(n_samp, 0.0, static_cast<double>(n_samp - 1)) *
+      (navtools::TWO_PI<> / samp_freq);
+  // Eigen::MatrixXcd carr_up = -navtools::COMPLEX_I<> * (dopp_bins * phases.transpose());
+  return (-navtools::COMPLEX_I<> * (phases * dopp_bins.transpose()))
+      .array()
+      .exp()
+      .template cast<std::complex<Real>>();
+}
+
+// *=== PcpsSearch ===*
+template <typename Real>
+Eigen::MatrixX<Real> PcpsSearch(
+    BasicFftwWrapper<Real> &p,
+    const Eigen::Ref<const Eigen::VectorX<std::complex<Real>>> &rfdata,
+    const Eigen::Ref<const Eigen::VectorX<std::complex<Real>>> &code_fft,
     const double &d_range,
     const double &d_step,
     const double &samp_freq,
-    const double &code_freq,
     const double &intmd_freq,
     const uint8_t &c_per,
     const uint8_t &nc_per) {
+  using MatrixXc = Eigen::MatrixX<std::complex<Real>>;
   try {
     // Doppler bins
     uint64_t n_bins = 2 * static_cast<uint64_t>(d_range / d_step) + 1;
     Eigen::VectorXd dopp_bins =
         Eigen::VectorXd::LinSpaced(n_bins, -d_range, d_range).array() + intmd_freq;
 
-    // Initialize code replica
+    // code replica spectrum is precomputed (one code period)
     uint64_t n_samp = static_cast<uint64_t>(samp_freq) / 1000;
-    double rem_phase = 0.0;
-    Eigen::VectorXcd code_up = CodeNCO(code, code_freq, samp_freq, rem_phase, n_samp);
-    // ExecuteFftPlan(p.fft, code_up, code_up);
-    p.ExecuteFftPlan(code_up, code_up, true, false);
-    code_up = code_up.conjugate() / static_cast<double>(n_samp);
 
     // initialize carrier replica
-    Eigen::VectorXd phases =
-        Eigen::VectorXd::LinSpaced(n_samp, 0.0, static_cast<double>(n_samp - 1)) *
-        (navtools::TWO_PI<> / samp_freq);
-    // Eigen::MatrixXcd carr_up = -navtools::COMPLEX_I<> * (dopp_bins * phases.transpose());
-    Eigen::MatrixXcd carr_up =
-        (-navtools::COMPLEX_I<> * (phases * dopp_bins.transpose())).array().exp();
-
-    // Allocate correlation results map
-    // Eigen::MatrixXd corr_map = Eigen::MatrixXd::Zero(n_bins, n_samp);
-    // Eigen::MatrixXcd coh_sum = Eigen::MatrixXcd::Zero(n_bins, n_samp);
-    // Eigen::MatrixXcd x_carr = Eigen::MatrixXcd::Zero(n_bins, n_samp);
-    Eigen::MatrixXd corr_map = Eigen::MatrixXd::Zero(n_samp, n_bins);
-    Eigen::MatrixXcd coh_sum = Eigen::MatrixXcd::Zero(n_samp, n_bins);
-    Eigen::MatrixXcd x_carr = Eigen::MatrixXcd::Zero(n_samp, n_bins);
-
-    // Loop through each non-coherent period
-    uint64_t i_sig = 0;
-    for (uint8_t i_nc = 0; i_nc < nc_per; i_nc++) {
-      // coh_sum = Eigen::MatrixXcd::Zero(n_bins, n_samp);
-      coh_sum = Eigen::MatrixXcd::Zero(n_samp, n_bins);
-
-      // Loop through each coherent period
-      for (uint8_t j_c = 0; j_c < c_per; j_c++) {
-        // Wiped carrier FFT
-        // x_carr = carr_up.array().rowwise() * rfdata.segment(i_sig, n_samp).array().transpose();
-        x_carr = carr_up.array().colwise() * rfdata.segment(i_sig, n_samp).array();
-        // ExecuteManyFftPlan(p.fft_many, x_carr, x_carr);
-        p.ExecuteFftPlan(x_carr, x_carr, true, true);
+    MatrixXc carr_up = CarrierReplica<Real>(dopp_bins, samp_freq);
+
+    BasicAcquisitionWorkspace<Real> ws(n_samp, n_bins, 0, c_per, nc_per);
+    PcpsAccumulate<Real>(
+        p,
+        ws,
+        rfdata,
+        n_samp,
+        n_bins,
+        [](const uint64_t &, const auto &) {},
+        [&](const uint64_t &, const auto &x, MatrixXc &x_carr, const Eigen::Index &j0,
+            const Eigen::Index &nj) {
+          x_carr.middleCols(j0, nj) = carr_up.middleCols(j0, nj).array().colwise() * x.array();
+          // ExecuteManyFftPlan(p.fft_many, x_carr, x_carr);
+          p.ExecuteColumns(x_carr, j0, nj, true);
+          // x_carr = x_carr.array().rowwise() * code_up.array().transpose();
+          x_carr.middleCols(j0, nj).array().colwise() *= code_fft.array();
+        },
+        c_per,
+        nc_per);
+    return std::move(ws.corr_map);
+  } catch (std::exception &e) {
+    spdlog::get("sturdr-console")
+        ->error("acquisition.cpp PcpsSearch failed! Error -> {}", e.what());
+    Eigen::MatrixX<Real> tmp;
+    return tmp;
+  }
+}
 
-        // Combined Code-Wiped Carrier IFFT
-        // x_carr = x_carr.array().rowwise() * code_up.array().transpose();
-        x_carr = x_carr.array().colwise() * code_up.array();
-        // ExecuteManyFftPlan(p.ifft_many, x_carr, x_carr);
-        p.ExecuteFftPlan(x_carr, x_carr, false, true);
+template <typename Real>
+const Eigen::MatrixX<Real> &PcpsSearch(
+    const BasicAcquisitionContext<Real> &ctx,
+    BasicAcquisitionWorkspace<Real> &ws,
+    const Eigen::Ref<const Eigen::VectorX<std::complex<Real>>> &rfdata,
+    const uint8_t &prn,
+    const uint8_t &c_per,
+    const uint8_t &nc_per) {
+  try {
+    PcpsSingle(ctx, ws, rfdata, prn, c_per, nc_per, false, true);
+  } catch (std::exception &e) {
+    spdlog::get("sturdr-console")
+        ->error("acquisition.cpp PcpsSearch failed! Error -> {}", e.what());
+    ws.corr_map.setZero();
+  }
+  return ws.corr_map;
+}
 
-        // coherent sum
-        coh_sum += x_carr;  // x_carr.array() / n ??
-        i_sig += n_samp;
-      }
+// *=== PcpsDetect ===*
+template <typename Real>
+AcquisitionResult PcpsDetect(
+    const BasicAcquisitionContext<Real> &ctx,
+    BasicAcquisitionWorkspace<Real> &ws,
+    const Eigen::Ref<const Eigen::VectorX<std::complex<Real>>> &rfdata,
+    const uint8_t &prn,
+    const uint8_t &c_per,
+    const uint8_t &nc_per,
+    const bool &keep_map,
+    const DopplerWindow &window) {
+  AcquisitionResult result{prn, {0, 0}, 0.0};
+  try {
+    PcpsSingle(ctx, ws, rfdata, prn, c_per, nc_per, true, keep_map, window);
+    result.metric = ws.detector.Metric(result.peak_idx);
+    FineEstimate(ctx, ws, c_per, nc_per, keep_map, window, result);
+    result.peak_idx[0] = ctx.FullRateSample(result.peak_idx[0]);
+  } catch (std::exception &e) {
+    spdlog::get("sturdr-console")
+        ->error("acquisition.cpp PcpsDetect failed! Error -> {}", e.what());
+  }
+  return result;
+}
+
+// *=== PcpsSearchMany ===*
+template <typename Real>
+std::vector<AcquisitionResult> PcpsSearchMany(
+    const BasicAcquisitionContext<Real> &ctx,
+    BasicAcquisitionWorkspace<Real> &ws,
+    const Eigen::Ref<const Eigen::VectorX<std::complex<Real>>> &rfdata,
+    const std::vector<uint8_t> &prns,
+    const uint8_t &c_per,
+    const uint8_t &nc_per,
+    const std::vector<DopplerWindow> &windows) {
+  using MatrixXc = Eigen::MatrixX<std::complex<Real>>;
+  std::vector<AcquisitionResult> results(prns.size());
+  try {
+    // PRN independent spectra of every period, computed once
+    auto x = AcquisitionRate(ctx, ws, rfdata);
+    uint64_t n_samp = ctx.PeriodSamples();
+    uint64_t n_per = static_cast<uint64_t>(c_per) * static_cast<uint64_t>(nc_per);
+    ws.period_spec.resize(n_per);
+    for (uint64_t i = 0; i < n_per; i++) {
+      ctx.WipedSpectra(x.segment(i * n_samp, n_samp), ws.period_spec[i], ws.fft_buf);
+    }
 
-      // sum power noncoherently
-      corr_map += (coh_sum / n_samp).cwiseAbs2();
+    // code wipe and inverse transforms per PRN, each map is reduced by the detector without being
+    // stored
+    for (std::size_t k = 0; k < prns.size(); k++) {
+      DopplerWindow window = k < windows.size() ? windows[k] : DopplerWindow{};
+      PcpsAccumulate<Real>(
+          ctx.Plans(),
+          ws,
+          x,
+          n_samp,
+          static_cast<uint64_t>(ctx.DopplerBins().size()),
+          [](const uint64_t &, const auto &) {},
+          [&](const uint64_t &i_per, const auto &, MatrixXc &x_carr, const Eigen::Index &j0,
+              const Eigen::Index &nj) {
+            ctx.CodeWipe(ws.period_spec[i_per], prns[k], x_carr, j0, nj);
+          },
+          c_per,
+          nc_per,
+          ctx.Workers(),
+          true,
+          false,
+          window);
+      results[k].prn = prns[k];
+      results[k].metric = ws.detector.Metric(results[k].peak_idx);
+      FineEstimate(ctx, ws, c_per, nc_per, false, window, results[k]);
+      results[k].peak_idx[0] = ctx.FullRateSample(results[k].peak_idx[0]);
     }
-    return corr_map;
   } catch (std::exception &e) {
     spdlog::get("sturdr-console")
-        ->error("acquisition.cpp PcpsSearch failed! Error -> {}", e.what());
-    Eigen::VectorXd tmp;
-    return tmp;
+        ->error("acquisition.cpp PcpsSearchMany failed! Error -> {}", e.what());
   }
+  return results;
+}
+
+// *=== AdvanceCodePhase ===*
+void AdvanceCodePhase(
+    AcquisitionResult &result,
+    const double &doppler,
+    const double &carr_freq,
+    const uint64_t &elapsed,
+    const uint64_t &n_samp) {
+  // the integer peak moves by the rounded drift and both wrap together, so the sub-sample offset
+  // between them only changes by the rounding
+  double drift = -static_cast<double>(elapsed) * doppler / carr_freq;
+  int n = static_cast<int>(n_samp);
+  int shift = static_cast<int>(std::lround(drift));
+  int peak = ((result.peak_idx[0] + shift) % n + n) % n;
+  result.code_phase += drift + static_cast<double>(peak - result.peak_idx[0] - shift);
+  result.peak_idx[0] = peak;
 }
 
 // *=== Peak2NoiseFloorTest ===*
-void Peak2NoiseFloorTest(const Eigen::MatrixXd &corr_map, int peak_idx[2], double &metric) {
+template <typename Real>
+void Peak2NoiseFloorTest(const Eigen::MatrixX<Real> &corr_map, int peak_idx[2], double &metric) {
   try {
     // find the highest correlation peak
-    double peak = corr_map.maxCoeff(&peak_idx[0], &peak_idx[1]);
+    double peak = static_cast<double>(corr_map.maxCoeff(&peak_idx[0], &peak_idx[1]));
 
-    // calculate mean and covariance
-    double mu = corr_map.mean();
-    double sigma = std::sqrt((corr_map.array() - mu).square().sum() / (corr_map.size() - 1));
+    // calculate mean and covariance (summed in double so single precision maps stay accurate)
+    auto map = corr_map.template cast<double>().array();
+    double mu = map.mean();
+    double sigma = std::sqrt((map - mu).square().sum() / (corr_map.size() - 1));
 
     // One pass approximation
     // double peak = 0.0;
@@ -248,4 +848,84 @@ void GlrtTest(
   metric = 2.0 * S * K / Phat;
 }
 
+// Explicit instantiation of the double and single precision searches
+template class BasicAcquisitionContext<double>;
+template class BasicAcquisitionContext<float>;
+template Eigen::VectorXcd CodeSpectrum<double>(
+    FftwWrapper &, const bool[1023], const double &, const double &);
+template Eigen::VectorXcf CodeSpectrum<float>(
+    FftwWrapperF &, const bool[1023], const double &, const double &);
+template Eigen::MatrixXcd CarrierReplica<double>(const Eigen::VectorXd &, const double &);
+template Eigen::MatrixXcf CarrierReplica<float>(const Eigen::VectorXd &, const double &);
+template Eigen::MatrixXd PcpsSearch<double>(
+    FftwWrapper &,
+    const Eigen::Ref<const Eigen::VectorXcd> &,
+    const Eigen::Ref<const Eigen::VectorXcd> &,
+    const double &,
+    const double &,
+    const double &,
+    const double &,
+    const uint8_t &,
+    const uint8_t &);
+template Eigen::MatrixXf PcpsSearch<float>(
+    FftwWrapperF &,
+    const Eigen::Ref<const Eigen::VectorXcf> &,
+    const Eigen::Ref<const Eigen::VectorXcf> &,
+    const double &,
+    const double &,
+    const double &,
+    const double &,
+    const uint8_t &,
+    const uint8_t &);
+template const Eigen::MatrixXd &PcpsSearch<double>(
+    const AcquisitionContext &,
+    AcquisitionWorkspace &,
+    const Eigen::Ref<const Eigen::VectorXcd> &,
+    const uint8_t &,
+    const uint8_t &,
+    const uint8_t &);
+template const Eigen::MatrixXf &PcpsSearch<float>(
+    const AcquisitionContextF &,
+    AcquisitionWorkspaceF &,
+    const Eigen::Ref<const Eigen::VectorXcf> &,
+    const uint8_t &,
+    const uint8_t &,
+    const uint8_t &);
+template AcquisitionResult PcpsDetect<double>(
+    const AcquisitionContext &,
+    AcquisitionWorkspace &,
+    const Eigen::Ref<const Eigen::VectorXcd> &,
+    const uint8_t &,
+    const uint8_t &,
+    const uint8_t &,
+    const bool &,
+    const DopplerWindow &);
+template AcquisitionResult PcpsDetect<float>(
+    const AcquisitionContextF &,
+    AcquisitionWorkspaceF &,
+    const Eigen::Ref<const Eigen::VectorXcf> &,
+    const uint8_t &,
+    const uint8_t &,
+    const uint8_t &,
+    const bool &,
+    const DopplerWindow &);
+template std::vector<AcquisitionResult> PcpsSearchMany<double>(
+    const AcquisitionContext &,
+    AcquisitionWorkspace &,
+    const Eigen::Ref<const Eigen::VectorXcd> &,
+    const std::vector<uint8_t> &,
+    const uint8_t &,
+    const uint8_t &,
+    const std::vector<DopplerWindow> &);
+template std::vector<AcquisitionResult> PcpsSearchMany<float>(
+    const AcquisitionContextF &,
+    AcquisitionWorkspaceF &,
+    const Eigen::Ref<const Eigen::VectorXcf> &,
+    const std::vector<uint8_t> &,
+    const uint8_t &,
+    const uint8_t &,
+    const std::vector<DopplerWindow> &);
+template void Peak2NoiseFloorTest<double>(const Eigen::MatrixXd &, int[2], double &);
+template void Peak2NoiseFloorTest<float>(const Eigen::MatrixXf &, int[2], double &);
+
 }  // end namespace sturdr
\ No newline at end of file
@@ -0,0 +1,488 @@
+/**
+ * *array-correlator.cpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/array-correlator.cpp
+ * @brief   Antenna-parallel early/prompt/late correlators on antenna-interleaved sample blocks.
+ * @date    October 2026
+ * @ref     1. "Intel 64 and IA-32 Architectures Optimization Reference Manual", 2023 - Intel
+ *          2. "Understanding GPS/GNSS Principles and Applications", 3rd Edition, 2017
+ *              - Kaplan & Hegarty
+ * =======  ========================================================================================
+ */
+
+#include "sturdr/array-correlator.hpp"
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include "sturdr/code-replica.hpp"
+#include "sturdr/simd-correlator.hpp"
+
+#ifdef STURDR_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace sturdr {
+
+namespace {
+
+// number of samples per carrier and code replica block
+constexpr int REPLICA_BLOCK = 512;
+
+// *=== Interleave ===*
+// transposes 'n' samples of every antenna column into sample-major re/im planes
+template <int N, typename T>
+void Interleave(
+    const T *const rfdata[],
+    const int &n_ant,
+    const uint64_t &k0,
+    const int &n,
+    double *xr,
+    double *xi) {
+  const int stride = (N > 0) ? N : n_ant;
+  for (int a = 0; a < stride; a++) {
+    const T *x = rfdata[a] + k0;
+    for (int k = 0; k < n; k++) {
+      if constexpr (std::is_arithmetic_v<T>) {
+        xr[k * stride + a] = static_cast<double>(x[k]);
+        xi[k * stride + a] = 0.0;
+      } else {
+        xr[k * stride + a] = static_cast<double>(x[k].real());
+        xi[k * stride + a] = static_cast<double>(x[k].imag());
+      }
+    }
+  }
+}
+
+// *=== MacGeneric ===*
+// any number of antennas, one antenna at a time, acc = 6 rows {IE, QE, IP, QP, IL, QL} of 'n_ant'
+void MacGeneric(
+    const double *xr,
+    const double *xi,
+    const double *cr,
+    const double *ci,
+    const double *ce,
+    const double *cp,
+    const double *cl,
+    const int &n,
+    const int &n_ant,
+    double *acc) {
+  for (int a = 0; a < n_ant; a++) {
+    double sum[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    for (int k = 0; k < n; k++) {
+      double x_re = xr[k * n_ant + a], x_im = xi[k * n_ant + a];
+      double wr = cr[k] * x_re - ci[k] * x_im;
+      double wi = cr[k] * x_im + ci[k] * x_re;
+      sum[0] += ce[k] * wr;
+      sum[1] += ce[k] * wi;
+      sum[2] += cp[k] * wr;
+      sum[3] += cp[k] * wi;
+      sum[4] += cl[k] * wr;
+      sum[5] += cl[k] * wi;
+    }
+    for (int j = 0; j < 6; j++) {
+      acc[j * n_ant + a] += sum[j];
+    }
+  }
+}
+
+#ifdef STURDR_SIMD_X86
+
+// *=== Avx2Expand ===*
+// repeats each per-sample value across its 'N' antenna lanes (4 / N samples per register)
+template <int N>
+__attribute__((target("avx2,fma"))) inline __m256d Avx2Expand(const double *v) {
+  if constexpr (N == 2) {
+    return _mm256_permute4x64_pd(_mm256_castpd128_pd256(_mm_loadu_pd(v)), 0x50);
+  } else {
+    return _mm256_broadcast_sd(v);
+  }
+}
+
+// *=== MacAvx2 ===*
+// 'N' = 2, 4 or 8 antennas, one register holds 4 (sample, antenna) values of the re/im planes
+template <int N>
+__attribute__((target("avx2,fma"))) void MacAvx2(
+    const double *xr,
+    const double *xi,
+    const double *cr,
+    const double *ci,
+    const double *ce,
+    const double *cp,
+    const double *cl,
+    const int &n,
+    double *acc) {
+  constexpr int S = (N < 4) ? 4 / N : 1;  // samples per register
+  constexpr int G = (N > 4) ? N / 4 : 1;  // registers per sample
+  __m256d sum[6][G];
+  for (int j = 0; j < 6; j++) {
+    for (int g = 0; g < G; g++) {
+      sum[j][g] = _mm256_setzero_pd();
+    }
+  }
+
+  int k = 0;
+  for (; k + S <= n; k += S) {
+    __m256d v_cr = Avx2Expand<N>(cr + k), v_ci = Avx2Expand<N>(ci + k);
+    __m256d v_ce = Avx2Expand<N>(ce + k), v_cp = Avx2Expand<N>(cp + k);
+    __m256d v_cl = Avx2Expand<N>(cl + k);
+    for (int g = 0; g < G; g++) {
+      __m256d x_re = _mm256_load_pd(xr + k * N + 4 * g);
+      __m256d x_im = _mm256_load_pd(xi + k * N + 4 * g);
+      __m256d wr = _mm256_fmsub_pd(v_cr, x_re, _mm256_mul_pd(v_ci, x_im));
+      __m256d wi = _mm256_fmadd_pd(v_cr, x_im, _mm256_mul_pd(v_ci, x_re));
+      sum[0][g] = _mm256_fmadd_pd(v_ce, wr, sum[0][g]);
+      sum[1][g] = _mm256_fmadd_pd(v_ce, wi, sum[1][g]);
+      sum[2][g] = _mm256_fmadd_pd(v_cp, wr, sum[2][g]);
+      sum[3][g] = _mm256_fmadd_pd(v_cp, wi, sum[3][g]);
+      sum[4][g] = _mm256_fmadd_pd(v_cl, wr, sum[4][g]);
+      sum[5][g] = _mm256_fmadd_pd(v_cl, wi, sum[5][g]);
+    }
+  }
+
+  // lane l of register g belongs to antenna (4*g + l) % N
+  alignas(32) double tmp[4];
+  for (int j = 0; j < 6; j++) {
+    for (int g = 0; g < G; g++) {
+      _mm256_store_pd(tmp, sum[j][g]);
+      for (int l = 0; l < 4; l++) {
+        acc[j * N + (4 * g + l) % N] += tmp[l];
+      }
+    }
+  }
+
+  // remaining samples
+  MacGeneric(xr + k * N, xi + k * N, cr + k, ci + k, ce + k, cp + k, cl + k, n - k, N, acc);
+}
+
+// *=== Avx512Expand ===*
+// repeats each per-sample value across its 'N' antenna lanes (8 / N samples per register)
+template <int N>
+__attribute__((target("avx512f"))) inline __m512d Avx512Expand(const double *v) {
+  if constexpr (N == 2) {
+    const __m512i idx = _mm512_set_epi64(3, 3, 2, 2, 1, 1, 0, 0);
+    return _mm512_permutexvar_pd(idx, _mm512_castpd256_pd512(_mm256_loadu_pd(v)));
+  } else if constexpr (N == 4) {
+    const __m512i idx = _mm512_set_epi64(1, 1, 1, 1, 0, 0, 0, 0);
+    return _mm512_permutexvar_pd(idx, _mm512_castpd128_pd512(_mm_loadu_pd(v)));
+  } else {
+    return _mm512_set1_pd(*v);
+  }
+}
+
+// *=== MacAvx512 ===*
+// 'N' = 2, 4 or 8 antennas, one register holds 8 (sample, antenna) values of the re/im planes
+template <int N>
+__attribute__((target("avx512f"))) void MacAvx512(
+    const double *xr,
+    const double *xi,
+    const double *cr,
+    const double *ci,
+    const double *ce,
+    const double *cp,
+    const double *cl,
+    const int &n,
+    double *acc) {
+  constexpr int S = 8 / N;  // samples per register
+  __m512d sum[6];
+  for (int j = 0; j < 6; j++) {
+    sum[j] = _mm512_setzero_pd();
+  }
+
+  int k = 0;
+  for (; k + S <= n; k += S) {
+    __m512d v_cr = Avx512Expand<N>(cr + k), v_ci = Avx512Expand<N>(ci + k);
+    __m512d x_re = _mm512_load_pd(xr + k * N);
+    __m512d x_im = _mm512_load_pd(xi + k * N);
+    __m512d wr = _mm512_fmsub_pd(v_cr, x_re, _mm512_mul_pd(v_ci, x_im));
+    __m512d wi = _mm512_fmadd_pd(v_cr, x_im, _mm512_mul_pd(v_ci, x_re));
+    __m512d v_ce = Avx512Expand<N>(ce + k);
+    sum[0] = _mm512_fmadd_pd(v_ce, wr, sum[0]);
+    sum[1] = _mm512_fmadd_pd(v_ce, wi, sum[1]);
+    __m512d v_cp = Avx512Expand<N>(cp + k);
+    sum[2] = _mm512_fmadd_pd(v_cp, wr, sum[2]);
+    sum[3] = _mm512_fmadd_pd(v_cp, wi, sum[3]);
+    __m512d v_cl = Avx512Expand<N>(cl + k);
+    sum[4] = _mm512_fmadd_pd(v_cl, wr, sum[4]);
+    sum[5] = _mm512_fmadd_pd(v_cl, wi, sum[5]);
+  }
+
+  // lane l belongs to antenna l % N
+  alignas(64) double tmp[8];
+  for (int j = 0; j < 6; j++) {
+    _mm512_store_pd(tmp, sum[j]);
+    for (int l = 0; l < 8; l++) {
+      acc[j * N + l % N] += tmp[l];
+    }
+  }
+
+  // remaining samples
+  MacGeneric(xr + k * N, xi + k * N, cr + k, ci + k, ce + k, cp + k, cl + k, n - k, N, acc);
+}
+
+#endif
+
+// *=== Mac ===*
+// routes a sub-block to the kernel of the requested SIMD level ('N' = 0 for any 'n_ant')
+template <int N>
+void Mac(
+    const SimdLevel::SimdLevel &level,
+    const double *xr,
+    const double *xi,
+    const double *cr,
+    const double *ci,
+    const double *ce,
+    const double *cp,
+    const double *cl,
+    const int &n,
+    const int &n_ant,
+    double *acc) {
+#ifdef STURDR_SIMD_X86
+  if constexpr (N > 0) {
+    if (level >= SimdLevel::AVX512) {
+      MacAvx512<N>(xr, xi, cr, ci, ce, cp, cl, n, acc);
+      return;
+    } else if (level >= SimdLevel::AVX2) {
+      MacAvx2<N>(xr, xi, cr, ci, ce, cp, cl, n, acc);
+      return;
+    }
+  }
+#endif
+  MacGeneric(xr, xi, cr, ci, ce, cp, cl, n, n_ant, acc);
+}
+
+// *=== AccumulateBlocks ===*
+// 'N' antennas known at compile time (2, 4 or 8), or N = 0 for any 'n_ant'
+template <int N, typename T>
+void AccumulateBlocks(
+    CarrierNco &nco,
+    const T *const rfdata[],
+    const int &n_ant,
+    const uint64_t &n_samp,
+    const double *code,
+    double &rem_code_phase,
+    const double &d_code,
+    double &rem_carr_phase,
+    const double &d_carr,
+    const uint64_t &n_first_half,
+    const double &t_space,
+    std::complex<double> *E,
+    std::complex<double> *P1,
+    std::complex<double> *P2,
+    std::complex<double> *L) {
+  SimdLevel::SimdLevel level = GetSimdLevel();
+  alignas(64) double xr[ARRAY_BLOCK_VALUES];
+  alignas(64) double xi[ARRAY_BLOCK_VALUES];
+  alignas(64) std::complex<double> carr[REPLICA_BLOCK];
+  alignas(64) double cr[REPLICA_BLOCK];
+  alignas(64) double ci[REPLICA_BLOCK];
+  alignas(64) double ce[REPLICA_BLOCK];
+  alignas(64) double cp[REPLICA_BLOCK];
+  alignas(64) double cl[REPLICA_BLOCK];
+
+  // accumulators of each prompt half, 6 rows {IE, QE, IP, QP, IL, QL} of 'n_ant'
+  std::vector<double> acc(2 * 6 * n_ant, 0.0);
+
+  // one replica block is correlated in sub-blocks small enough for the transposed samples
+  uint64_t max_block = std::min<uint64_t>(REPLICA_BLOCK, CodeReplica::MaxBlockLength(d_code));
+  int max_sub = std::max(ARRAY_BLOCK_VALUES / std::max(n_ant, 1), 1);
+  uint64_t k = 0;
+  while (k < n_samp) {
+    uint64_t end = (k < n_first_half) ? n_first_half : n_samp;
+    int n = static_cast<int>(std::min(end - k, max_block));
+    double kd = static_cast<double>(k);
+
+    // one carrier and code replica for every antenna
+    double carr_phase = rem_carr_phase + kd * d_carr;
+    nco.Generate(carr, static_cast<uint64_t>(n), carr_phase, d_carr);
+    double p0 = CodeReplica::WrapPhase(rem_code_phase + kd * d_code);
+    for (int i = 0; i < n; i++) {
+      double p = p0 + static_cast<double>(i) * d_code;
+      cr[i] = carr[i].real();
+      ci[i] = carr[i].imag();
+      ce[i] = code[CodeReplica::ExpandedIndex(p + t_space)];
+      cp[i] = code[CodeReplica::ExpandedIndex(p)];
+      cl[i] = code[CodeReplica::ExpandedIndex(p - t_space)];
+    }
+
+    // transpose the antenna columns and correlate
+    double *half = acc.data() + ((k < n_first_half) ? 0 : 6 * n_ant);
+    for (int i = 0; i < n; i += max_sub) {
+      int m = std::min(n - i, max_sub);
+      Interleave<N>(rfdata, n_ant, k + static_cast<uint64_t>(i), m, xr, xi);
+      Mac<N>(level, xr, xi, cr + i, ci + i, ce + i, cp + i, cl + i, m, n_ant, half);
+    }
+    k += static_cast<uint64_t>(n);
+  }
+
+  // prompt halves share the early and late sums
+  const double *acc1 = acc.data();
+  const double *acc2 = acc.data() + 6 * n_ant;
+  for (int a = 0; a < n_ant; a++) {
+    auto sum = [&](const double *half, const int &j) { return half[j * n_ant + a]; };
+    E[a] += std::complex<double>(sum(acc1, 0) + sum(acc2, 0), sum(acc1, 1) + sum(acc2, 1));
+    P1[a] += std::complex<double>(sum(acc1, 2), sum(acc1, 3));
+    P2[a] += std::complex<double>(sum(acc2, 2), sum(acc2, 3));
+    L[a] += std::complex<double>(sum(acc1, 4) + sum(acc2, 4), sum(acc1, 5) + sum(acc2, 5));
+  }
+
+  // advance nco phases
+  rem_code_phase += static_cast<double>(n_samp) * d_code;
+  rem_carr_phase += static_cast<double>(n_samp) * d_carr;
+}
+
+}  // namespace
+
+// *=== AccumulateEPLArraySoa ===*
+template <typename T>
+void AccumulateEPLArraySoa(
+    CarrierNco &nco,
+    const T *const rfdata[],
+    const int &n_ant,
+    const uint64_t &n_samp,
+    const double *code,
+    double &rem_code_phase,
+    const double &d_code,
+    double &rem_carr_phase,
+    const double &d_carr,
+    const uint64_t &n_first_half,
+    const double &t_space,
+    std::complex<double> *E,
+    std::complex<double> *P1,
+    std::complex<double> *P2,
+    std::complex<double> *L) {
+  auto accumulate = [&](auto kernel) {
+    kernel(
+        nco,
+        rfdata,
+        n_ant,
+        n_samp,
+        code,
+        rem_code_phase,
+        d_code,
+        rem_carr_phase,
+        d_carr,
+        n_first_half,
+        t_space,
+        E,
+        P1,
+        P2,
+        L);
+  };
+  switch (n_ant) {
+    case 2:
+      accumulate(AccumulateBlocks<2, T>);
+      break;
+    case 4:
+      accumulate(AccumulateBlocks<4, T>);
+      break;
+    case 8:
+      accumulate(AccumulateBlocks<8, T>);
+      break;
+    default:
+      accumulate(AccumulateBlocks<0, T>);
+      break;
+  }
+}
+
+// Explicit instantiation of AccumulateEPLArraySoa for every ring storage format
+template void AccumulateEPLArraySoa<std::complex<double>>(
+    CarrierNco &,
+    const std::complex<double> *const[],
+    const int &,
+    const uint64_t &,
+    const double *,
+    double &,
+    const double &,
+    double &,
+    const double &,
+    const uint64_t &,
+    const double &,
+    std::complex<double> *,
+    std::complex<double> *,
+    std::complex<double> *,
+    std::complex<double> *);
+template void AccumulateEPLArraySoa<std::complex<float>>(
+    CarrierNco &,
+    const std::complex<float> *const[],
+    const int &,
+    const uint64_t &,
+    const double *,
+    double &,
+    const double &,
+    double &,
+    const double &,
+    const uint64_t &,
+    const double &,
+    std::complex<double> *,
+    std::complex<double> *,
+    std::complex<double> *,
+    std::complex<double> *);
+template void AccumulateEPLArraySoa<int8_t>(
+    CarrierNco &,
+    const int8_t *const[],
+    const int &,
+    const uint64_t &,
+    const double *,
+    double &,
+    const double &,
+    double &,
+    const double &,
+    const uint64_t &,
+    const double &,
+    std::complex<double> *,
+    std::complex<double> *,
+    std::complex<double> *,
+    std::complex<double> *);
+template void AccumulateEPLArraySoa<int16_t>(
+    CarrierNco &,
+    const int16_t *const[],
+    const int &,
+    const uint64_t &,
+    const double *,
+    double &,
+    const double &,
+    double &,
+    const double &,
+    const uint64_t &,
+    const double &,
+    std::complex<double> *,
+    std::complex<double> *,
+    std::complex<double> *,
+    std::complex<double> *);
+template void AccumulateEPLArraySoa<std::complex<int8_t>>(
+    CarrierNco &,
+    const std::complex<int8_t> *const[],
+    const int &,
+    const uint64_t &,
+    const double *,
+    double &,
+    const double &,
+    double &,
+    const double &,
+    const uint64_t &,
+    const double &,
+    std::complex<double> *,
+    std::complex<double> *,
+    std::complex<double> *,
+    std::complex<double> *);
+template void AccumulateEPLArraySoa<std::complex<int16_t>>(
+    CarrierNco &,
+    const std::complex<int16_t> *const[],
+    const int &,
+    const uint64_t &,
+    const double *,
+    double &,
+    const double &,
+    double &,
+    const double &,
+    const uint64_t &,
+    const double &,
+    std::complex<double> *,
+    std::complex<double> *,
+    std::complex<double> *,
+    std::complex<double> *);
+
+}  // namespace sturdr
@@ -0,0 +1,201 @@
+/**
+ * *batch-correlator.cpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/batch-correlator.cpp
+ * @brief   Correlates the shared memory block of several tracking channels in a single pass.
+ * @date    October 2026
+ * @ref     1. "Flat Combining and the Synchronization-Parallelism Tradeoff", 2010
+ *              - Hendler, Incze, Shavit, Tzafrir
+ * =======  ========================================================================================
+ */
+
+#include "sturdr/batch-correlator.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "sturdr/simd-correlator.hpp"
+
+namespace sturdr {
+
+namespace {
+
+// request states
+constexpr uint8_t IDLE = 0;
+constexpr uint8_t PENDING = 1;
+constexpr uint8_t RUNNING = 2;
+constexpr uint8_t DONE = 3;
+
+}  // namespace
+
+// *=== BatchCorrelator ===*
+BatchCorrelator::BatchCorrelator(
+    std::shared_ptr<SampleRing> shared_array, const uint8_t &max_channels)
+    : shm_{shared_array},
+      state_(max_channels, IDLE),
+      start_(max_channels, 0),
+      n_samp_(max_channels, 0),
+      n_first_half_(max_channels, 0),
+      code_(max_channels, nullptr),
+      rem_code_phase_(max_channels, 0.0),
+      d_code_(max_channels, 0.0),
+      rem_carr_phase_(max_channels, 0.0),
+      d_carr_(max_channels, 0.0),
+      t_space_(max_channels, 0.0),
+      E_(max_channels),
+      P1_(max_channels),
+      P2_(max_channels),
+      L_(max_channels),
+      nco_(max_channels, CarrierNco(GetCarrierNcoMode(), TILE)),
+      busy_{false} {
+}
+
+// *=== Accumulate ===*
+void BatchCorrelator::Accumulate(
+    const uint8_t &slot,
+    const uint64_t &shm_ptr,
+    const uint64_t &n_samp,
+    const CodeReplica &code,
+    double &rem_code_phase,
+    const double &code_freq,
+    double &rem_carr_phase,
+    const double &carr_freq,
+    const double &carr_jit,
+    const double &samp_freq,
+    const uint64_t &half_samp,
+    uint64_t &samp_remaining,
+    const double &t_space,
+    std::complex<double> &E,
+    std::complex<double> &P1,
+    std::complex<double> &P2,
+    std::complex<double> &L) {
+  std::unique_lock<std::mutex> lock(mtx_);
+
+  // post request
+  start_[slot] = shm_ptr;
+  n_samp_[slot] = n_samp;
+  n_first_half_[slot] =
+      (samp_remaining > half_samp) ? std::min(n_samp, samp_remaining - half_samp) : 0;
+  code_[slot] = code.f64_expanded.data();
+  rem_code_phase_[slot] = rem_code_phase;
+  d_code_[slot] = code_freq / samp_freq;
+  rem_carr_phase_[slot] = rem_carr_phase;
+  d_carr_[slot] = (carr_freq + 0.5 * carr_jit / samp_freq) / samp_freq;
+  t_space_[slot] = t_space;
+  E_[slot] = 0.0;
+  P1_[slot] = 0.0;
+  P2_[slot] = 0.0;
+  L_[slot] = 0.0;
+  state_[slot] = PENDING;
+
+  // either combine every pending request or wait for the current combiner to finish ours
+  while (state_[slot] != DONE) {
+    if (!busy_) {
+      busy_ = true;
+      std::vector<uint8_t> batch;
+      for (uint8_t i = 0; i < static_cast<uint8_t>(state_.size()); i++) {
+        if (state_[i] == PENDING) {
+          state_[i] = RUNNING;
+          batch.push_back(i);
+        }
+      }
+      lock.unlock();
+      Process(batch);
+      lock.lock();
+      for (const uint8_t &i : batch) {
+        state_[i] = DONE;
+      }
+      busy_ = false;
+      cv_.notify_all();
+    } else {
+      cv_.wait(lock);
+    }
+  }
+
+  // collect results
+  rem_code_phase = rem_code_phase_[slot];
+  rem_carr_phase = rem_carr_phase_[slot];
+  samp_remaining -= n_samp;
+  E += E_[slot];
+  P1 += P1_[slot];
+  P2 += P2_[slot];
+  L += L_[slot];
+  state_[slot] = IDLE;
+}
+
+// *=== Process ===*
+void BatchCorrelator::Process(const std::vector<uint8_t> &batch) {
+  // progress of each request through its window
+  std::vector<uint64_t> done(batch.size(), 0);
+  uint64_t pos = std::numeric_limits<uint64_t>::max();
+  for (const uint8_t &i : batch) {
+    pos = std::min(pos, start_[i]);
+  }
+
+  bool remaining = true;
+  while (remaining) {
+    // correlate every request overlapping the current tile
+    uint64_t tile_end = pos + TILE;
+    uint64_t next = std::numeric_limits<uint64_t>::max();
+    remaining = false;
+    for (std::size_t j = 0; j < batch.size(); j++) {
+      uint8_t i = batch[j];
+      uint64_t cur = start_[i] + done[j];
+      uint64_t end = start_[i] + n_samp_[i];
+      if (cur < tile_end && cur < end) {
+        uint64_t n = std::min(end, tile_end) - cur;
+        uint64_t n_first_half =
+            (n_first_half_[i] > done[j]) ? std::min(n, n_first_half_[i] - done[j]) : 0;
+        auto accumulate = [&](const auto *x) {
+          AccumulateEPLSimd(
+              nco_[i],
+              x + cur,
+              n,
+              code_[i],
+              rem_code_phase_[i],
+              d_code_[i],
+              rem_carr_phase_[i],
+              d_carr_[i],
+              n_first_half,
+              t_space_[i],
+              E_[i],
+              P1_[i],
+              P2_[i],
+              L_[i]);
+        };
+        switch (shm_->Format()) {
+          case SampleFormat::INT8:
+            accumulate(shm_->Int8(0, 0));
+            break;
+          case SampleFormat::INT16:
+            accumulate(shm_->Int16(0, 0));
+            break;
+          case SampleFormat::CINT8:
+            accumulate(reinterpret_cast<const std::complex<int8_t> *>(shm_->Int8(0, 0)));
+            break;
+          case SampleFormat::CINT16:
+            accumulate(reinterpret_cast<const std::complex<int16_t> *>(shm_->Int16(0, 0)));
+            break;
+          case SampleFormat::CFLOAT:
+            accumulate(shm_->MatrixF().col(0).data());
+            break;
+          default:
+            accumulate(shm_->Matrix().col(0).data());
+            break;
+        }
+        done[j] += n;
+        cur += n;
+      }
+      if (cur < end) {
+        remaining = true;
+        next = std::min(next, cur);
+      }
+    }
+
+    // skip over any gap between request windows
+    pos = std::max(tile_end, next);
+  }
+}
+
+}  // namespace sturdr
@@ -0,0 +1,172 @@
+/**
+ * *carrier-nco.cpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/carrier-nco.cpp
+ * @brief   Carrier replica generator that avoids a transcendental call per sample.
+ * @date    October 2026
+ * @ref     1. "Understanding GPS/GNSS Principles and Applications", 3rd Edition, 2017
+ *              - Kaplan & Hegarty
+ *          2. "Digital Signal Processing: Principles, Algorithms, and Applications", 4th Edition,
+ *              2007 - Proakis & Manolakis
+ * =======  ========================================================================================
+ */
+
+#include "sturdr/carrier-nco.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+
+namespace sturdr {
+
+namespace {
+
+constexpr double TWO_PI = 6.283185307179586476925286766559;
+constexpr double TWO_POW_32 = 4294967296.0;
+
+// carrier mode shared by the correlators
+std::atomic<int> active_mode{CarrierNcoMode::ROTATOR};
+
+// *=== SinCosTable ===*
+// interleaved (re, im) samples of exp(-i*2*pi*k/LUT_SIZE), built once and shared read-only
+const std::array<double, 2 * CarrierNco::LUT_SIZE> &SinCosTable() {
+  static const std::array<double, 2 * CarrierNco::LUT_SIZE> table = [] {
+    std::array<double, 2 * CarrierNco::LUT_SIZE> t;
+    for (int k = 0; k < CarrierNco::LUT_SIZE; k++) {
+      double phase = TWO_PI * static_cast<double>(k) / static_cast<double>(CarrierNco::LUT_SIZE);
+      t[2 * k] = std::cos(phase);
+      t[2 * k + 1] = -std::sin(phase);
+    }
+    return t;
+  }();
+  return table;
+}
+
+// *=== PhaseToFixed ===*
+// converts a phase [rad] into a 32-bit fraction of a cycle
+uint32_t PhaseToFixed(const double &phase) {
+  double cycles = phase / TWO_PI;
+  cycles -= std::floor(cycles);
+  return static_cast<uint32_t>(static_cast<uint64_t>(std::llround(cycles * TWO_POW_32)));
+}
+
+}  // namespace
+
+// *=== GetCarrierNcoMode ===*
+CarrierNcoMode::CarrierNcoMode GetCarrierNcoMode() {
+  return static_cast<CarrierNcoMode::CarrierNcoMode>(active_mode.load(std::memory_order_relaxed));
+}
+
+// *=== SetCarrierNcoMode ===*
+void SetCarrierNcoMode(const CarrierNcoMode::CarrierNcoMode &mode) {
+  active_mode.store(static_cast<int>(mode), std::memory_order_relaxed);
+}
+
+// *=== CarrierNco ===*
+CarrierNco::CarrierNco(const CarrierNcoMode::CarrierNcoMode &mode, const uint64_t &renorm_interval)
+    : mode_{mode},
+      renorm_{std::max<uint64_t>(renorm_interval, 1)},
+      d_cached_{std::nan("1")},
+      step_re_{1.0},
+      step_im_{0.0} {
+}
+
+// *=== Generate ===*
+void CarrierNco::Generate(
+    std::complex<double> *out, const uint64_t &n, double &phase, const double &d_phase) {
+  switch (mode_) {
+    case CarrierNcoMode::LUT:
+      GenerateLut(out, n, phase, d_phase);
+      break;
+    case CarrierNcoMode::ROTATOR:
+      GenerateRotator(out, n, phase, d_phase);
+      break;
+    default:
+      GenerateExact(out, n, phase, d_phase);
+      break;
+  }
+  phase += static_cast<double>(n) * d_phase;
+}
+
+// *=== PhaseErrorBound ===*
+double CarrierNco::PhaseErrorBound(const uint64_t &n) const {
+  switch (mode_) {
+    case CarrierNcoMode::LUT:
+      // table quantization (half an entry) + rounding of the anchor and of the 32-bit increment
+      return TWO_PI * (0.5 / static_cast<double>(LUT_SIZE) +
+                       (0.5 + 0.5 * static_cast<double>(n)) / TWO_POW_32);
+    case CarrierNcoMode::ROTATOR: {
+      // each recursive complex multiply adds at most a few ulps, the chain restarts every renorm_
+      double n_steps = static_cast<double>(std::min(n, renorm_)) / static_cast<double>(LANES) + 1.0;
+      return 4.0 * DBL_EPSILON * n_steps;
+    }
+    default:
+      return 0.0;
+  }
+}
+
+// *=== GenerateExact ===*
+void CarrierNco::GenerateExact(
+    std::complex<double> *out, const uint64_t &n, const double &phase, const double &d_phase) {
+  for (uint64_t k = 0; k < n; k++) {
+    double p = phase + static_cast<double>(k) * d_phase;
+    out[k] = std::complex<double>(std::cos(p), -std::sin(p));
+  }
+}
+
+// *=== GenerateLut ===*
+void CarrierNco::GenerateLut(
+    std::complex<double> *out, const uint64_t &n, const double &phase, const double &d_phase) {
+  const std::array<double, 2 * LUT_SIZE> &table = SinCosTable();
+  double *o = reinterpret_cast<double *>(out);
+  uint32_t acc = PhaseToFixed(phase) + (1u << (31 - LUT_BITS));  // round to nearest entry
+  uint32_t step = PhaseToFixed(d_phase);
+  for (uint64_t k = 0; k < n; k++) {
+    uint32_t idx = acc >> (32 - LUT_BITS);
+    o[2 * k] = table[2 * idx];
+    o[2 * k + 1] = table[2 * idx + 1];
+    acc += step;
+  }
+}
+
+// *=== GenerateRotator ===*
+void CarrierNco::GenerateRotator(
+    std::complex<double> *out, const uint64_t &n, const double &phase, const double &d_phase) {
+  // lane 'k' holds exp(-i*k*d) and every lane advances by exp(-i*LANES*d)
+  if (d_phase != d_cached_) {
+    for (int k = 0; k < LANES; k++) {
+      lane_re_[k] = std::cos(d_phase * k);
+      lane_im_[k] = -std::sin(d_phase * k);
+    }
+    step_re_ = std::cos(d_phase * LANES);
+    step_im_ = -std::sin(d_phase * LANES);
+    d_cached_ = d_phase;
+  }
+
+  double *o = reinterpret_cast<double *>(out);
+  for (uint64_t s = 0; s < n; s += renorm_) {
+    // re-anchor to the exact phase (resets amplitude and phase drift)
+    uint64_t m = std::min(renorm_, n - s);
+    double p = phase + static_cast<double>(s) * d_phase;
+    double a_re = std::cos(p);
+    double a_im = -std::sin(p);
+    double *c = o + 2 * s;
+    uint64_t n_lane = std::min<uint64_t>(m, LANES);
+    for (uint64_t k = 0; k < n_lane; k++) {
+      c[2 * k] = a_re * lane_re_[k] - a_im * lane_im_[k];
+      c[2 * k + 1] = a_re * lane_im_[k] + a_im * lane_re_[k];
+    }
+
+    // recursive rotation, LANES independent chains
+    for (uint64_t k = LANES; k < m; k++) {
+      const double *prev = c + 2 * (k - LANES);
+      c[2 * k] = prev[0] * step_re_ - prev[1] * step_im_;
+      c[2 * k + 1] = prev[0] * step_im_ + prev[1] * step_re_;
+    }
+  }
+}
+
+}  // namespace sturdr
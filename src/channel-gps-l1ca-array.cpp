@@ -32,19 +32,40 @@ ChannelGpsL1caArray::ChannelGpsL1caArray(
     Config &conf,
     uint8_t &n,
     std::shared_ptr<bool> running,
-    std::shared_ptr<Eigen::MatrixXcd> shared_array,
+    std::shared_ptr<SampleRing> shared_array,
     std::shared_ptr<ConcurrentBarrier> barrier1,
     std::shared_ptr<ConcurrentBarrier> barrier2,
     std::shared_ptr<ConcurrentQueue> nav_queue,
-    std::shared_ptr<FftwWrapper> fftw_plans,
-    std::function<void(uint8_t &)> &GetNewPrnFunc)
+    std::shared_ptr<AcquisitionContext> acq_ctx,
+    std::shared_ptr<AcquisitionContextF> acq_ctx_f,
+    std::shared_ptr<AcquisitionWorkspacePool> acq_pool,
+    std::shared_ptr<AcquisitionWorkspacePoolF> acq_pool_f,
+    std::shared_ptr<AcquisitionEngine> acq_engine,
+    std::shared_ptr<AcquisitionAiding> acq_aiding,
+    std::shared_ptr<BatchCorrelator> batch_correlator,
+    std::shared_ptr<PrnScheduler> prn_scheduler)
     : ChannelGpsL1ca(
-          conf, n, running, shared_array, barrier1, barrier2, nav_queue, fftw_plans, GetNewPrnFunc),
+          conf,
+          n,
+          running,
+          shared_array,
+          barrier1,
+          barrier2,
+          nav_queue,
+          acq_ctx,
+          acq_ctx_f,
+          acq_pool,
+          acq_pool_f,
+          acq_engine,
+          acq_aiding,
+          batch_correlator,
+          prn_scheduler),
       p_array_{Eigen::VectorXcd::Zero(conf.antenna.n_ant)},
       p1_array_{Eigen::VectorXcd::Zero(conf.antenna.n_ant)},
       p2_array_{Eigen::VectorXcd::Zero(conf.antenna.n_ant)},
       e_array_{Eigen::VectorXcd::Zero(conf.antenna.n_ant)},
       l_array_{Eigen::VectorXcd::Zero(conf.antenna.n_ant)},
+      fixed_array_((fixed_point_ || packed_) ? conf.antenna.n_ant : 0),
       bf_{BeamFormer(conf_.antenna.n_ant, nav_pkt_.Lambda, conf_.antenna.ant_xyz)},
       is_bf_{false} {
   nav_pkt_.PromptCorrelators.resize(conf_.antenna.n_ant);
@@ -62,23 +83,74 @@ void ChannelGpsL1caArray::Integrate(const uint64_t &samp_to_read) {
   double nco_code_freq = satutils::GPS_CA_CODE_RATE<> + code_doppler_;
   double nco_carr_freq = intmd_freq_rad_ + carr_doppler_;
 
+  // multi-correlator taps (first antenna) read the nco state before the array correlators move it
+  if (multi_) {
+    multi_->Accumulate(
+        *shm_,
+        shm_ptr_,
+        samp_to_read,
+        *code_,
+        rem_code_phase_,
+        nco_code_freq,
+        rem_carr_phase_,
+        nco_carr_freq,
+        carr_jitter_,
+        conf_.rfsignal.samp_freq);
+  }
+
   // accumulate samples
-  AccumulateEPLArray(
-      shm_->block(shm_ptr_, 0, samp_to_read, (int)conf_.antenna.n_ant),
-      code_.data(),
-      rem_code_phase_,
-      nco_code_freq,
-      rem_carr_phase_,
-      nco_carr_freq,
-      carr_jitter_,
-      conf_.rfsignal.samp_freq,
-      half_samp_,
-      samp_remaining_,
-      tap_space_,
-      e_array_,
-      p1_array_,
-      p2_array_,
-      l_array_);
+  if (packed_) {
+    AccumulateEPLArrayPacked(
+        *shm_,
+        shm_ptr_,
+        samp_to_read,
+        *code_,
+        rem_code_phase_,
+        nco_code_freq,
+        rem_carr_phase_,
+        nco_carr_freq,
+        carr_jitter_,
+        conf_.rfsignal.samp_freq,
+        half_samp_,
+        samp_remaining_,
+        tap_space_,
+        fixed_array_);
+  } else if (fixed_point_) {
+    AccumulateEPLArrayFixed(
+        *shm_,
+        shm_ptr_,
+        samp_to_read,
+        *code_,
+        rem_code_phase_,
+        nco_code_freq,
+        rem_carr_phase_,
+        nco_carr_freq,
+        carr_jitter_,
+        conf_.rfsignal.samp_freq,
+        half_samp_,
+        samp_remaining_,
+        tap_space_,
+        fixed_array_);
+  } else {
+    AccumulateEPLArray(
+        *shm_,
+        shm_ptr_,
+        samp_to_read,
+        *code_,
+        rem_code_phase_,
+        nco_code_freq,
+        rem_carr_phase_,
+        nco_carr_freq,
+        carr_jitter_,
+        conf_.rfsignal.samp_freq,
+        half_samp_,
+        samp_remaining_,
+        tap_space_,
+        e_array_,
+        p1_array_,
+        p2_array_,
+        l_array_);
+  }
   // AccumulateEPL(
   //     shm_->col(0).segment(shm_ptr_, samp_to_read),
   //     code_.data(),
@@ -103,6 +175,11 @@ void ChannelGpsL1caArray::Integrate(const uint64_t &samp_to_read) {
 
 // *=== Dump ===*
 void ChannelGpsL1caArray::Dump() {
+  // widen fixed-point (or packed) accumulators
+  for (std::size_t i = 0; i < fixed_array_.size(); i++) {
+    WidenEPL(fixed_array_[i], e_array_(i), p1_array_(i), p2_array_(i), l_array_(i));
+  }
+
   // log_->warn("u_body = [{}, {}, {}]", u_body_(0), u_body_(1), u_body_(2));
   // beamsteer
   if (!std::isnan((*nav_pkt_.UnitVec)(0))) {
@@ -286,10 +363,17 @@ void ChannelGpsL1caArray::Dump() {
       break;
   }
 
+  if (multi_) {
+    multi_->Dump(file_pkt_.Correlators);
+  }
+
   // std::cout << "ChannelGpsL1ca::Dump - file log called\n";
   // file_log_->info("{}", file_pkt_);
   file_log_->write(reinterpret_cast<char *>(&int_per_cnt_), sizeof(uint64_t));
-  file_log_->write(reinterpret_cast<char *>(&file_pkt_), sizeof(ChannelPacket));
+  file_log_->write(reinterpret_cast<char *>(&file_pkt_), CHANNEL_PACKET_LOG_SIZE);
+  file_log_->write(
+      reinterpret_cast<char *>(file_pkt_.Correlators.data()),
+      file_pkt_.Correlators.size() * sizeof(std::complex<double>));
 
   // begin next nco period
   NewCodePeriod();
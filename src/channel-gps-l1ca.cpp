@@ -21,7 +21,6 @@
 #include <cstring>
 #include <fstream>
 #include <navtools/constants.hpp>
-#include <satutils/code-gen.hpp>
 #include <satutils/gnss-constants.hpp>
 #include <string>
 
@@ -40,14 +39,35 @@ ChannelGpsL1ca::ChannelGpsL1ca(
     Config &conf,
     uint8_t &n,
     std::shared_ptr<bool> running,
-    std::shared_ptr<Eigen::MatrixXcd> shared_array,
+    std::shared_ptr<SampleRing> shared_array,
     std::shared_ptr<ConcurrentBarrier> barrier1,
     std::shared_ptr<ConcurrentBarrier> barrier2,
     std::shared_ptr<ConcurrentQueue> nav_queue,
-    std::shared_ptr<FftwWrapper> fftw_plans,
-    std::function<void(uint8_t &)> &GetNewPrnFunc)
+    std::shared_ptr<AcquisitionContext> acq_ctx,
+    std::shared_ptr<AcquisitionContextF> acq_ctx_f,
+    std::shared_ptr<AcquisitionWorkspacePool> acq_pool,
+    std::shared_ptr<AcquisitionWorkspacePoolF> acq_pool_f,
+    std::shared_ptr<AcquisitionEngine> acq_engine,
+    std::shared_ptr<AcquisitionAiding> acq_aiding,
+    std::shared_ptr<BatchCorrelator> batch_correlator,
+    std::shared_ptr<PrnScheduler> prn_scheduler)
     : Channel(
-          conf, n, running, shared_array, barrier1, barrier2, nav_queue, fftw_plans, GetNewPrnFunc),
+          conf,
+          n,
+          running,
+          shared_array,
+          barrier1,
+          barrier2,
+          nav_queue,
+          acq_ctx,
+          acq_ctx_f,
+          acq_pool,
+          acq_pool_f,
+          acq_engine,
+          acq_aiding,
+          batch_correlator,
+          prn_scheduler),
+      code_{nullptr},
       intmd_freq_rad_{navtools::TWO_PI<> * conf_.rfsignal.intmd_freq},
       rem_code_phase_{0.0},
       code_doppler_{0.0},
@@ -75,20 +95,38 @@ ChannelGpsL1ca::ChannelGpsL1ca(
       P1_{std::complex<double>(0.0, 0.0)},
       P2_{std::complex<double>(0.0, 0.0)},
       P_old_{std::complex<double>(0.0, 0.0)},
+      fixed_point_{
+          conf_.tracking.fixed_point_correlate && shared_array->IsInteger()},
+      packed_{conf_.tracking.packed_correlate && shared_array->IsPacked()},
+      fixed_epl_{FixedEPL()},
+      multi_{
+          (conf_.tracking.multi_correlator_taps > 0)
+              ? std::make_unique<MultiCorrelator>(
+                    conf_.tracking.multi_correlator_taps, conf_.tracking.multi_correlator_span)
+              : nullptr},
       T_{0.001},
       T_ms_{1},
       int_per_cnt_{0},
       total_samp_{conf_.acquisition.num_coh_per * conf_.acquisition.num_noncoh_per * samp_per_ms_},
       half_samp_{total_samp_ / 2},
       samp_remaining_{0},
-      gps_lnav_{satutils::GpsLnav<double>()} {
+      gps_lnav_{satutils::GpsLnav<double>()},
+      track_start_cnt_{0},
+      reacq_{conf_.tracking.loss_of_lock_ms,
+              conf_.tracking.reacq_timeout_ms,
+              conf_.tracking.reacq_doppler_width,
+              conf_.tracking.reacq_doppler_rate,
+              conf_.acquisition.doppler_range,
+              conf_.acquisition.doppler_step} {
   // grab prn to try signal processing with
   file_pkt_.Header.Signal = GnssSignal::GPS_L1CA;
   file_pkt_.Header.Constellation = GnssSystem::GPS;
-  new_prn_func_(file_pkt_.Header.SVID);
+  SetPrn(prn_scheduler_->Claim());
   nav_pkt_.Header = file_pkt_.Header;
   eph_pkt_.Header = file_pkt_.Header;
-  satutils::CodeGenCA(code_.data(), file_pkt_.Header.SVID);
+  if (file_pkt_.Header.SVID == 0) {
+    file_pkt_.ChannelStatus = ChannelState::IDLE;
+  }
   log_->info(
       "SturDR Channel {} initialized to GPS{}", file_pkt_.Header.ChannelNum, file_pkt_.Header.SVID);
 
@@ -124,31 +162,31 @@ void ChannelGpsL1ca::NewCodePeriod() {
   samp_remaining_ = total_samp_;
 }
 
+// *=== Idle ===*
+void ChannelGpsL1ca::Idle() {
+  shm_ptr_ = shm_writer_ptr_;
+  SetPrn(prn_scheduler_->Claim());
+  if (file_pkt_.Header.SVID > 0) {
+    acq_fail_cnt_ = 0;
+    file_pkt_.ChannelStatus = ChannelState::ACQUIRING;
+  }
+}
+
 // *=== Acquire ===*
 void ChannelGpsL1ca::Acquire() {
+  // searches handed to the acquisition engine do not hold up the barriers
+  if (acq_engine_) {
+    AcquireAsync();
+    return;
+  }
+
   // make sure there are enough samples to acquire with
   if (UnreadSampleCount() < total_samp_) return;
 
-  // Perform parallel acquisition/correlation
-  Eigen::MatrixXd corr_map = PcpsSearch(
-      *fftw_plans_,
-      shm_->col(0).segment(shm_ptr_, total_samp_),
-      code_.data(),
-      conf_.acquisition.doppler_range,
-      conf_.acquisition.doppler_step,
-      conf_.rfsignal.samp_freq,
-      satutils::GPS_CA_CODE_RATE<>,
-      conf_.rfsignal.intmd_freq,
-      conf_.acquisition.num_coh_per,
-      conf_.acquisition.num_noncoh_per);
-
-  // test for success
-  int max_peak_idx[2];
-  double metric;
-  // GlrtTest(corr_map, max_peak_idx, metric, shm_->segment(shm_ptr_, total_samp_));
-  Peak2NoiseFloorTest(corr_map, max_peak_idx, metric);
-
-  if (metric < conf_.acquisition.threshold) {
+  // test for success, only the Doppler bins around a predicted Doppler are searched once the
+  // navigator has a fix
+  AcquisitionResult result = Search(AcquisitionWindow());
+  if (result.metric < conf_.acquisition.threshold) {
     // --- FAILURE ---
     shm_ptr_ += total_samp_;
     shm_ptr_ %= shm_file_size_samp_;
@@ -156,52 +194,19 @@ void ChannelGpsL1ca::Acquire() {
         "Channel{} failed to acquire GPS{} - Metric: {}",
         file_pkt_.Header.ChannelNum,
         file_pkt_.Header.SVID,
-        metric);
+        result.metric);
 
     // try a new prn
-    new_prn_func_(file_pkt_.Header.SVID);
-    satutils::CodeGenCA(code_.data(), file_pkt_.Header.SVID);
-    nav_pkt_.Header.SVID = file_pkt_.Header.SVID;
-    eph_pkt_.Header.SVID = file_pkt_.Header.SVID;
-
-    // check fail count
-    acq_fail_cnt_++;
-    if (acq_fail_cnt_ > conf_.acquisition.max_failed_attempts) {
-      file_pkt_.ChannelStatus = ChannelState::IDLE;
-      return;
+    if (NextPrn(result.metric)) {
+      Acquire();
     }
 
-    Acquire();
-
   } else {
     // --- SUCCESS ---
-    file_pkt_.ChannelStatus = ChannelState::TRACKING;
-    file_pkt_.Doppler =
-        -conf_.acquisition.doppler_range + max_peak_idx[1] * conf_.acquisition.doppler_step;
-    nav_pkt_.Doppler = carr_doppler_;
-    log_->info(
-        "{}: GPS{} acquired! Doppler (Hz) = {:.0f}, Code Phase (samp) = {:d}, metric = {:.1f}",
-        file_pkt_.Header.ChannelNum,
-        file_pkt_.Header.SVID,
-        file_pkt_.Doppler,
-        max_peak_idx[0],
-        metric);
-
     // update file pointer
-    shm_ptr_ += (total_samp_ - samp_per_ms_ + static_cast<uint64_t>(max_peak_idx[0]));
+    shm_ptr_ += (total_samp_ - samp_per_ms_ + static_cast<uint64_t>(result.peak_idx[0]));
     shm_ptr_ %= shm_file_size_samp_;
 
-    // initialize tracking
-    carr_doppler_ = navtools::TWO_PI<> * file_pkt_.Doppler;
-    code_doppler_ = kappa_ * carr_doppler_;
-    kf_.Init(
-        rem_carr_phase_,
-        carr_doppler_,
-        rem_code_phase_,
-        intmd_freq_rad_,
-        satutils::GPS_CA_CODE_RATE<>);
-    NewCodePeriod();
-
     // std::string fname = "Channel_" + std::to_string(file_pkt_.Header.ChannelNum) + "_GPS" +
     //                     std::to_string(file_pkt_.Header.SVID);
     // std::ofstream file(fname, std::ios::binary);
@@ -209,18 +214,196 @@ void ChannelGpsL1ca::Acquire() {
     // file.close();
 
     // begin tracking
+    StartTracking(result);
     Track();
   }
 }
 
+// *=== AcquireAsync ===*
+void ChannelGpsL1ca::AcquireAsync() {
+  if (acq_job_) {
+    if (!acq_job_->done.load(std::memory_order_acquire)) {
+      // keep up with the writer while the search runs
+      shm_ptr_ = shm_writer_ptr_;
+      return;
+    }
+    AcquisitionResult res = acq_job_->results[0];
+    uint64_t job_ptr = acq_job_->ptr;
+    acq_job_.reset();
+
+    if (res.metric < conf_.acquisition.threshold) {
+      // --- FAILURE ---
+      log_->debug(
+          "Channel{} failed to acquire GPS{} - Metric: {}",
+          file_pkt_.Header.ChannelNum,
+          file_pkt_.Header.SVID,
+          res.metric);
+      if (!NextPrn(res.metric)) {
+        return;
+      }
+    } else {
+      // --- SUCCESS ---
+      AlignToSnapshot(res, job_ptr);
+
+      // begin tracking
+      StartTracking(res);
+      Track();
+      return;
+    }
+  }
+
+  // search a private copy of the newest samples
+  if (UnreadSampleCount() < total_samp_) return;
+  acq_job_ = acq_engine_->Submit(
+      *shm_, shm_ptr_, total_samp_, {file_pkt_.Header.SVID}, {AcquisitionWindow()});
+  shm_ptr_ = shm_writer_ptr_;
+}
+
+// *=== AlignToSnapshot ===*
+void ChannelGpsL1ca::AlignToSnapshot(AcquisitionResult &result, const uint64_t &job_ptr) {
+  // the code found in the last period of the snapshot has drifted with its code Doppler over the
+  // samples skipped while it was searched
+  uint64_t last = (job_ptr + total_samp_ - samp_per_ms_) % shm_file_size_samp_;
+  uint64_t elapsed = (shm_ptr_ + shm_file_size_samp_ - last) % shm_file_size_samp_;
+  AdvanceCodePhase(
+      result, AcquiredDoppler(result), satutils::GPS_L1_FREQUENCY<>, elapsed, samp_per_ms_);
+
+  // the ring holds a whole number of code periods, so the period found in the snapshot starts
+  // at the same offset of every later period, move forward to the next one
+  uint64_t found = (last + static_cast<uint64_t>(result.peak_idx[0])) % samp_per_ms_;
+  shm_ptr_ += (found + samp_per_ms_ - shm_ptr_ % samp_per_ms_) % samp_per_ms_;
+  shm_ptr_ %= shm_file_size_samp_;
+}
+
+// *=== Search ===*
+AcquisitionResult ChannelGpsL1ca::Search(const DopplerWindow &window) {
+  // Perform parallel acquisition/correlation (in single precision when a single precision
+  // context is shared), in a pooled workspace returned before the next try. The detector reduces
+  // the map as it is produced, so it is never stored or read back
+  if (acq_ctx_f_) {
+    std::shared_ptr<AcquisitionWorkspaceF> ws = acq_pool_f_->Borrow();
+    return PcpsDetect<float>(
+        *acq_ctx_f_,
+        *ws,
+        shm_->View(shm_ptr_, total_samp_, 1, shm_scratch_f_).col(0),
+        file_pkt_.Header.SVID,
+        conf_.acquisition.num_coh_per,
+        conf_.acquisition.num_noncoh_per,
+        false,
+        window);
+  }
+  std::shared_ptr<AcquisitionWorkspace> ws = acq_pool_->Borrow();
+  return PcpsDetect<double>(
+      *acq_ctx_,
+      *ws,
+      shm_->View(shm_ptr_, total_samp_, 1, shm_scratch_).col(0),
+      file_pkt_.Header.SVID,
+      conf_.acquisition.num_coh_per,
+      conf_.acquisition.num_noncoh_per,
+      false,
+      window);
+}
+
+// *=== AcquisitionWindow ===*
+DopplerWindow ChannelGpsL1ca::AcquisitionWindow() const {
+  if (!acq_aiding_) {
+    return DopplerWindow{};
+  }
+  return acq_aiding_->Window(
+      file_pkt_.Header.SVID, conf_.acquisition.doppler_range, conf_.acquisition.doppler_step);
+}
+
+// *=== SetPrn ===*
+void ChannelGpsL1ca::SetPrn(const uint8_t &prn) {
+  file_pkt_.Header.SVID = prn;
+  nav_pkt_.Header.SVID = prn;
+  eph_pkt_.Header.SVID = prn;
+  if (prn > 0) {
+    code_ = &GpsL1caReplica(prn);
+  }
+}
+
+// *=== NextPrn ===*
+bool ChannelGpsL1ca::NextPrn(const double &metric) {
+  prn_scheduler_->Failed(file_pkt_.Header.SVID, metric);
+
+  // check fail count
+  acq_fail_cnt_++;
+  if (acq_fail_cnt_ > conf_.acquisition.max_failed_attempts) {
+    SetPrn(0);
+    file_pkt_.ChannelStatus = ChannelState::IDLE;
+    return false;
+  }
+  SetPrn(prn_scheduler_->Claim());
+  if (file_pkt_.Header.SVID == 0) {
+    file_pkt_.ChannelStatus = ChannelState::IDLE;
+    return false;
+  }
+  return true;
+}
+
+// *=== AcquiredDoppler ===*
+double ChannelGpsL1ca::AcquiredDoppler(const AcquisitionResult &result) const {
+  double bin = conf_.acquisition.fine_acquisition ? result.bin
+                                                  : static_cast<double>(result.peak_idx[1]);
+  return -conf_.acquisition.doppler_range + bin * conf_.acquisition.doppler_step;
+}
+
+// *=== StartTracking ===*
+void ChannelGpsL1ca::StartTracking(const AcquisitionResult &result) {
+  bool fine = conf_.acquisition.fine_acquisition;
+  file_pkt_.ChannelStatus = ChannelState::TRACKING;
+  file_pkt_.Doppler = AcquiredDoppler(result);
+  nav_pkt_.Doppler = carr_doppler_;
+  log_->info(
+      "{}: GPS{} acquired! Doppler (Hz) = {:.0f}, Code Phase (samp) = {:.2f}, metric = {:.1f}",
+      file_pkt_.Header.ChannelNum,
+      file_pkt_.Header.SVID,
+      file_pkt_.Doppler,
+      fine ? result.code_phase : static_cast<double>(result.peak_idx[0]),
+      result.metric);
+
+  // initialize tracking
+  carr_doppler_ = navtools::TWO_PI<> * file_pkt_.Doppler;
+  code_doppler_ = kappa_ * carr_doppler_;
+  if (fine) {
+    // the code starts between samples, the read pointer sits on the integer peak sample
+    double chips_per_samp = satutils::GPS_CA_CODE_RATE<> / conf_.rfsignal.samp_freq;
+    double step_rad = navtools::TWO_PI<> * conf_.acquisition.doppler_step;
+    rem_code_phase_ =
+        (static_cast<double>(result.peak_idx[0]) - result.code_phase) * chips_per_samp;
+    kf_.Init(
+        rem_carr_phase_,
+        carr_doppler_,
+        rem_code_phase_,
+        intmd_freq_rad_,
+        satutils::GPS_CA_CODE_RATE<>,
+        result.bin_var * step_rad * step_rad,
+        result.code_var * chips_per_samp * chips_per_samp);
+  } else {
+    kf_.Init(
+        rem_carr_phase_,
+        carr_doppler_,
+        rem_code_phase_,
+        intmd_freq_rad_,
+        satutils::GPS_CA_CODE_RATE<>);
+  }
+  NewCodePeriod();
+
+  // the loops get 'min_converg_time_ms' to lock before a missing lock counts as a loss, a loss
+  // before the first lock reacquires around the acquired Doppler
+  track_start_cnt_ = int_per_cnt_;
+  reacq_.Start(file_pkt_.Doppler, conf_.tracking.min_converg_time_ms);
+}
+
 // *=== Track ===*
 void ChannelGpsL1ca::Track() {
   // make sure a count of the unprocessed samples is made
   uint64_t unread_samples = UnreadSampleCount();
   uint64_t samp_to_read;
 
-  // process until all samples have been read
-  while (unread_samples > 0) {
+  // process until all samples have been read (or lock is lost)
+  while (unread_samples > 0 && file_pkt_.ChannelStatus == ChannelState::TRACKING) {
     if (samp_remaining_ > 0) {
       // --- INTEGRATE ---
       samp_to_read = std::min(samp_remaining_, unread_samples);
@@ -266,23 +449,94 @@ void ChannelGpsL1ca::Integrate(const uint64_t &samp_to_read) {
   double nco_code_freq = satutils::GPS_CA_CODE_RATE<> + code_doppler_;
   double nco_carr_freq = intmd_freq_rad_ + carr_doppler_;
 
-  // accumulate samples
-  AccumulateEPL(
-      shm_->col(0).segment(shm_ptr_, samp_to_read),
-      code_.data(),
-      rem_code_phase_,
-      nco_code_freq,
-      rem_carr_phase_,
-      nco_carr_freq,
-      carr_jitter_,
-      conf_.rfsignal.samp_freq,
-      half_samp_,
-      samp_remaining_,
-      tap_space_,
-      E_,
-      P1_,
-      P2_,
-      L_);
+  // multi-correlator taps read the nco state before the early/prompt/late correlators advance it
+  if (multi_) {
+    multi_->Accumulate(
+        *shm_,
+        shm_ptr_,
+        samp_to_read,
+        *code_,
+        rem_code_phase_,
+        nco_code_freq,
+        rem_carr_phase_,
+        nco_carr_freq,
+        carr_jitter_,
+        conf_.rfsignal.samp_freq);
+  }
+
+  // accumulate samples (on the packed bit planes, in fixed point or through the shared
+  // multi-channel correlator when enabled)
+  if (packed_) {
+    AccumulateEPLPacked(
+        *shm_,
+        shm_ptr_,
+        samp_to_read,
+        *code_,
+        rem_code_phase_,
+        nco_code_freq,
+        rem_carr_phase_,
+        nco_carr_freq,
+        carr_jitter_,
+        conf_.rfsignal.samp_freq,
+        half_samp_,
+        samp_remaining_,
+        tap_space_,
+        fixed_epl_);
+  } else if (fixed_point_) {
+    AccumulateEPLFixed(
+        *shm_,
+        shm_ptr_,
+        samp_to_read,
+        *code_,
+        rem_code_phase_,
+        nco_code_freq,
+        rem_carr_phase_,
+        nco_carr_freq,
+        carr_jitter_,
+        conf_.rfsignal.samp_freq,
+        half_samp_,
+        samp_remaining_,
+        tap_space_,
+        fixed_epl_);
+  } else if (batch_correlator_) {
+    batch_correlator_->Accumulate(
+        file_pkt_.Header.ChannelNum - 1,
+        shm_ptr_,
+        samp_to_read,
+        *code_,
+        rem_code_phase_,
+        nco_code_freq,
+        rem_carr_phase_,
+        nco_carr_freq,
+        carr_jitter_,
+        conf_.rfsignal.samp_freq,
+        half_samp_,
+        samp_remaining_,
+        tap_space_,
+        E_,
+        P1_,
+        P2_,
+        L_);
+  } else {
+    AccumulateEPL(
+        *shm_,
+        shm_ptr_,
+        samp_to_read,
+        *code_,
+        rem_code_phase_,
+        nco_code_freq,
+        rem_carr_phase_,
+        nco_carr_freq,
+        carr_jitter_,
+        conf_.rfsignal.samp_freq,
+        half_samp_,
+        samp_remaining_,
+        tap_space_,
+        E_,
+        P1_,
+        P2_,
+        L_);
+  }
   // P_ += (P1_ + P2_);
 
   // move forward in buffer
@@ -292,6 +546,11 @@ void ChannelGpsL1ca::Integrate(const uint64_t &samp_to_read) {
 
 // *=== Dump ===*
 void ChannelGpsL1ca::Dump() {
+  // widen fixed-point (or packed) accumulators
+  if (fixed_point_ || packed_) {
+    WidenEPL(fixed_epl_, E_, P1_, P2_, L_);
+  }
+
   // combine prompt sections
   P_ = P1_ + P2_;
 
@@ -412,12 +671,18 @@ void ChannelGpsL1ca::Dump() {
   file_pkt_.QP2 = P2_.imag();
   file_pkt_.CodePhase = rem_code_phase_;
   file_pkt_.CarrierPhase = rem_carr_phase_;
+  if (multi_) {
+    multi_->Dump(file_pkt_.Correlators);
+  }
 
-  // no need to log additional correlators here
+  // no need to log additional antenna correlators here
   // file_log_->info("{}", file_pkt_);
   file_log_->write(reinterpret_cast<char *>(&int_per_cnt_), sizeof(uint64_t));
   file_log_->write(
-      reinterpret_cast<char *>(&file_pkt_), sizeof(ChannelPacket) - 8 * sizeof(double));
+      reinterpret_cast<char *>(&file_pkt_), CHANNEL_PACKET_LOG_SIZE - 8 * sizeof(double));
+  file_log_->write(
+      reinterpret_cast<char *>(file_pkt_.Correlators.data()),
+      file_pkt_.Correlators.size() * sizeof(std::complex<double>));
 
   // begin next nco period
   NewCodePeriod();
@@ -488,6 +753,153 @@ void ChannelGpsL1ca::Status() {
       }
     }
   }
+
+  // loss of lock: no code lock for 'loss_of_lock_ms', in scalar and vector tracking alike
+  if (reacq_.Update(code_lock_, carr_doppler_ / navtools::TWO_PI<>, T_ms_)) {
+    LossOfLock();
+  }
+}
+
+// *=== LossOfLock ===*
+void ChannelGpsL1ca::LossOfLock() {
+  log_->info(
+      "{}: GPS{} lost lock! Reacquiring around Doppler (Hz) = {:.0f}",
+      file_pkt_.Header.ChannelNum,
+      file_pkt_.Header.SVID,
+      reacq_.Doppler());
+
+  // back to wide tracking and the acquisition block length
+  track_mode_ = 0;
+  w0d_ = NaturalFrequency(conf_.tracking.dll_bw_wide, 2);
+  w0p_ = NaturalFrequency(conf_.tracking.pll_bw_wide, 3);
+  w0f_ = NaturalFrequency(conf_.tracking.fll_bw_wide, 2);
+  tap_space_ = conf_.tracking.tap_epl_wide;
+  T_ = 0.001;
+  T_ms_ = 1;
+  total_samp_ = conf_.acquisition.num_coh_per * conf_.acquisition.num_noncoh_per * samp_per_ms_;
+  half_samp_ = total_samp_ / 2;
+  samp_remaining_ = 0;
+  rem_code_phase_ = 0.0;
+  rem_carr_phase_ = 0.0;
+  carr_jitter_ = 0.0;
+  code_lock_ = false;
+  carr_lock_ = false;
+  lock_.Reset();
+
+  // a vector tracked channel leaves the vector loop, the navigator stops waiting for it once the
+  // scalar packet Track sends on its way out arrives. It stays scalar after reacquisition
+  if (*nav_pkt_.is_vector) {
+    std::unique_lock<std::mutex> channel_lock(*nav_pkt_.mtx);
+    *nav_pkt_.is_vector = false;
+  }
+
+  // the data bits and time of week have to be found again, until then the navigator leaves this
+  // channel out (its ephemeris is kept)
+  std::fill(std::begin(bit_sync_hist_), std::end(bit_sync_hist_), 1);
+  gps_lnav_ = satutils::GpsLnav<double>();
+  file_pkt_.TrackingStatus = TrackingFlags::UNKNOWN;
+  file_pkt_.ToW = std::nan("1");
+  nav_pkt_.ToW = file_pkt_.ToW;
+  file_pkt_.ChannelStatus = ChannelState::REACQUIRING;
+}
+
+// *=== Reacquire ===*
+void ChannelGpsL1ca::Reacquire() {
+  // searches handed to the acquisition engine do not hold up the barriers
+  if (acq_engine_) {
+    ReacquireAsync();
+    return;
+  }
+
+  // search the newest samples, the skipped ones only count toward the timeout
+  uint64_t unread_samples = UnreadSampleCount();
+  if (unread_samples < total_samp_) return;
+  uint64_t skipped = unread_samples - total_samp_;
+  shm_ptr_ += skipped;
+  shm_ptr_ %= shm_file_size_samp_;
+  reacq_.Elapse(skipped / samp_per_ms_);
+
+  // the window widens with the time spent, including the samples of this search
+  AcquisitionResult result = Search(reacq_.Window());
+  reacq_.Elapse(total_samp_ / samp_per_ms_);
+
+  if (result.metric < conf_.acquisition.threshold) {
+    // --- FAILURE ---
+    shm_ptr_ += total_samp_;
+    shm_ptr_ %= shm_file_size_samp_;
+    ReacquisitionFailed(result.metric);
+
+  } else {
+    // --- SUCCESS ---
+    shm_ptr_ += (total_samp_ - samp_per_ms_ + static_cast<uint64_t>(result.peak_idx[0]));
+    shm_ptr_ %= shm_file_size_samp_;
+    StartTracking(result);
+    Track();
+  }
+}
+
+// *=== ReacquireAsync ===*
+void ChannelGpsL1ca::ReacquireAsync() {
+  if (acq_job_) {
+    if (!acq_job_->done.load(std::memory_order_acquire)) {
+      // keep up with the writer while the search runs
+      shm_ptr_ = shm_writer_ptr_;
+      return;
+    }
+    AcquisitionResult res = acq_job_->results[0];
+    uint64_t job_ptr = acq_job_->ptr;
+    acq_job_.reset();
+
+    // the snapshot and every sample skipped while it was searched count toward the timeout
+    uint64_t elapsed = (shm_ptr_ + shm_file_size_samp_ - job_ptr) % shm_file_size_samp_;
+    reacq_.Elapse(elapsed / samp_per_ms_);
+
+    if (res.metric < conf_.acquisition.threshold) {
+      // --- FAILURE ---
+      ReacquisitionFailed(res.metric);
+      if (file_pkt_.ChannelStatus != ChannelState::REACQUIRING) {
+        return;
+      }
+    } else {
+      // --- SUCCESS ---
+      AlignToSnapshot(res, job_ptr);
+      StartTracking(res);
+      Track();
+      return;
+    }
+  }
+
+  // search a private copy of the newest samples, the skipped ones only count toward the timeout
+  uint64_t unread_samples = UnreadSampleCount();
+  if (unread_samples < total_samp_) return;
+  uint64_t skipped = unread_samples - total_samp_;
+  shm_ptr_ += skipped;
+  shm_ptr_ %= shm_file_size_samp_;
+  reacq_.Elapse(skipped / samp_per_ms_);
+  acq_job_ = acq_engine_->Submit(
+      *shm_, shm_ptr_, total_samp_, {file_pkt_.Header.SVID}, {reacq_.Window()});
+  shm_ptr_ = shm_writer_ptr_;
+}
+
+// *=== ReacquisitionFailed ===*
+void ChannelGpsL1ca::ReacquisitionFailed(const double &metric) {
+  log_->debug(
+      "Channel{} failed to reacquire GPS{} - Metric: {}, Window (Hz): +/-{:.0f}",
+      file_pkt_.Header.ChannelNum,
+      file_pkt_.Header.SVID,
+      metric,
+      reacq_.Width());
+
+  // fall back to a full search
+  file_pkt_.ChannelStatus = reacq_.Searched(false);
+  if (file_pkt_.ChannelStatus == ChannelState::ACQUIRING) {
+    log_->info(
+        "{}: GPS{} not reacquired after {} ms",
+        file_pkt_.Header.ChannelNum,
+        file_pkt_.Header.SVID,
+        reacq_.Elapsed());
+    acq_fail_cnt_ = 0;
+  }
 }
 
 // *=== NavDataSync ===*
@@ -500,7 +912,7 @@ bool ChannelGpsL1ca::NavDataSync() {
     std::copy(std::begin(bit_sync_hist_), std::end(bit_sync_hist_), sorted_bit_sync_hist);
     std::sort(std::begin(sorted_bit_sync_hist), std::end(sorted_bit_sync_hist));
 
-    if (int_per_cnt_ > (uint64_t)conf_.tracking.min_converg_time_ms) {
+    if (int_per_cnt_ - track_start_cnt_ > (uint64_t)conf_.tracking.min_converg_time_ms) {
       // check for data lock
       if (sorted_bit_sync_hist[19] >= (4 * sorted_bit_sync_hist[18])) {
         log_->debug(
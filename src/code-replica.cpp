@@ -0,0 +1,57 @@
+/**
+ * *code-replica.cpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/code-replica.cpp
+ * @brief   Precomputed spreading code chip tables shared by all channels.
+ * @date    October 2026
+ * @ref     1. "IS-GPS-200N: Navstar GPS Space Segment/Navigation User Segment Interfaces", 2022
+ *          2. "A Software-Defined GPS and Galileo Receiver: A Single-Frequency Approach", 2007
+ *              - Borre, Akos, Bertelsen, Rinder, Jensen
+ * =======  ========================================================================================
+ */
+
+#include "sturdr/code-replica.hpp"
+
+#include <memory>
+#include <satutils/code-gen.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace sturdr {
+
+// *=== CodeReplica ===*
+CodeReplica::CodeReplica(const bool code[1023]) {
+  for (int i = 0; i < LENGTH; i++) {
+    bits[i] = code[i];
+    i8[i] = code[i] ? 1 : -1;
+    f32[i] = code[i] ? 1.0f : -1.0f;
+  }
+  for (int i = 0; i < EXPANDED_LENGTH; i++) {
+    int chip = (i - PAD + LENGTH) % LENGTH;
+    i8_expanded[i] = i8[chip];
+    f32_expanded[i] = f32[chip];
+    f64_expanded[i] = static_cast<double>(i8[chip]);
+  }
+}
+
+// *=== GpsL1caReplica ===*
+const CodeReplica &GpsL1caReplica(const uint8_t &prn) {
+  if (prn < 1 || prn > 32) {
+    throw std::out_of_range("there is no GPS L1 C/A code for PRN " + std::to_string(prn));
+  }
+
+  // built once (thread-safe static initialization) and never modified afterwards
+  static const std::unique_ptr<const std::array<CodeReplica, 32>> replicas = [] {
+    auto r = std::make_unique<std::array<CodeReplica, 32>>();
+    bool code[1023];
+    for (uint8_t i = 0; i < 32; i++) {
+      satutils::CodeGenCA(code, i + 1);
+      (*r)[i] = CodeReplica(code);
+    }
+    return std::unique_ptr<const std::array<CodeReplica, 32>>(std::move(r));
+  }();
+  return (*replicas)[prn - 1];
+}
+
+}  // namespace sturdr
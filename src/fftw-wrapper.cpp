@@ -13,44 +13,268 @@ fftw-wrapper.cpp
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 
 namespace sturdr {
 
-// *=== ~FftwWrapper ===*
-FftwWrapper::~FftwWrapper() {
+namespace {
+
+// FFTW-aligned, zeroed scratch of 'n' complex samples (planning and warmup)
+template <typename Real>
+class Scratch {
+ public:
+  using Complex = typename FftwApi<Real>::complex;
+  explicit Scratch(const std::size_t n) : n_{std::max<std::size_t>(n, 1)} {
+    p_ = static_cast<Complex *>(FftwApi<Real>::malloc(sizeof(Complex) * n_));
+    if (!p_) {
+      throw std::bad_alloc();
+    }
+    std::fill_n(reinterpret_cast<Real *>(p_), 2 * n_, Real(0));
+  }
+  ~Scratch() {
+    FftwApi<Real>::free(p_);
+  }
+  Scratch(const Scratch &) = delete;
+  Scratch &operator=(const Scratch &) = delete;
+  Complex *get() const {
+    return p_;
+  }
+
+ private:
+  std::size_t n_;
+  Complex *p_;
+};
+
+// samples spanned by 'howmany' transforms of length 'len'
+std::size_t Extent(const int len, const int howmany, const int stride, const int dist) {
+  return static_cast<std::size_t>(len - 1) * stride + static_cast<std::size_t>(howmany - 1) * dist +
+         1;
+}
+
+}  // namespace
+
+// *=== ~BasicFftwWrapper ===*
+template <typename Real>
+BasicFftwWrapper<Real>::~BasicFftwWrapper() {
   // spdlog::get("sturdr-console")->trace("~FftwWrapper");
-  fftw_destroy_plan(fft_);
-  fftw_destroy_plan(ifft_);
-  fftw_destroy_plan(fft_many_);
-  fftw_destroy_plan(ifft_many_);
+  for (auto &[key, p] : plans_) {
+    FftwApi<Real>::destroy_plan(p);
+  }
 }
 
 // *=== ThreadSafety ===*
-void FftwWrapper::ThreadSafety() {
-  fftw_make_planner_thread_safe();
+template <typename Real>
+void BasicFftwWrapper<Real>::ThreadSafety() {
+  FftwApi<Real>::make_planner_thread_safe();
+}
+
+// *=== SetThreads ===*
+template <typename Real>
+void BasicFftwWrapper<Real>::SetThreads(const int n_threads) {
+#ifdef STURDR_FFTW_THREADS
+  static std::once_flag init;
+  std::call_once(init, [] { FftwApi<Real>::init_threads(); });
+  n_threads_ = std::max(n_threads, 1);
+#else
+  if (n_threads > 1) {
+    spdlog::get("sturdr-console")
+        ->warn("fftw-wrapper.cpp SetThreads: built without fftw3_threads, FFTs stay serial");
+  }
+#endif
+}
+
+// *=== SetPlannerEffort ===*
+template <typename Real>
+bool BasicFftwWrapper<Real>::SetPlannerEffort(const std::string &effort) {
+  static const std::map<std::string, unsigned> efforts{
+      {"estimate", FFTW_ESTIMATE},
+      {"measure", FFTW_MEASURE},
+      {"patient", FFTW_PATIENT},
+      {"exhaustive", FFTW_EXHAUSTIVE}};
+  auto it = efforts.find(effort);
+  if (it == efforts.end()) {
+    return false;
+  }
+  flags_ = it->second;
+  return true;
+}
+
+// *=== ImportWisdom ===*
+template <typename Real>
+bool BasicFftwWrapper<Real>::ImportWisdom(const std::string &dir) {
+  return FftwApi<Real>::import_wisdom_from_filename(WisdomFile(dir).c_str()) != 0;
+}
+
+// *=== ExportWisdom ===*
+template <typename Real>
+bool BasicFftwWrapper<Real>::ExportWisdom(const std::string &dir) {
+  return FftwApi<Real>::export_wisdom_to_filename(WisdomFile(dir).c_str()) != 0;
+}
+
+// *=== WisdomFile ===*
+template <typename Real>
+std::string BasicFftwWrapper<Real>::WisdomFile(const std::string &dir) {
+  // the processor model and its instruction set flags identify the host
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line, model, flags;
+  while (std::getline(cpuinfo, line) && (model.empty() || flags.empty())) {
+    if (model.empty() && line.rfind("model name", 0) == 0) {
+      model = line;
+    } else if (flags.empty() && line.rfind("flags", 0) == 0) {
+      flags = line;
+    }
+  }
+  std::ostringstream name;
+  name << dir << "/fftw" << FftwApi<Real>::suffix << "-wisdom-" << std::hex
+       << std::hash<std::string>{}(model + flags) << ".dat";
+  return name.str();
+}
+
+// *=== Warmup ===*
+template <typename Real>
+void BasicFftwWrapper<Real>::Warmup() {
+  std::shared_lock<std::shared_mutex> lock(mtx_);
+  for (auto &[key, p] : plans_) {
+    auto [len, howmany, stride, dist, is_fft, in_place, aligned] = key;
+    std::size_t n = Extent(len, howmany, stride, dist);
+    Scratch<Real> in(n);
+    if (in_place) {
+      FftwApi<Real>::execute_dft(p, in.get(), in.get());
+    } else {
+      Scratch<Real> out(n);
+      FftwApi<Real>::execute_dft(p, in.get(), out.get());
+    }
+  }
+}
+
+// *=== GetPlan ===*
+template <typename Real>
+typename BasicFftwWrapper<Real>::Plan BasicFftwWrapper<Real>::GetPlan(
+    const int len,
+    const int howmany,
+    const int stride,
+    const int dist,
+    const bool is_fft,
+    const bool in_place,
+    const bool aligned) {
+  PlanKey key{len, howmany, stride, dist, is_fft, in_place, aligned};
+  {
+    std::shared_lock<std::shared_mutex> lock(mtx_);
+    auto it = plans_.find(key);
+    if (it != plans_.end()) {
+      return it->second;
+    }
+  }
+
+  // the FFTW planner is not re-entrant, and another thread may have planned in the meantime
+  std::unique_lock<std::shared_mutex> lock(mtx_);
+  auto it = plans_.find(key);
+  if (it != plans_.end()) {
+    return it->second;
+  }
+  std::size_t n = Extent(len, howmany, stride, dist);
+  Scratch<Real> in(n);
+  Scratch<Real> out(in_place ? 0 : n);
+  int dims[1] = {len};
+#ifdef STURDR_FFTW_THREADS
+  // only whole matrices are threaded, column blocks already run on separate threads
+  FftwApi<Real>::plan_with_nthreads(aligned && howmany > 1 ? n_threads_ : 1);
+#endif
+  Plan p = FftwApi<Real>::plan_many_dft(
+      1,
+      dims,
+      howmany,
+      in.get(),
+      dims,
+      stride,
+      dist,
+      in_place ? in.get() : out.get(),
+      dims,
+      stride,
+      dist,
+      is_fft ? FFTW_FORWARD : FFTW_BACKWARD,
+      aligned ? flags_ : flags_ | FFTW_UNALIGNED);
+#ifdef STURDR_FFTW_THREADS
+  FftwApi<Real>::plan_with_nthreads(1);
+#endif
+  if (!p) {
+    throw std::runtime_error("fftw could not plan a transform of length " + std::to_string(len));
+  }
+  plans_.emplace(key, p);
+  return p;
+}
+
+// *=== NumPlans ===*
+template <typename Real>
+std::size_t BasicFftwWrapper<Real>::NumPlans() const {
+  std::shared_lock<std::shared_mutex> lock(mtx_);
+  return plans_.size();
+}
+
+// *=== IsAligned ===*
+template <typename Real>
+bool BasicFftwWrapper<Real>::IsAligned(const std::complex<Real> *p) {
+  Real *r = reinterpret_cast<Real *>(const_cast<std::complex<Real> *>(p));
+  return FftwApi<Real>::alignment_of(r) == 0;
+}
+
+// *=== SmoothSize ===*
+template <typename Real>
+int BasicFftwWrapper<Real>::SmoothSize(const int n) {
+  for (int m = std::max(n, 1);; m++) {
+    int r = m;
+    for (int f : {2, 3, 5, 7}) {
+      while (r % f == 0) {
+        r /= f;
+      }
+    }
+    if (r == 1) {
+      return m;
+    }
+  }
+}
+
+// *=== PaddedSize ===*
+template <typename Real>
+int BasicFftwWrapper<Real>::PaddedSize(const int n) {
+  int m = SmoothSize(n);
+  if (m == n) {
+    return n;
+  }
+
+  // compare FFTW's own cost model of both lengths, the estimate plans are not kept
+  std::unique_lock<std::shared_mutex> lock(mtx_);
+  auto cost = [](const int len) {
+    Scratch<Real> x(len);
+    Plan p = FftwApi<Real>::plan_dft_1d(len, x.get(), x.get(), FFTW_FORWARD, FFTW_ESTIMATE);
+    double c = p ? FftwApi<Real>::estimate_cost(p) : std::numeric_limits<double>::max();
+    if (p) {
+      FftwApi<Real>::destroy_plan(p);
+    }
+    return c;
+  };
+  return cost(m) < cost(n) ? m : n;
 }
 
 // *=== Create1dFftPlan ===*
-void FftwWrapper::Create1dFftPlan(const int len, const bool is_fft) {
-  Eigen::VectorXd tmp(len);
+template <typename Real>
+void BasicFftwWrapper<Real>::Create1dFftPlan(const int len, const bool is_fft) {
   try {
     if (is_fft) {
       // fft
-      fft_ = fftw_plan_dft_1d(
-          len,
-          reinterpret_cast<fftw_complex *>(tmp.data()),
-          reinterpret_cast<fftw_complex *>(tmp.data()),
-          FFTW_FORWARD,
-          FFTW_ESTIMATE);  // FFTW_MEASURE
+      fft_ = GetPlan(len, 1, 1, len, true);
     } else {
       // ifft
-      ifft_ = fftw_plan_dft_1d(
-          len,
-          reinterpret_cast<fftw_complex *>(tmp.data()),
-          reinterpret_cast<fftw_complex *>(tmp.data()),
-          FFTW_BACKWARD,
-          FFTW_ESTIMATE);
+      ifft_ = GetPlan(len, 1, 1, len, false);
     }
   } catch (std::exception &e) {
     spdlog::get("sturdr-console")
@@ -60,99 +284,72 @@ void FftwWrapper::Create1dFftPlan(const int len, const bool is_fft) {
 }
 
 // *=== CreateManyFftPlan ===*
-void FftwWrapper::CreateManyFftPlan(
+template <typename Real>
+void BasicFftwWrapper<Real>::CreateManyFftPlan(
     const int nrow, const int ncol, const bool is_fft, const bool is_rowwise) {
   try {
-    Eigen::MatrixXd tmp(nrow, ncol);
-
-    int rank = 1;  // rank/dimension of fft
-    int n[1];      // how long each fft is
-    int howmany, idist, odist, istride, ostride;
+    many_rowwise_ = is_rowwise;
+    Plan p;
     if (is_rowwise) {
-      n[0] = ncol;
-      howmany = nrow;                  // how many transforms to compute
-      idist = 1, odist = 1;            // ptr to sequential fft starting locations
-      istride = nrow, ostride = nrow;  // how far apart each sample is
+      // ncol long transforms of each row, samples are nrow apart
+      p = GetPlan(ncol, nrow, nrow, 1, is_fft);
     } else {
-      n[0] = nrow;
-      howmany = ncol;
-      idist = nrow, odist = nrow;
-      istride = 1, ostride = 1;
+      // nrow long transforms of each column
+      p = GetPlan(nrow, ncol, 1, nrow, is_fft);
     }
-    int *inembed = n, *onembed = n;
+    (is_fft ? fft_many_ : ifft_many_) = p;
+  } catch (std::exception &e) {
+    spdlog::get("sturdr-console")
+        ->error("fftw-wrapper.cpp CreateManyFftPlan failed! Error -> {}", e.what());
+    exit(EXIT_FAILURE);
+  }
+}
 
-    if (is_fft) {
-      // fft
-      fft_many_ = fftw_plan_many_dft(
-          rank,
-          n,
-          howmany,
-          reinterpret_cast<fftw_complex *>(tmp.data()),
-          inembed,
-          istride,
-          idist,
-          reinterpret_cast<fftw_complex *>(tmp.data()),
-          onembed,
-          ostride,
-          odist,
-          FFTW_FORWARD,
-          FFTW_ESTIMATE);
-    } else {
-      // ifft
-      ifft_many_ = fftw_plan_many_dft(
-          rank,
-          n,
-          howmany,
-          reinterpret_cast<fftw_complex *>(tmp.data()),
-          inembed,
-          istride,
-          idist,
-          reinterpret_cast<fftw_complex *>(tmp.data()),
-          onembed,
-          ostride,
-          odist,
-          FFTW_BACKWARD,
-          FFTW_ESTIMATE);
+// *=== CreateColumnPlans ===*
+template <typename Real>
+void BasicFftwWrapper<Real>::CreateColumnPlans(const int nrow, const int ncol, const int n_split) {
+  try {
+    // blocks are [k*ncol/n_split, (k+1)*ncol/n_split), so at most two widths and two alignments
+    Scratch<Real> x(static_cast<std::size_t>(nrow) * ncol);
+    for (int k = 0; k < n_split; k++) {
+      int j0 = k * ncol / n_split;
+      int width = (k + 1) * ncol / n_split - j0;
+      bool aligned = IsAligned(reinterpret_cast<std::complex<Real> *>(x.get() + j0 * nrow));
+      if (width > 0) {
+        GetPlan(nrow, width, 1, nrow, true, true, aligned);
+        GetPlan(nrow, width, 1, nrow, false, true, aligned);
+      }
     }
   } catch (std::exception &e) {
     spdlog::get("sturdr-console")
-        ->error("fftw-wrapper.cpp CreateManyFftPlan failed! Error -> {}", e.what());
+        ->error("fftw-wrapper.cpp CreateColumnPlans failed! Error -> {}", e.what());
     exit(EXIT_FAILURE);
   }
 }
 
+// *=== ExecuteColumns ===*
+template <typename Real>
+void BasicFftwWrapper<Real>::ExecuteColumns(
+    Eigen::Ref<MatrixXc> x, const int col, const int ncol, const bool is_fft) {
+  std::complex<Real> *data = x.col(col).data();
+  Execute(x.rows(), ncol, 1, x.outerStride(), is_fft, data, data);
+}
+
 // *=== ExecuteFftPlan ===*
-bool FftwWrapper::ExecuteFftPlan(
-    Eigen::Ref<Eigen::MatrixXcd> in,
-    Eigen::Ref<Eigen::MatrixXcd> out,
+template <typename Real>
+bool BasicFftwWrapper<Real>::ExecuteFftPlan(
+    Eigen::Ref<MatrixXc> in,
+    Eigen::Ref<MatrixXc> out,
     const bool is_fft,
     const bool is_many_fft) {
   try {
     // execute fft
-    if (is_fft) {
-      if (is_many_fft) {
-        fftw_execute_dft(
-            fft_many_,
-            reinterpret_cast<fftw_complex *>(in.data()),
-            reinterpret_cast<fftw_complex *>(out.data()));
-      } else {
-        fftw_execute_dft(
-            fft_,
-            reinterpret_cast<fftw_complex *>(in.data()),
-            reinterpret_cast<fftw_complex *>(out.data()));
-      }
+    if (!is_many_fft) {
+      Execute(in.size(), 1, 1, in.size(), is_fft, in.data(), out.data());
+    } else if (many_rowwise_) {
+      Execute(in.cols(), in.rows(), in.outerStride(), 1, is_fft, in.data(), out.data());
     } else {
-      if (is_many_fft) {
-        fftw_execute_dft(
-            ifft_many_,
-            reinterpret_cast<fftw_complex *>(in.data()),
-            reinterpret_cast<fftw_complex *>(out.data()));
-      } else {
-        fftw_execute_dft(
-            ifft_,
-            reinterpret_cast<fftw_complex *>(in.data()),
-            reinterpret_cast<fftw_complex *>(out.data()));
-      }
+      Execute(in.rows(), in.cols(), 1, in.outerStride(), is_fft, in.data(), out.data());
     }
     return true;
   } catch (std::exception const &e) {
@@ -161,6 +358,23 @@ bool FftwWrapper::ExecuteFftPlan(
     exit(EXIT_FAILURE);
   }
 }
+
+// *=== Execute ===*
+template <typename Real>
+void BasicFftwWrapper<Real>::Execute(
+    const int len,
+    const int howmany,
+    const int stride,
+    const int dist,
+    const bool is_fft,
+    std::complex<Real> *in,
+    std::complex<Real> *out) {
+  using Complex = typename FftwApi<Real>::complex;
+  bool aligned = IsAligned(in) && IsAligned(out);
+  Plan p = GetPlan(len, howmany, stride, dist, is_fft, in == out, aligned);
+  FftwApi<Real>::execute_dft(p, reinterpret_cast<Complex *>(in), reinterpret_cast<Complex *>(out));
+}
+
 // bool ExecuteManyFftPlan(
 //     const fftw_plan &p, Eigen::Ref<Eigen::MatrixXcd> in, Eigen::Ref<Eigen::MatrixXcd> out) {
 //   try {
@@ -178,4 +392,8 @@ bool FftwWrapper::ExecuteFftPlan(
 //   }
 // };
 
+// Explicit instantiation of the double and single precision wrappers
+template class BasicFftwWrapper<double>;
+template class BasicFftwWrapper<float>;
+
 }  // end namespace sturdr
\ No newline at end of file
@@ -0,0 +1,463 @@
+/**
+ * *fixed-correlator.cpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/fixed-correlator.cpp
+ * @brief   Fixed-point early/prompt/late correlators operating on the raw quantized samples.
+ * @date    October 2026
+ * @ref     1. "Understanding GPS/GNSS Principles and Applications", 3rd Edition, 2017
+ *              - Kaplan & Hegarty
+ *          2. "A Software-Defined GPS and Galileo Receiver: A Single-Frequency Approach", 2007
+ *              - Borre, Akos, Bertelsen, Rinder, Jensen
+ * =======  ========================================================================================
+ */
+
+#include "sturdr/fixed-correlator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include "sturdr/simd-correlator.hpp"
+
+#ifdef STURDR_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace sturdr {
+
+namespace {
+
+constexpr double TWO_PI = 6.283185307179586476925286766559;
+
+// *=== FixedCarrierTable ===*
+// FIXED_CARR_AMP * exp(-i*2*pi*k/FIXED_CARR_SIZE) as int16 (re, im) pairs packed in 32 bits, so a
+// single gather fetches the complex carrier sample
+const std::array<int32_t, FIXED_CARR_SIZE> &FixedCarrierTable() {
+  static const std::array<int32_t, FIXED_CARR_SIZE> table = [] {
+    std::array<int32_t, FIXED_CARR_SIZE> t;
+    for (int k = 0; k < FIXED_CARR_SIZE; k++) {
+      double phase = TWO_PI * static_cast<double>(k) / static_cast<double>(FIXED_CARR_SIZE);
+      int16_t pair[2] = {
+          static_cast<int16_t>(std::lround(FIXED_CARR_AMP * std::cos(phase))),
+          static_cast<int16_t>(std::lround(-FIXED_CARR_AMP * std::sin(phase)))};
+      std::memcpy(&t[k], pair, sizeof(pair));
+    }
+    return t;
+  }();
+  return table;
+}
+
+/**
+ * @brief Replicas of one block, shared by every antenna: carrier as packed int16 (re, im) pairs
+ *        and the +/-1 chips of each tap as int32
+ */
+struct FixedReplica {
+  alignas(32) int32_t carr[FIXED_BLOCK];
+  alignas(32) int32_t code_e[FIXED_BLOCK];
+  alignas(32) int32_t code_p[FIXED_BLOCK];
+  alignas(32) int32_t code_l[FIXED_BLOCK];
+};
+
+// *=== ReplicaGeneric ===*
+// carrier and code replicas from 32-bit phase accumulators, 'code_acc' = {early, prompt, late}
+void ReplicaGeneric(
+    FixedReplica &rep,
+    const int &n,
+    const float *chips,
+    const uint32_t &carr_acc,
+    const uint32_t &carr_step,
+    const uint32_t code_acc[3],
+    const uint32_t &code_step) {
+  const std::array<int32_t, FIXED_CARR_SIZE> &table = FixedCarrierTable();
+  for (int i = 0; i < n; i++) {
+    uint32_t ui = static_cast<uint32_t>(i);
+    rep.carr[i] = table[(carr_acc + ui * carr_step) >> (32 - FIXED_CARR_BITS)];
+    rep.code_e[i] = static_cast<int32_t>(chips[(code_acc[0] + ui * code_step) >> CODE_FRAC_BITS]);
+    rep.code_p[i] = static_cast<int32_t>(chips[(code_acc[1] + ui * code_step) >> CODE_FRAC_BITS]);
+    rep.code_l[i] = static_cast<int32_t>(chips[(code_acc[2] + ui * code_step) >> CODE_FRAC_BITS]);
+  }
+}
+
+// *=== MacGeneric ===*
+// wipes off one antenna ('S' samples, interleaved I/Q if 'IQ'), acc = {IE, QE, IP, QP, IL, QL}
+template <typename S, bool IQ>
+void MacGeneric(const S *x, const FixedReplica &rep, const int &n, int32_t acc[6]) {
+  for (int i = 0; i < n; i++) {
+    int16_t c[2];
+    std::memcpy(c, &rep.carr[i], sizeof(c));
+    int32_t re, im;
+    if constexpr (IQ) {
+      re = x[2 * i] * c[0] - x[2 * i + 1] * c[1];
+      im = x[2 * i] * c[1] + x[2 * i + 1] * c[0];
+    } else {
+      re = x[i] * c[0];
+      im = x[i] * c[1];
+    }
+    acc[0] += rep.code_e[i] * re;
+    acc[1] += rep.code_e[i] * im;
+    acc[2] += rep.code_p[i] * re;
+    acc[3] += rep.code_p[i] * im;
+    acc[4] += rep.code_l[i] * re;
+    acc[5] += rep.code_l[i] * im;
+  }
+}
+
+#ifdef STURDR_SIMD_X86
+
+// *=== ReplicaAvx2 ===*
+// eight lanes per iteration, the carrier and the chips are fetched with 32-bit gathers
+__attribute__((target("avx2"))) void ReplicaAvx2(
+    FixedReplica &rep,
+    const int &n,
+    const float *chips,
+    const uint32_t &carr_acc,
+    const uint32_t &carr_step,
+    const uint32_t code_acc[3],
+    const uint32_t &code_step) {
+  const int32_t *table = FixedCarrierTable().data();
+  const __m256i lane = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+  __m256i carr = _mm256_add_epi32(
+      _mm256_set1_epi32(static_cast<int32_t>(carr_acc)),
+      _mm256_mullo_epi32(lane, _mm256_set1_epi32(static_cast<int32_t>(carr_step))));
+  __m256i code_offset =
+      _mm256_mullo_epi32(lane, _mm256_set1_epi32(static_cast<int32_t>(code_step)));
+  __m256i ce = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int32_t>(code_acc[0])), code_offset);
+  __m256i cp = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int32_t>(code_acc[1])), code_offset);
+  __m256i cl = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int32_t>(code_acc[2])), code_offset);
+  const __m256i carr_inc = _mm256_set1_epi32(static_cast<int32_t>(8u * carr_step));
+  const __m256i code_inc = _mm256_set1_epi32(static_cast<int32_t>(8u * code_step));
+
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i carr_idx = _mm256_srli_epi32(carr, 32 - FIXED_CARR_BITS);
+    _mm256_store_si256(
+        reinterpret_cast<__m256i *>(rep.carr + i), _mm256_i32gather_epi32(table, carr_idx, 4));
+    __m256 ve = _mm256_i32gather_ps(chips, _mm256_srli_epi32(ce, CODE_FRAC_BITS), 4);
+    __m256 vp = _mm256_i32gather_ps(chips, _mm256_srli_epi32(cp, CODE_FRAC_BITS), 4);
+    __m256 vl = _mm256_i32gather_ps(chips, _mm256_srli_epi32(cl, CODE_FRAC_BITS), 4);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(rep.code_e + i), _mm256_cvttps_epi32(ve));
+    _mm256_store_si256(reinterpret_cast<__m256i *>(rep.code_p + i), _mm256_cvttps_epi32(vp));
+    _mm256_store_si256(reinterpret_cast<__m256i *>(rep.code_l + i), _mm256_cvttps_epi32(vl));
+    carr = _mm256_add_epi32(carr, carr_inc);
+    ce = _mm256_add_epi32(ce, code_inc);
+    cp = _mm256_add_epi32(cp, code_inc);
+    cl = _mm256_add_epi32(cl, code_inc);
+  }
+
+  // remaining samples
+  if (i < n) {
+    FixedReplica tail;
+    uint32_t ui = static_cast<uint32_t>(i);
+    uint32_t tail_acc[3] = {
+        code_acc[0] + ui * code_step, code_acc[1] + ui * code_step, code_acc[2] + ui * code_step};
+    ReplicaGeneric(tail, n - i, chips, carr_acc + ui * carr_step, carr_step, tail_acc, code_step);
+    std::copy(tail.carr, tail.carr + n - i, rep.carr + i);
+    std::copy(tail.code_e, tail.code_e + n - i, rep.code_e + i);
+    std::copy(tail.code_p, tail.code_p + n - i, rep.code_p + i);
+    std::copy(tail.code_l, tail.code_l + n - i, rep.code_l + i);
+  }
+}
+
+// *=== LoadPairsAvx2 ===*
+// eight samples as int16 (I, Q) pairs (Q = 0 for real samples)
+template <typename S, bool IQ>
+__attribute__((target("avx2"))) inline __m256i LoadPairsAvx2(const S *x) {
+  const __m256i low = _mm256_set1_epi32(0xFFFF);
+  if constexpr (sizeof(S) == 1 && IQ) {
+    return _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(x)));
+  } else if constexpr (sizeof(S) == 1) {
+    return _mm256_and_si256(
+        _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(x))), low);
+  } else if constexpr (IQ) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x));
+  } else {
+    return _mm256_and_si256(
+        _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(x))), low);
+  }
+}
+
+// *=== MacAvx2 ===*
+// eight samples per iteration, madd forms (re, im) of the wiped sample and sign applies the chip
+template <typename S, bool IQ>
+__attribute__((target("avx2"))) void MacAvx2(
+    const S *x, const FixedReplica &rep, const int &n, int32_t acc[6]) {
+  constexpr int STRIDE = IQ ? 2 : 1;
+  const __m256i conj = _mm256_set1_epi32(static_cast<int32_t>(0xFFFF0001));
+  const __m256i swap = _mm256_set_epi8(
+      13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+      13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2);
+  __m256i sums[6];
+  for (int j = 0; j < 6; j++) {
+    sums[j] = _mm256_setzero_si256();
+  }
+
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i xv = LoadPairsAvx2<S, IQ>(x + STRIDE * i);
+    __m256i c = _mm256_load_si256(reinterpret_cast<const __m256i *>(rep.carr + i));
+    __m256i re = _mm256_madd_epi16(xv, _mm256_sign_epi16(c, conj));      // xr*cr - xi*ci
+    __m256i im = _mm256_madd_epi16(xv, _mm256_shuffle_epi8(c, swap));   // xr*ci + xi*cr
+    __m256i ve = _mm256_load_si256(reinterpret_cast<const __m256i *>(rep.code_e + i));
+    __m256i vp = _mm256_load_si256(reinterpret_cast<const __m256i *>(rep.code_p + i));
+    __m256i vl = _mm256_load_si256(reinterpret_cast<const __m256i *>(rep.code_l + i));
+    sums[0] = _mm256_add_epi32(sums[0], _mm256_sign_epi32(re, ve));
+    sums[1] = _mm256_add_epi32(sums[1], _mm256_sign_epi32(im, ve));
+    sums[2] = _mm256_add_epi32(sums[2], _mm256_sign_epi32(re, vp));
+    sums[3] = _mm256_add_epi32(sums[3], _mm256_sign_epi32(im, vp));
+    sums[4] = _mm256_add_epi32(sums[4], _mm256_sign_epi32(re, vl));
+    sums[5] = _mm256_add_epi32(sums[5], _mm256_sign_epi32(im, vl));
+  }
+
+  alignas(32) int32_t tmp[8];
+  for (int j = 0; j < 6; j++) {
+    _mm256_store_si256(reinterpret_cast<__m256i *>(tmp), sums[j]);
+    acc[j] += tmp[0] + tmp[1] + tmp[2] + tmp[3] + tmp[4] + tmp[5] + tmp[6] + tmp[7];
+  }
+
+  // remaining samples
+  if (i < n) {
+    FixedReplica tail;
+    std::copy(rep.carr + i, rep.carr + n, tail.carr);
+    std::copy(rep.code_e + i, rep.code_e + n, tail.code_e);
+    std::copy(rep.code_p + i, rep.code_p + n, tail.code_p);
+    std::copy(rep.code_l + i, rep.code_l + n, tail.code_l);
+    MacGeneric<S, IQ>(x + STRIDE * i, tail, n - i, acc);
+  }
+}
+
+#endif
+
+// *=== AccumulateBlocks ===*
+// 'S' is the stored integer type and 'IQ' whether samples are interleaved I/Q pairs
+template <typename S, bool IQ>
+void AccumulateBlocks(
+    const SampleRing &rfdata,
+    const uint64_t &ptr,
+    const std::size_t &n_ant,
+    const uint64_t &n_samp,
+    const CodeReplica &code,
+    const double &rem_code_phase,
+    const double &d_code,
+    const double &rem_carr_phase,
+    const double &d_carr,
+    const uint64_t &n_first_half,
+    const double &t_space,
+    FixedEPL *epl) {
+#ifdef STURDR_SIMD_X86
+  bool use_avx2 = GetSimdLevel() >= SimdLevel::AVX2;
+#endif
+  const float *chips = code.f32_expanded.data();
+  uint64_t max_block = std::min<uint64_t>(FIXED_BLOCK, CodeReplica::MaxBlockLength(d_code));
+  uint32_t carr_step = PhaseToFixed(d_carr);
+  uint32_t code_step = ChipsToFixed(d_code);
+  FixedReplica rep;
+
+  uint64_t k = 0;
+  while (k < n_samp) {
+    uint64_t end = (k < n_first_half) ? n_first_half : n_samp;
+    int n = static_cast<int>(std::min(end - k, max_block));
+    double kd = static_cast<double>(k);
+
+    // carrier rounded to the nearest table entry, code phase wrapped once per block
+    uint32_t carr_acc =
+        PhaseToFixed(rem_carr_phase + kd * d_carr) + (1u << (31 - FIXED_CARR_BITS));
+    double p0 = CodeReplica::WrapPhase(rem_code_phase + kd * d_code) + CodeReplica::PAD + 0.5;
+    uint32_t code_acc[3] = {
+        ChipsToFixed(p0 + t_space), ChipsToFixed(p0), ChipsToFixed(p0 - t_space)};
+#ifdef STURDR_SIMD_X86
+    if (use_avx2) {
+      ReplicaAvx2(rep, n, chips, carr_acc, carr_step, code_acc, code_step);
+    } else {
+      ReplicaGeneric(rep, n, chips, carr_acc, carr_step, code_acc, code_step);
+    }
+#else
+    ReplicaGeneric(rep, n, chips, carr_acc, carr_step, code_acc, code_step);
+#endif
+
+    // wipe off and accumulate every antenna against the same replicas
+    bool first_half = k < n_first_half;
+    for (std::size_t a = 0; a < n_ant; a++) {
+      const S *x;
+      if constexpr (sizeof(S) == 1) {
+        x = rfdata.Int8(static_cast<uint8_t>(a), ptr + k);
+      } else {
+        x = rfdata.Int16(static_cast<uint8_t>(a), ptr + k);
+      }
+      int32_t acc[6] = {0, 0, 0, 0, 0, 0};
+#ifdef STURDR_SIMD_X86
+      if (use_avx2) {
+        MacAvx2<S, IQ>(x, rep, n, acc);
+      } else {
+        MacGeneric<S, IQ>(x, rep, n, acc);
+      }
+#else
+      MacGeneric<S, IQ>(x, rep, n, acc);
+#endif
+      epl[a].IE += acc[0];
+      epl[a].QE += acc[1];
+      epl[a].IL += acc[4];
+      epl[a].QL += acc[5];
+      if (first_half) {
+        epl[a].IP1 += acc[2];
+        epl[a].QP1 += acc[3];
+      } else {
+        epl[a].IP2 += acc[2];
+        epl[a].QP2 += acc[3];
+      }
+    }
+    k += static_cast<uint64_t>(n);
+  }
+}
+
+// *=== AccumulateRing ===*
+// selects the block kernel matching the ring format
+void AccumulateRing(
+    const SampleRing &rfdata,
+    const uint64_t &ptr,
+    const uint64_t &n_samp,
+    const std::size_t &n_ant,
+    const CodeReplica &code,
+    double &rem_code_phase,
+    double &code_freq,
+    double &rem_carr_phase,
+    double &carr_freq,
+    double &carr_jit,
+    double &samp_freq,
+    uint64_t &half_samp,
+    uint64_t &samp_remaining,
+    double &t_space,
+    FixedEPL *epl) {
+  // init phase increments
+  double d_code = code_freq / samp_freq;
+  double d_carr = (carr_freq + 0.5 * carr_jit / samp_freq) / samp_freq;
+  uint64_t n_first_half =
+      (samp_remaining > half_samp) ? std::min(n_samp, samp_remaining - half_samp) : 0;
+
+  auto accumulate = [&](auto kernel) {
+    kernel(
+        rfdata,
+        ptr,
+        n_ant,
+        n_samp,
+        code,
+        rem_code_phase,
+        d_code,
+        rem_carr_phase,
+        d_carr,
+        n_first_half,
+        t_space,
+        epl);
+  };
+  switch (rfdata.Format()) {
+    case SampleFormat::INT8:
+      accumulate(AccumulateBlocks<int8_t, false>);
+      break;
+    case SampleFormat::INT16:
+      accumulate(AccumulateBlocks<int16_t, false>);
+      break;
+    case SampleFormat::CINT8:
+      accumulate(AccumulateBlocks<int8_t, true>);
+      break;
+    case SampleFormat::CINT16:
+      accumulate(AccumulateBlocks<int16_t, true>);
+      break;
+    default:
+      // complex double rings have no fixed-point representation
+      return;
+  }
+
+  // advance nco phases
+  rem_code_phase += static_cast<double>(n_samp) * d_code;
+  rem_carr_phase += static_cast<double>(n_samp) * d_carr;
+  samp_remaining -= n_samp;
+}
+
+}  // namespace
+
+// *=== WidenEPL ===*
+void WidenEPL(
+    FixedEPL &fixed,
+    std::complex<double> &E,
+    std::complex<double> &P1,
+    std::complex<double> &P2,
+    std::complex<double> &L) {
+  auto widen = [](const int64_t &i, const int64_t &q) {
+    return std::complex<double>(static_cast<double>(i), static_cast<double>(q)) /
+           static_cast<double>(FIXED_CARR_AMP);
+  };
+  E += widen(fixed.IE, fixed.QE);
+  P1 += widen(fixed.IP1, fixed.QP1);
+  P2 += widen(fixed.IP2, fixed.QP2);
+  L += widen(fixed.IL, fixed.QL);
+  fixed = FixedEPL();
+}
+
+// *=== AccumulateEPLFixed ===*
+void AccumulateEPLFixed(
+    const SampleRing &rfdata,
+    const uint64_t &ptr,
+    const uint64_t &n_samp,
+    const CodeReplica &code,
+    double &rem_code_phase,
+    double &code_freq,
+    double &rem_carr_phase,
+    double &carr_freq,
+    double &carr_jit,
+    double &samp_freq,
+    uint64_t &half_samp,
+    uint64_t &samp_remaining,
+    double &t_space,
+    FixedEPL &epl) {
+  AccumulateRing(
+      rfdata,
+      ptr,
+      n_samp,
+      1,
+      code,
+      rem_code_phase,
+      code_freq,
+      rem_carr_phase,
+      carr_freq,
+      carr_jit,
+      samp_freq,
+      half_samp,
+      samp_remaining,
+      t_space,
+      &epl);
+}
+void AccumulateEPLArrayFixed(
+    const SampleRing &rfdata,
+    const uint64_t &ptr,
+    const uint64_t &n_samp,
+    const CodeReplica &code,
+    double &rem_code_phase,
+    double &code_freq,
+    double &rem_carr_phase,
+    double &carr_freq,
+    double &carr_jit,
+    double &samp_freq,
+    uint64_t &half_samp,
+    uint64_t &samp_remaining,
+    double &t_space,
+    std::vector<FixedEPL> &epl) {
+  AccumulateRing(
+      rfdata,
+      ptr,
+      n_samp,
+      epl.size(),
+      code,
+      rem_code_phase,
+      code_freq,
+      rem_carr_phase,
+      carr_freq,
+      carr_jit,
+      samp_freq,
+      half_samp,
+      samp_remaining,
+      t_space,
+      epl.data());
+}
+
+}  // namespace sturdr
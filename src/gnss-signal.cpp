@@ -15,11 +15,42 @@
 
 #include "sturdr/gnss-signal.hpp"
 
+#include <algorithm>
 #include <cmath>
-#include <navtools/constants.hpp>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "sturdr/array-correlator.hpp"
+#include "sturdr/carrier-nco.hpp"
+#include "sturdr/simd-correlator.hpp"
 
 namespace sturdr {
 
+// number of carrier replica samples generated at a time by the correlators
+constexpr uint64_t NCO_BLOCK = 512;
+
+namespace {
+
+// *=== ReplicaOf ===*
+// chip tables of a bare code, the shared tables when it is a GPS L1 C/A code, otherwise the tables
+// of the last other code this thread correlated (rebuilt only when the code changes)
+const CodeReplica &ReplicaOf(const bool code[1023]) {
+  for (uint8_t prn = 1; prn <= 32; prn++) {
+    const CodeReplica &replica = GpsL1caReplica(prn);
+    if (std::equal(code, code + CodeReplica::LENGTH, replica.bits.begin())) {
+      return replica;
+    }
+  }
+  thread_local std::unique_ptr<CodeReplica> last;
+  if (!last || !std::equal(code, code + CodeReplica::LENGTH, last->bits.begin())) {
+    last = std::make_unique<CodeReplica>(code);
+  }
+  return *last;
+}
+
+}  // namespace
+
 // *=== CircShift ===*
 Eigen::VectorXcd CircShift(const Eigen::Ref<const Eigen::VectorXcd> &vec, int shift) {
   int n = vec.size();
@@ -44,7 +75,7 @@ Eigen::VectorXcd CircShift(const Eigen::Ref<const Eigen::VectorXcd> &vec, int sh
 // *=== AccumulateEPL ===*
 void AccumulateEPL(
     const Eigen::Ref<const Eigen::VectorXcd> &rfdata,
-    const bool code[1023],
+    const CodeReplica &code,
     double &rem_code_phase,
     double &code_freq,
     double &rem_carr_phase,
@@ -62,40 +93,183 @@ void AccumulateEPL(
   double d_code = code_freq / samp_freq;
   double d_carr = (carr_freq + 0.5 * carr_jit / samp_freq) / samp_freq;
 
+  // vectorized kernels (chosen at runtime from the cpu feature set)
+  if (GetSimdLevel() != SimdLevel::SCALAR) {
+    uint64_t n_samp = static_cast<uint64_t>(rfdata.size());
+    uint64_t n_first_half =
+        (samp_remaining > half_samp) ? std::min(n_samp, samp_remaining - half_samp) : 0;
+    AccumulateEPLSimd(
+        rfdata.data(),
+        n_samp,
+        code.f64_expanded.data(),
+        rem_code_phase,
+        d_code,
+        rem_carr_phase,
+        d_carr,
+        n_first_half,
+        t_space,
+        E,
+        P1,
+        P2,
+        L);
+    samp_remaining -= n_samp;
+    return;
+  }
+
   // loop through number of samples
+  CarrierNco nco(GetCarrierNcoMode());
+  std::complex<double> carr[NCO_BLOCK];
   std::complex<double> v_carr;
   double v_code;
-  for (const std::complex<double> &sample : rfdata) {
-    v_carr = std::exp(-navtools::COMPLEX_I<> * rem_carr_phase) * sample;
-
-    // early
-    // v_code = code[static_cast<int>(std::fmod(rem_code_phase + t_space, 1023.0))] ? 1.0 : -1.0;
-    v_code = code[static_cast<int>(std::round(rem_code_phase + t_space)) % 1023] ? 1.0 : -1.0;
-    E += (v_code * v_carr);
-
-    // late
-    // v_code = code[static_cast<int>(std::fmod(rem_code_phase - t_space, 1023.0))] ? 1.0 : -1.0;
-    v_code = code[static_cast<int>(std::round(rem_code_phase - t_space)) % 1023] ? 1.0 : -1.0;
-    L += (v_code * v_carr);
-
-    // prompt
-    // v_code = code[static_cast<int>(std::fmod(rem_code_phase, 1023.0))] ? 1.0 : -1.0;
-    v_code = code[static_cast<int>(std::round(rem_code_phase)) % 1023] ? 1.0 : -1.0;
-    if (samp_remaining > half_samp) {
-      P1 += (v_code * v_carr);
-    } else {
-      P2 += (v_code * v_carr);
+  uint64_t n_samp = static_cast<uint64_t>(rfdata.size());
+  for (uint64_t s = 0; s < n_samp; s += NCO_BLOCK) {
+    uint64_t n_block = std::min(NCO_BLOCK, n_samp - s);
+    nco.Generate(carr, n_block, rem_carr_phase, d_carr);
+    for (uint64_t k = 0; k < n_block; k++) {
+      v_carr = carr[k] * rfdata(s + k);
+
+      // early
+      // v_code = code[static_cast<int>(std::fmod(rem_code_phase + t_space, 1023.0))] ? 1.0 : -1.0;
+      v_code = code.bits[ChipIndex(rem_code_phase + t_space)] ? 1.0 : -1.0;
+      E += (v_code * v_carr);
+
+      // late
+      // v_code = code[static_cast<int>(std::fmod(rem_code_phase - t_space, 1023.0))] ? 1.0 : -1.0;
+      v_code = code.bits[ChipIndex(rem_code_phase - t_space)] ? 1.0 : -1.0;
+      L += (v_code * v_carr);
+
+      // prompt
+      // v_code = code[static_cast<int>(std::fmod(rem_code_phase, 1023.0))] ? 1.0 : -1.0;
+      v_code = code.bits[ChipIndex(rem_code_phase)] ? 1.0 : -1.0;
+      if (samp_remaining > half_samp) {
+        P1 += (v_code * v_carr);
+      } else {
+        P2 += (v_code * v_carr);
+      }
+
+      // increment
+      rem_code_phase += d_code;
+      samp_remaining--;
     }
+  }
+}
+void AccumulateEPL(
+    const Eigen::Ref<const Eigen::VectorXcd> &rfdata,
+    const bool code[1023],
+    double &rem_code_phase,
+    double &code_freq,
+    double &rem_carr_phase,
+    double &carr_freq,
+    double &carr_jit,
+    double &samp_freq,
+    uint64_t &half_samp,
+    uint64_t &samp_remaining,
+    double &t_space,
+    std::complex<double> &E,
+    std::complex<double> &P1,
+    std::complex<double> &P2,
+    std::complex<double> &L) {
+  AccumulateEPL(
+      rfdata,
+      ReplicaOf(code),
+      rem_code_phase,
+      code_freq,
+      rem_carr_phase,
+      carr_freq,
+      carr_jit,
+      samp_freq,
+      half_samp,
+      samp_remaining,
+      t_space,
+      E,
+      P1,
+      P2,
+      L);
+}
+void AccumulateEPL(
+    const SampleRing &rfdata,
+    const uint64_t &ptr,
+    const uint64_t &n_samp,
+    const CodeReplica &code,
+    double &rem_code_phase,
+    double &code_freq,
+    double &rem_carr_phase,
+    double &carr_freq,
+    double &carr_jit,
+    double &samp_freq,
+    uint64_t &half_samp,
+    uint64_t &samp_remaining,
+    double &t_space,
+    std::complex<double> &E,
+    std::complex<double> &P1,
+    std::complex<double> &P2,
+    std::complex<double> &L) {
+  if (rfdata.Format() == SampleFormat::CDOUBLE) {
+    AccumulateEPL(
+        rfdata.Matrix().col(0).segment(ptr, n_samp),
+        code,
+        rem_code_phase,
+        code_freq,
+        rem_carr_phase,
+        carr_freq,
+        carr_jit,
+        samp_freq,
+        half_samp,
+        samp_remaining,
+        t_space,
+        E,
+        P1,
+        P2,
+        L);
+    return;
+  }
 
-    // increment
-    rem_code_phase += d_code;
-    rem_carr_phase += d_carr;
-    samp_remaining--;
+  // native and single precision samples are always widened chunk by chunk inside the vectorized
+  // kernels, so the sums stay in double
+  double d_code = code_freq / samp_freq;
+  double d_carr = (carr_freq + 0.5 * carr_jit / samp_freq) / samp_freq;
+  uint64_t n_first_half =
+      (samp_remaining > half_samp) ? std::min(n_samp, samp_remaining - half_samp) : 0;
+  CarrierNco nco(GetCarrierNcoMode(), NCO_BLOCK);
+  auto accumulate = [&](const auto *x) {
+    AccumulateEPLSimd(
+        nco,
+        x,
+        n_samp,
+        code.f64_expanded.data(),
+        rem_code_phase,
+        d_code,
+        rem_carr_phase,
+        d_carr,
+        n_first_half,
+        t_space,
+        E,
+        P1,
+        P2,
+        L);
+  };
+  switch (rfdata.Format()) {
+    case SampleFormat::INT8:
+      accumulate(rfdata.Int8(0, ptr));
+      break;
+    case SampleFormat::INT16:
+      accumulate(rfdata.Int16(0, ptr));
+      break;
+    case SampleFormat::CINT8:
+      accumulate(reinterpret_cast<const std::complex<int8_t> *>(rfdata.Int8(0, ptr)));
+      break;
+    case SampleFormat::CINT16:
+      accumulate(reinterpret_cast<const std::complex<int16_t> *>(rfdata.Int16(0, ptr)));
+      break;
+    default:
+      accumulate(rfdata.MatrixF().col(0).data() + ptr);
+      break;
   }
+  samp_remaining -= n_samp;
 }
 void AccumulateEPLArray(
     const Eigen::Ref<const Eigen::MatrixXcd> &rfdata,
-    const bool code[1023],
+    const CodeReplica &code,
     double &rem_code_phase,
     double &code_freq,
     double &rem_carr_phase,
@@ -112,46 +286,110 @@ void AccumulateEPLArray(
   // init phase increments
   double d_code = code_freq / samp_freq;
   double d_carr = (carr_freq + 0.5 * carr_jit / samp_freq) / samp_freq;
+  uint64_t n_samp = static_cast<uint64_t>(rfdata.rows());
+  uint64_t n_first_half =
+      (samp_remaining > half_samp) ? std::min(n_samp, samp_remaining - half_samp) : 0;
 
-  // loop through number of samples
-  int n_samp = rfdata.rows();
-  int n_ant = rfdata.cols();
-  Eigen::VectorXcd v_carr(n_ant);
-  // std::complex<double> v_carr;
-  double v_code;
-  for (int ii = 0; ii < n_samp; ii++) {
-    // for (const std::complex<double> &sample : rfdata.col(0)) {
-    v_carr = std::exp(-navtools::COMPLEX_I<> * rem_carr_phase) * rfdata.row(ii);
-    // v_carr = std::exp(-navtools::COMPLEX_I<> * rem_carr_phase) * sample;
-
-    // early
-    // v_code = code[static_cast<int>(std::fmod(rem_code_phase + t_space, 1023.0))] ? 1.0 : -1.0;
-    v_code = code[static_cast<int>(std::round(rem_code_phase + t_space)) % 1023] ? 1.0 : -1.0;
-    E += (v_code * v_carr);
-    // E += (v_code * v_carr);
-
-    // late
-    // v_code = code[static_cast<int>(std::fmod(rem_code_phase - t_space, 1023.0))] ? 1.0 : -1.0;
-    v_code = code[static_cast<int>(std::round(rem_code_phase - t_space)) % 1023] ? 1.0 : -1.0;
-    L += (v_code * v_carr);
-    // L += (v_code * v_carr);
-
-    // prompt
-    // v_code = code[static_cast<int>(std::fmod(rem_code_phase, 1023.0))] ? 1.0 : -1.0;
-    v_code = code[static_cast<int>(std::round(rem_code_phase)) % 1023] ? 1.0 : -1.0;
-    if (samp_remaining > half_samp) {
-      P1 += (v_code * v_carr);
-      // P1(0) += (v_code * v_carr);
-    } else {
-      P2 += (v_code * v_carr);
-      // P2(0) += (v_code * v_carr);
-    }
+  // correlate every antenna column against one replica
+  int n_ant = static_cast<int>(rfdata.cols());
+  std::vector<const std::complex<double> *> cols(n_ant);
+  for (int a = 0; a < n_ant; a++) {
+    cols[a] = rfdata.col(a).data();
+  }
+  CarrierNco nco(GetCarrierNcoMode(), NCO_BLOCK);
+  AccumulateEPLArraySoa(
+      nco,
+      cols.data(),
+      n_ant,
+      n_samp,
+      code.f64_expanded.data(),
+      rem_code_phase,
+      d_code,
+      rem_carr_phase,
+      d_carr,
+      n_first_half,
+      t_space,
+      E.data(),
+      P1.data(),
+      P2.data(),
+      L.data());
+  samp_remaining -= n_samp;
+}
+void AccumulateEPLArray(
+    const SampleRing &rfdata,
+    const uint64_t &ptr,
+    const uint64_t &n_samp,
+    const CodeReplica &code,
+    double &rem_code_phase,
+    double &code_freq,
+    double &rem_carr_phase,
+    double &carr_freq,
+    double &carr_jit,
+    double &samp_freq,
+    uint64_t &half_samp,
+    uint64_t &samp_remaining,
+    double &t_space,
+    Eigen::Ref<Eigen::VectorXcd> E,
+    Eigen::Ref<Eigen::VectorXcd> P1,
+    Eigen::Ref<Eigen::VectorXcd> P2,
+    Eigen::Ref<Eigen::VectorXcd> L) {
+  // init phase increments
+  double d_code = code_freq / samp_freq;
+  double d_carr = (carr_freq + 0.5 * carr_jit / samp_freq) / samp_freq;
+  uint64_t n_first_half =
+      (samp_remaining > half_samp) ? std::min(n_samp, samp_remaining - half_samp) : 0;
 
-    // increment
-    rem_code_phase += d_code;
-    rem_carr_phase += d_carr;
-    samp_remaining--;
+  // every storage format is read straight from the ring, one column per antenna
+  int n_ant = static_cast<int>(rfdata.Cols());
+  CarrierNco nco(GetCarrierNcoMode(), NCO_BLOCK);
+  auto accumulate = [&](auto col) {
+    using T = std::remove_const_t<std::remove_pointer_t<decltype(col(0))>>;
+    std::vector<const T *> cols(n_ant);
+    for (int a = 0; a < n_ant; a++) {
+      cols[a] = col(static_cast<uint8_t>(a));
+    }
+    AccumulateEPLArraySoa(
+        nco,
+        cols.data(),
+        n_ant,
+        n_samp,
+        code.f64_expanded.data(),
+        rem_code_phase,
+        d_code,
+        rem_carr_phase,
+        d_carr,
+        n_first_half,
+        t_space,
+        E.data(),
+        P1.data(),
+        P2.data(),
+        L.data());
+  };
+  switch (rfdata.Format()) {
+    case SampleFormat::INT8:
+      accumulate([&](const uint8_t &a) { return rfdata.Int8(a, ptr); });
+      break;
+    case SampleFormat::INT16:
+      accumulate([&](const uint8_t &a) { return rfdata.Int16(a, ptr); });
+      break;
+    case SampleFormat::CINT8:
+      accumulate([&](const uint8_t &a) {
+        return reinterpret_cast<const std::complex<int8_t> *>(rfdata.Int8(a, ptr));
+      });
+      break;
+    case SampleFormat::CINT16:
+      accumulate([&](const uint8_t &a) {
+        return reinterpret_cast<const std::complex<int16_t> *>(rfdata.Int16(a, ptr));
+      });
+      break;
+    case SampleFormat::CFLOAT:
+      accumulate([&](const uint8_t &a) { return rfdata.MatrixF().col(a).data() + ptr; });
+      break;
+    default:
+      accumulate([&](const uint8_t &a) { return rfdata.Matrix().col(a).data() + ptr; });
+      break;
   }
+  samp_remaining -= n_samp;
 }
 
 //* === Correlate ===*
@@ -176,16 +414,22 @@ void Correlate(
   double d_carr = (carr_freq + 0.5 * carr_jit / samp_freq) / samp_freq;
 
   // loop through number of samples
+  CarrierNco nco(GetCarrierNcoMode());
+  std::complex<double> carr[NCO_BLOCK];
   std::complex<double> v_carr;
   double v_code;
-  for (const std::complex<double> &sample : rfdata) {
-    v_carr = std::exp(-navtools::COMPLEX_I<> * rem_carr_phase) * sample;
-    v_code = code[static_cast<int>(std::round(rem_code_phase)) % 1023] ? 1.0 : -1.0;
-    C += (v_code * v_carr);
-
-    // increment
-    rem_code_phase += d_code;
-    rem_carr_phase += d_carr;
+  uint64_t n_samp = static_cast<uint64_t>(rfdata.size());
+  for (uint64_t s = 0; s < n_samp; s += NCO_BLOCK) {
+    uint64_t n_block = std::min(NCO_BLOCK, n_samp - s);
+    nco.Generate(carr, n_block, rem_carr_phase, d_carr);
+    for (uint64_t k = 0; k < n_block; k++) {
+      v_carr = carr[k] * rfdata(s + k);
+      v_code = code[ChipIndex(rem_code_phase)] ? 1.0 : -1.0;
+      C += (v_code * v_carr);
+
+      // increment
+      rem_code_phase += d_code;
+    }
   }
 }
 
@@ -226,10 +470,8 @@ Eigen::VectorXcd CarrierNCO(
   double d_carr = (carr_freq + 0.5 * carr_jit / samp_freq) / samp_freq;
 
   // upsample
-  for (uint64_t i = 0; i < n_samp; i++) {
-    carr_up(i) = std::exp(-navtools::COMPLEX_I<> * rem_phase);
-    rem_phase += d_carr;
-  }
+  CarrierNco nco(GetCarrierNcoMode());
+  nco.Generate(carr_up.data(), n_samp, rem_phase, d_carr);
 
   return carr_up;
 }
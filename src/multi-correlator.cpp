@@ -0,0 +1,260 @@
+/**
+ * *multi-correlator.cpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/multi-correlator.cpp
+ * @brief   Bank of N evenly spaced code correlators sharing one carrier wipeoff.
+ * @date    October 2026
+ * @ref     1. "Understanding GPS/GNSS Principles and Applications", 3rd Edition, 2017
+ *              - Kaplan & Hegarty
+ *          2. "Intel 64 and IA-32 Architectures Optimization Reference Manual", 2023 - Intel
+ * =======  ========================================================================================
+ */
+
+#include "sturdr/multi-correlator.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "sturdr/data-type-adapters.hpp"
+#include "sturdr/simd-correlator.hpp"
+
+#ifdef STURDR_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace sturdr {
+
+namespace {
+
+// *=== TapGeneric ===*
+// one tap over a wiped block, 'base' already holds the tap offset and the table padding
+void TapGeneric(
+    const double *wr,
+    const double *wi,
+    const int &n,
+    const double *code,
+    const double &base,
+    const double &d_code,
+    double &re,
+    double &im) {
+  double sr = 0.0, si = 0.0;
+  for (int k = 0; k < n; k++) {
+    double c = code[static_cast<int>(base + static_cast<double>(k) * d_code)];
+    sr += c * wr[k];
+    si += c * wi[k];
+  }
+  re += sr;
+  im += si;
+}
+
+#ifdef STURDR_SIMD_X86
+
+// *=== TapAvx2 ===*
+// four samples per iteration, chips fetched with a single gather
+__attribute__((target("avx2,fma"))) void TapAvx2(
+    const double *wr,
+    const double *wi,
+    const int &n,
+    const double *code,
+    const double &base,
+    const double &d_code,
+    double &re,
+    double &im) {
+  const __m256d v_base = _mm256_set1_pd(base);
+  const __m256d v_d = _mm256_set1_pd(d_code);
+  const __m256d four = _mm256_set1_pd(4.0);
+  __m256d v_k = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+  __m256d sr = _mm256_setzero_pd();
+  __m256d si = _mm256_setzero_pd();
+
+  int k = 0;
+  for (; k + 4 <= n; k += 4) {
+    __m128i idx = _mm256_cvttpd_epi32(_mm256_fmadd_pd(v_k, v_d, v_base));
+    __m256d c = _mm256_i32gather_pd(code, idx, 8);
+    sr = _mm256_fmadd_pd(c, _mm256_loadu_pd(wr + k), sr);
+    si = _mm256_fmadd_pd(c, _mm256_loadu_pd(wi + k), si);
+    v_k = _mm256_add_pd(v_k, four);
+  }
+
+  alignas(32) double tmp_r[4], tmp_i[4];
+  _mm256_store_pd(tmp_r, sr);
+  _mm256_store_pd(tmp_i, si);
+  re += (tmp_r[0] + tmp_r[1]) + (tmp_r[2] + tmp_r[3]);
+  im += (tmp_i[0] + tmp_i[1]) + (tmp_i[2] + tmp_i[3]);
+
+  // remaining samples
+  TapGeneric(
+      wr + k, wi + k, n - k, code, base + static_cast<double>(k) * d_code, d_code, re, im);
+}
+
+#endif
+
+// *=== Tap ===*
+// routes a tap to the kernel of the requested SIMD level
+void Tap(
+    const SimdLevel::SimdLevel &level,
+    const double *wr,
+    const double *wi,
+    const int &n,
+    const double *code,
+    const double &base,
+    const double &d_code,
+    double &re,
+    double &im) {
+#ifdef STURDR_SIMD_X86
+  if (level >= SimdLevel::AVX2) {
+    TapAvx2(wr, wi, n, code, base, d_code, re, im);
+    return;
+  }
+#endif
+  TapGeneric(wr, wi, n, code, base, d_code, re, im);
+}
+
+}  // namespace
+
+// *=== MultiCorrelator ===*
+MultiCorrelator::MultiCorrelator(const uint16_t &n_taps, const double &span)
+    : offsets_(std::max<uint16_t>(n_taps, 1), 0.0),
+      acc_re_(offsets_.size(), 0.0),
+      acc_im_(offsets_.size(), 0.0),
+      nco_{CarrierNco(GetCarrierNcoMode(), BLOCK)} {
+  double s = std::clamp(span, 0.0, MAX_SPAN);
+  int n = static_cast<int>(offsets_.size());
+  for (int t = 0; t < n && n > 1; t++) {
+    offsets_[t] = -s + 2.0 * s * static_cast<double>(t) / static_cast<double>(n - 1);
+  }
+}
+
+// *=== Accumulate ===*
+void MultiCorrelator::Accumulate(
+    const SampleRing &rfdata,
+    const uint64_t &ptr,
+    const uint64_t &n_samp,
+    const CodeReplica &code,
+    const double &rem_code_phase,
+    const double &code_freq,
+    const double &rem_carr_phase,
+    const double &carr_freq,
+    const double &carr_jit,
+    const double &samp_freq) {
+  // same phase increments as AccumulateEPL
+  double d_code = code_freq / samp_freq;
+  double d_carr = (carr_freq + 0.5 * carr_jit / samp_freq) / samp_freq;
+  const double *table = code.f64_expanded.data();
+
+  switch (rfdata.Format()) {
+    case SampleFormat::INT8:
+      AccumulateBlocks(
+          rfdata.Int8(0, ptr), n_samp, table, rem_code_phase, d_code, rem_carr_phase, d_carr);
+      break;
+    case SampleFormat::INT16:
+      AccumulateBlocks(
+          rfdata.Int16(0, ptr), n_samp, table, rem_code_phase, d_code, rem_carr_phase, d_carr);
+      break;
+    case SampleFormat::CINT8:
+      AccumulateBlocks(
+          reinterpret_cast<const std::complex<int8_t> *>(rfdata.Int8(0, ptr)),
+          n_samp,
+          table,
+          rem_code_phase,
+          d_code,
+          rem_carr_phase,
+          d_carr);
+      break;
+    case SampleFormat::CINT16:
+      AccumulateBlocks(
+          reinterpret_cast<const std::complex<int16_t> *>(rfdata.Int16(0, ptr)),
+          n_samp,
+          table,
+          rem_code_phase,
+          d_code,
+          rem_carr_phase,
+          d_carr);
+      break;
+    case SampleFormat::CFLOAT:
+      AccumulateBlocks(
+          rfdata.MatrixF().col(0).data() + ptr,
+          n_samp,
+          table,
+          rem_code_phase,
+          d_code,
+          rem_carr_phase,
+          d_carr);
+      break;
+    default:
+      AccumulateBlocks(
+          rfdata.Matrix().col(0).data() + ptr,
+          n_samp,
+          table,
+          rem_code_phase,
+          d_code,
+          rem_carr_phase,
+          d_carr);
+      break;
+  }
+}
+
+// *=== Dump ===*
+void MultiCorrelator::Dump(Eigen::VectorXcd &taps) {
+  int n = static_cast<int>(offsets_.size());
+  taps.resize(n);
+  for (int t = 0; t < n; t++) {
+    taps(t) = std::complex<double>(acc_re_[t], acc_im_[t]);
+  }
+  std::fill(acc_re_.begin(), acc_re_.end(), 0.0);
+  std::fill(acc_im_.begin(), acc_im_.end(), 0.0);
+}
+
+// *=== AccumulateBlocks ===*
+template <typename T>
+void MultiCorrelator::AccumulateBlocks(
+    const T *rfdata,
+    const uint64_t &n_samp,
+    const double *code,
+    const double &rem_code_phase,
+    const double &d_code,
+    const double &rem_carr_phase,
+    const double &d_carr) {
+  SimdLevel::SimdLevel level = GetSimdLevel();
+  alignas(64) std::complex<double> carr[BLOCK];
+  alignas(64) std::complex<double> wide[BLOCK];
+  alignas(64) double wr[BLOCK];
+  alignas(64) double wi[BLOCK];
+
+  uint64_t max_block = std::min<uint64_t>(BLOCK, CodeReplica::MaxBlockLength(d_code));
+  int n_taps = static_cast<int>(offsets_.size());
+  for (uint64_t k = 0; k < n_samp; k += max_block) {
+    int n = static_cast<int>(std::min(max_block, n_samp - k));
+    double kd = static_cast<double>(k);
+    double carr_phase = rem_carr_phase + kd * d_carr;
+    nco_.Generate(carr, static_cast<uint64_t>(n), carr_phase, d_carr);
+
+    // compact samples are widened to double while the block is still in L1
+    const std::complex<double> *x;
+    if constexpr (std::is_same_v<T, std::complex<double>>) {
+      x = rfdata + k;
+    } else if constexpr (std::is_arithmetic_v<T>) {
+      TypeToIDouble<T>(rfdata + k, wide, n);
+      x = wide;
+    } else {
+      ITypeToIDouble<typename T::value_type>(rfdata + k, wide, n);
+      x = wide;
+    }
+
+    // one carrier wipeoff shared by every tap
+    for (int i = 0; i < n; i++) {
+      wr[i] = x[i].real() * carr[i].real() - x[i].imag() * carr[i].imag();
+      wi[i] = x[i].real() * carr[i].imag() + x[i].imag() * carr[i].real();
+    }
+
+    // every tap reads the same expanded chip table at its own offset
+    double p0 = CodeReplica::WrapPhase(rem_code_phase + kd * d_code) +
+                (static_cast<double>(CodeReplica::PAD) + 0.5);
+    for (int t = 0; t < n_taps; t++) {
+      Tap(level, wr, wi, n, code, p0 + offsets_[t], d_code, acc_re_[t], acc_im_[t]);
+    }
+  }
+}
+
+}  // namespace sturdr
@@ -40,7 +40,10 @@ namespace sturdr {
 
 // *=== Navigator ===*
 Navigator::Navigator(
-    Config &conf, std::shared_ptr<ConcurrentQueue> queue, std::shared_ptr<bool> running)
+    Config &conf,
+    std::shared_ptr<ConcurrentQueue> queue,
+    std::shared_ptr<bool> running,
+    std::shared_ptr<AcquisitionAiding> acq_aiding)
     : conf_{conf},
       file_size_{conf.general.ms_chunk_size * (uint64_t)conf.rfsignal.samp_freq / 1000},
       nav_file_ptr_{0},
@@ -51,6 +54,8 @@ Navigator::Navigator(
       running_{running},
       week_{65535},
       receive_time_{std::nan("1")},
+      acq_aiding_{acq_aiding},
+      aid_time_{std::nan("1")},
       log_{spdlog::get("sturdr-console")},
       nav_log_{std::make_shared<std::ofstream>(
           conf_.general.out_folder + "/" + conf_.general.scenario + "/Navigation_Log.bin",
@@ -172,6 +177,11 @@ void Navigator::NavUpdate() {
 void Navigator::ChannelUpdate(ChannelNavPacket &msg) {
   std::unique_lock<std::mutex> lock(*msg.mtx);
   if (ch_data_.find(msg.Header.ChannelNum) != ch_data_.end()) {
+    // a channel that moved to another satellite waits for that satellite's ephemeris
+    if (ch_data_[msg.Header.ChannelNum].Header.SVID != msg.Header.SVID) {
+      ch_data_[msg.Header.ChannelNum].HasEphem = false;
+    }
+
     // update map data
     ch_data_[msg.Header.ChannelNum].Header = msg.Header;
     ch_data_[msg.Header.ChannelNum].FilePtr = msg.FilePtr;
@@ -242,8 +252,9 @@ void Navigator::ChannelUpdate(ChannelNavPacket &msg) {
     n_ch_++;
   }
 
-  // notify completion
-  if (is_vector_) {
+  // notify completion, a scalar channel (one that lost lock during vector tracking) is answered
+  // at once and may have been the one the vector update was waiting for
+  if (is_vector_ && *msg.is_vector) {
     ch_data_[msg.Header.ChannelNum].ReadyForVT = true;
     // log_->warn(
     //     "ReadyForVT = [{}, {}, {}, {}, {}, {}, {}, {}, {}, {}]",
@@ -265,6 +276,9 @@ void Navigator::ChannelUpdate(ChannelNavPacket &msg) {
   } else {
     *msg.update_complete = true;
     msg.cv->notify_all();
+    if (is_vector_) {
+      VectorUpdate();
+    }
   }
 }
 
@@ -277,12 +291,18 @@ void Navigator::EphemUpdate(ChannelEphemPacket &msg) {
   } else {
     // add new item to map
     ChannelNavData tmp;
+    tmp.Header = msg.Header;
     tmp.HasEphem = true;
     tmp.Sv = satutils::KeplerEphem<double>(msg.Eph);
     ch_data_.insert({msg.Header.ChannelNum, tmp});
     n_ch_++;
   }
 
+  // share with acquisition
+  if (acq_aiding_) {
+    acq_aiding_->SetEphemeris(msg.Header.SVID, msg.Eph);
+  }
+
   // log ephemeris
   eph_log_->write(reinterpret_cast<char *>(&msg.Header.SVID), sizeof(uint8_t));
   eph_log_->write(reinterpret_cast<char *>(&msg.Eph), sizeof(satutils::KeplerElements<double>));
@@ -290,11 +310,12 @@ void Navigator::EphemUpdate(ChannelEphemPacket &msg) {
 
 // *=== ScalarUpdate ===*
 void Navigator::ScalarUpdate() {
-  // make sure enough channels have good data
+  // make sure enough channels have good data (a channel reacquiring after a loss of lock has no
+  // time of week until its data bits are decoded again)
   std::vector<uint8_t> good_sv;
   uint8_t num_sv = 0;
   for (const std::pair<const uint8_t, sturdr::ChannelNavData> &it : ch_data_) {
-    if (it.second.HasData && it.second.HasEphem) {
+    if (it.second.HasData && it.second.HasEphem && !std::isnan(it.second.ToW)) {
       good_sv.push_back(it.first);
       num_sv++;
     }
@@ -553,16 +574,35 @@ void Navigator::ScalarUpdate() {
   //             << " | " << sv_vel(0, i) << ", " << sv_vel(1, i) << ", " << sv_vel(2, i) << "\n";
   // }
 
+  // refresh acquisition predictions
+  AidingUpdate();
+
   // log result
   LogNavData();
 }
 
+// *=== AidingUpdate ===*
+void Navigator::AidingUpdate() {
+  // satellite geometry changes slowly, predicting once a second is plenty
+  if (!acq_aiding_ || (!std::isnan(aid_time_) && std::abs(receive_time_ - aid_time_) < 1.0)) {
+    return;
+  }
+  aid_time_ = receive_time_;
+
+  Eigen::Vector3d lla = Eigen::Vector3d{kf_.phi_, kf_.lam_, kf_.h_};
+  Eigen::Vector3d nedv = Eigen::Vector3d{kf_.vn_, kf_.ve_, kf_.vd_};
+  Eigen::Vector3d xyz = navtools::lla2ecef<double>(lla);
+  Eigen::Vector3d xyzv = navtools::ecef2nedDcm<double>(lla).transpose() * nedv;
+  acq_aiding_->Predict(receive_time_, xyz, xyzv, kf_.cd_);
+}
+
 // *=== VectorUpdate ===*
 bool Navigator::VectorUpdate() {
-  // make sure all channels have arrived
+  // make sure all vector tracked channels have arrived
   std::vector<std::pair<uint64_t, uint8_t>> sample_ptrs;
   for (uint8_t i = 1; i <= (uint8_t)ch_data_.size(); i++) {
     // log_->error("{}", ch_data_[i].ReadyForVT);
+    if (!*ch_data_[i].is_vector) continue;
     if (!ch_data_[i].ReadyForVT) return false;
     // sample_ptrs.push_back({(it.second.FilePtr + nav_file_ptr_) % file_size_, it.first});
     sample_ptrs.push_back({(ch_data_[i].FilePtr + nav_file_ptr_), i});
@@ -579,6 +619,7 @@ bool Navigator::VectorUpdate() {
   //     sample_ptrs[7].first,
   //     sample_ptrs[8].first,
   //     sample_ptrs[9].first);
+  if (sample_ptrs.empty()) return false;
 
   // known constants
   double intmd_freq_rad = navtools::TWO_PI<> * conf_.rfsignal.intmd_freq;
@@ -618,12 +659,16 @@ bool Navigator::VectorUpdate() {
     }
   }
 
+  // refresh acquisition predictions
+  AidingUpdate();
+
   // log solution only after finished
   LogNavData();
 
-  // tell channels to continue
+  // tell channels to continue (scalar channels were answered when their packet arrived)
   // log_->warn("notifying complete ...");
   for (auto &it : ch_data_) {
+    if (!*it.second.is_vector) continue;
     it.second.ReadyForVT = false;
     *it.second.update_complete = true;
     it.second.cv->notify_all();
@@ -0,0 +1,335 @@
+/**
+ * *packed-correlator.cpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/packed-correlator.cpp
+ * @brief   Bit-packed early/prompt/late correlators for 1-bit and 2-bit front ends.
+ * @date    October 2026
+ * @ref     1. "Understanding GPS/GNSS Principles and Applications", 3rd Edition, 2017
+ *              - Kaplan & Hegarty
+ *          2. "Global Positioning System: Signals, Measurements, and Performance", 2nd Edition,
+ *              2006 - Misra & Enge
+ * =======  ========================================================================================
+ */
+
+#include "sturdr/packed-correlator.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include "sturdr/simd-correlator.hpp"
+
+#ifdef STURDR_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace sturdr {
+
+namespace {
+
+constexpr int PACKED_WORDS = static_cast<int>(PACKED_BLOCK / 64);
+
+/**
+ * @brief Sign patterns of one block, shared by every antenna: bit set where the carrier cosine,
+ *        carrier sine or the chip of each tap is negative
+ */
+struct PackedReplica {
+  uint64_t cos[PACKED_WORDS];
+  uint64_t sin[PACKED_WORDS];
+  uint64_t code[3][PACKED_WORDS];
+};
+
+// *=== ReplicaGeneric ===*
+// sign bits of samples [i0, n) from 32-bit phase accumulators, 'code_acc' = {early, prompt, late}
+void ReplicaGeneric(
+    PackedReplica &rep,
+    const int &i0,
+    const int &n,
+    const float *chips,
+    const uint32_t &carr_acc,
+    const uint32_t &carr_step,
+    const uint32_t code_acc[3],
+    const uint32_t &code_step) {
+  for (int i = i0; i < n; i++) {
+    uint32_t ui = static_cast<uint32_t>(i);
+    uint32_t phase = carr_acc + ui * carr_step;
+    uint64_t bit = 1ULL << (i & 63);
+    int w = i >> 6;
+    rep.sin[w] |= (phase >> 31) ? bit : 0;
+    rep.cos[w] |= ((phase + (1u << 30)) >> 31) ? bit : 0;
+    for (int j = 0; j < 3; j++) {
+      rep.code[j][w] |= (chips[(code_acc[j] + ui * code_step) >> CODE_FRAC_BITS] < 0.0f) ? bit : 0;
+    }
+  }
+}
+
+#ifdef STURDR_SIMD_X86
+
+// *=== ReplicaAvx2 ===*
+// eight samples per iteration, sign bits collected with movemask (chips fetched with a gather)
+__attribute__((target("avx2"))) void ReplicaAvx2(
+    PackedReplica &rep,
+    const int &n,
+    const float *chips,
+    const uint32_t &carr_acc,
+    const uint32_t &carr_step,
+    const uint32_t code_acc[3],
+    const uint32_t &code_step) {
+  const __m256i lane = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+  const __m256i quarter = _mm256_set1_epi32(1 << 30);
+  __m256i carr = _mm256_add_epi32(
+      _mm256_set1_epi32(static_cast<int32_t>(carr_acc)),
+      _mm256_mullo_epi32(lane, _mm256_set1_epi32(static_cast<int32_t>(carr_step))));
+  __m256i code_offset =
+      _mm256_mullo_epi32(lane, _mm256_set1_epi32(static_cast<int32_t>(code_step)));
+  __m256i code[3];
+  for (int j = 0; j < 3; j++) {
+    code[j] = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int32_t>(code_acc[j])), code_offset);
+  }
+  const __m256i carr_inc = _mm256_set1_epi32(static_cast<int32_t>(8u * carr_step));
+  const __m256i code_inc = _mm256_set1_epi32(static_cast<int32_t>(8u * code_step));
+
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    int w = i >> 6, shift = i & 63;
+    uint64_t s = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(carr)));
+    uint64_t c = static_cast<uint32_t>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_add_epi32(carr, quarter))));
+    rep.sin[w] |= s << shift;
+    rep.cos[w] |= c << shift;
+    for (int j = 0; j < 3; j++) {
+      __m256 v = _mm256_i32gather_ps(chips, _mm256_srli_epi32(code[j], CODE_FRAC_BITS), 4);
+      rep.code[j][w] |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_ps(v)))
+                        << shift;
+      code[j] = _mm256_add_epi32(code[j], code_inc);
+    }
+    carr = _mm256_add_epi32(carr, carr_inc);
+  }
+
+  // remaining samples
+  ReplicaGeneric(rep, i, n, chips, carr_acc, carr_step, code_acc, code_step);
+}
+
+#endif
+
+// *=== LoadWord ===*
+// 64 samples of a bit plane starting at sample 'k' (the guard word keeps the second load valid)
+inline uint64_t LoadWord(const uint64_t *plane, const uint64_t &k) {
+  uint64_t w = k >> 6, b = k & 63;
+  return (b == 0) ? plane[w] : ((plane[w] >> b) | (plane[w + 1] << (64 - b)));
+}
+
+// *=== SignedSum ===*
+// sum over the valid samples of (1 + 2*m) * (-1)^x, 'm' already masked to the valid samples
+inline int64_t SignedSum(
+    const uint64_t &x, const uint64_t &m, const int64_t &n_valid, const int64_t &n_mag) {
+  return n_valid + 2 * n_mag - 2 * std::popcount(x) - 4 * std::popcount(m & x);
+}
+
+// *=== Mac ===*
+// correlates one antenna against the block patterns, acc = {IE, QE, IP, QP, IL, QL}
+template <bool IQ>
+void Mac(
+    const SampleRing &rfdata,
+    const uint8_t &ant,
+    const uint64_t &k0,
+    const PackedReplica &rep,
+    const int &n,
+    int64_t acc[6]) {
+  const uint64_t *s_i = rfdata.BitPlane(PackedPlane::I_SIGN, ant);
+  const uint64_t *m_i = rfdata.BitPlane(PackedPlane::I_MAG, ant);
+  const uint64_t *s_q = rfdata.BitPlane(PackedPlane::Q_SIGN, ant);
+  const uint64_t *m_q = rfdata.BitPlane(PackedPlane::Q_MAG, ant);
+  for (int w = 0; w * 64 < n; w++) {
+    int n_valid = std::min(64, n - 64 * w);
+    uint64_t valid = (n_valid == 64) ? ~0ULL : ((1ULL << n_valid) - 1);
+    uint64_t k = k0 + static_cast<uint64_t>(64 * w);
+
+    // I*cos and I*sin sign patterns (Re += I*cos, Im -= I*sin)
+    uint64_t mi = LoadWord(m_i, k) & valid;
+    uint64_t si = LoadWord(s_i, k);
+    uint64_t i_cos = (si ^ rep.cos[w]) & valid;
+    uint64_t i_sin = (si ^ rep.sin[w]) & valid;
+    int64_t n_mi = std::popcount(mi);
+
+    // Q*sin and Q*cos sign patterns (Re += Q*sin, Im += Q*cos)
+    uint64_t mq = 0, q_sin = 0, q_cos = 0;
+    int64_t n_mq = 0;
+    if constexpr (IQ) {
+      mq = LoadWord(m_q, k) & valid;
+      uint64_t sq = LoadWord(s_q, k);
+      q_sin = (sq ^ rep.sin[w]) & valid;
+      q_cos = (sq ^ rep.cos[w]) & valid;
+      n_mq = std::popcount(mq);
+    }
+
+    for (int j = 0; j < 3; j++) {
+      uint64_t c = rep.code[j][w] & valid;
+      acc[2 * j] += SignedSum(i_cos ^ c, mi, n_valid, n_mi);
+      acc[2 * j + 1] -= SignedSum(i_sin ^ c, mi, n_valid, n_mi);
+      if constexpr (IQ) {
+        acc[2 * j] += SignedSum(q_sin ^ c, mq, n_valid, n_mq);
+        acc[2 * j + 1] += SignedSum(q_cos ^ c, mq, n_valid, n_mq);
+      }
+    }
+  }
+}
+
+// *=== AccumulateRing ===*
+// walks the integration in blocks sharing one set of sign patterns across antennas
+void AccumulateRing(
+    const SampleRing &rfdata,
+    const uint64_t &ptr,
+    const uint64_t &n_samp,
+    const std::size_t &n_ant,
+    const CodeReplica &code,
+    double &rem_code_phase,
+    double &code_freq,
+    double &rem_carr_phase,
+    double &carr_freq,
+    double &carr_jit,
+    double &samp_freq,
+    uint64_t &half_samp,
+    uint64_t &samp_remaining,
+    double &t_space,
+    FixedEPL *epl) {
+  if (!rfdata.IsPacked()) {
+    return;
+  }
+
+  // init phase increments
+  double d_code = code_freq / samp_freq;
+  double d_carr = (carr_freq + 0.5 * carr_jit / samp_freq) / samp_freq;
+  uint64_t n_first_half =
+      (samp_remaining > half_samp) ? std::min(n_samp, samp_remaining - half_samp) : 0;
+
+#ifdef STURDR_SIMD_X86
+  bool use_avx2 = GetSimdLevel() >= SimdLevel::AVX2;
+#endif
+  bool iq = rfdata.IsComplex();
+  const float *chips = code.f32_expanded.data();
+  uint64_t max_block = std::min<uint64_t>(PACKED_BLOCK, CodeReplica::MaxBlockLength(d_code));
+  uint32_t carr_step = PhaseToFixed(d_carr);
+  uint32_t code_step = ChipsToFixed(d_code);
+
+  uint64_t k = 0;
+  while (k < n_samp) {
+    uint64_t end = (k < n_first_half) ? n_first_half : n_samp;
+    int n = static_cast<int>(std::min(end - k, max_block));
+    double kd = static_cast<double>(k);
+
+    // carrier and code sign patterns of this block
+    PackedReplica rep = {};
+    uint32_t carr_acc = PhaseToFixed(rem_carr_phase + kd * d_carr);
+    double p0 = CodeReplica::WrapPhase(rem_code_phase + kd * d_code) + CodeReplica::PAD + 0.5;
+    uint32_t code_acc[3] = {
+        ChipsToFixed(p0 + t_space), ChipsToFixed(p0), ChipsToFixed(p0 - t_space)};
+#ifdef STURDR_SIMD_X86
+    if (use_avx2) {
+      ReplicaAvx2(rep, n, chips, carr_acc, carr_step, code_acc, code_step);
+    } else {
+      ReplicaGeneric(rep, 0, n, chips, carr_acc, carr_step, code_acc, code_step);
+    }
+#else
+    ReplicaGeneric(rep, 0, n, chips, carr_acc, carr_step, code_acc, code_step);
+#endif
+
+    // xor/popcount every antenna against the same patterns
+    bool first_half = k < n_first_half;
+    for (std::size_t a = 0; a < n_ant; a++) {
+      int64_t acc[6] = {0, 0, 0, 0, 0, 0};
+      if (iq) {
+        Mac<true>(rfdata, static_cast<uint8_t>(a), ptr + k, rep, n, acc);
+      } else {
+        Mac<false>(rfdata, static_cast<uint8_t>(a), ptr + k, rep, n, acc);
+      }
+      epl[a].IE += FIXED_CARR_AMP * acc[0];
+      epl[a].QE += FIXED_CARR_AMP * acc[1];
+      epl[a].IL += FIXED_CARR_AMP * acc[4];
+      epl[a].QL += FIXED_CARR_AMP * acc[5];
+      if (first_half) {
+        epl[a].IP1 += FIXED_CARR_AMP * acc[2];
+        epl[a].QP1 += FIXED_CARR_AMP * acc[3];
+      } else {
+        epl[a].IP2 += FIXED_CARR_AMP * acc[2];
+        epl[a].QP2 += FIXED_CARR_AMP * acc[3];
+      }
+    }
+    k += static_cast<uint64_t>(n);
+  }
+
+  // advance nco phases
+  rem_code_phase += static_cast<double>(n_samp) * d_code;
+  rem_carr_phase += static_cast<double>(n_samp) * d_carr;
+  samp_remaining -= n_samp;
+}
+
+}  // namespace
+
+// *=== AccumulateEPLPacked ===*
+void AccumulateEPLPacked(
+    const SampleRing &rfdata,
+    const uint64_t &ptr,
+    const uint64_t &n_samp,
+    const CodeReplica &code,
+    double &rem_code_phase,
+    double &code_freq,
+    double &rem_carr_phase,
+    double &carr_freq,
+    double &carr_jit,
+    double &samp_freq,
+    uint64_t &half_samp,
+    uint64_t &samp_remaining,
+    double &t_space,
+    FixedEPL &epl) {
+  AccumulateRing(
+      rfdata,
+      ptr,
+      n_samp,
+      1,
+      code,
+      rem_code_phase,
+      code_freq,
+      rem_carr_phase,
+      carr_freq,
+      carr_jit,
+      samp_freq,
+      half_samp,
+      samp_remaining,
+      t_space,
+      &epl);
+}
+void AccumulateEPLArrayPacked(
+    const SampleRing &rfdata,
+    const uint64_t &ptr,
+    const uint64_t &n_samp,
+    const CodeReplica &code,
+    double &rem_code_phase,
+    double &code_freq,
+    double &rem_carr_phase,
+    double &carr_freq,
+    double &carr_jit,
+    double &samp_freq,
+    uint64_t &half_samp,
+    uint64_t &samp_remaining,
+    double &t_space,
+    std::vector<FixedEPL> &epl) {
+  AccumulateRing(
+      rfdata,
+      ptr,
+      n_samp,
+      epl.size(),
+      code,
+      rem_code_phase,
+      code_freq,
+      rem_carr_phase,
+      carr_freq,
+      carr_jit,
+      samp_freq,
+      half_samp,
+      samp_remaining,
+      t_space,
+      epl.data());
+}
+
+}  // namespace sturdr
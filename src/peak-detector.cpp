@@ -0,0 +1,105 @@
+/**
+ * *peak-detector.cpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/peak-detector.cpp
+ * @brief   Streaming peak and noise floor statistics of an acquisition correlation map.
+ * @date    October 2026
+ * @ref     1. "Understanding GPS/GNSS Principles and Applications", 3rd Edition, 2017
+ *              - Kaplan & Hegarty
+ *          2. "A Software-Defined GPS and Galileo Receiver: A Single-Frequency Approach", 2007
+ *              - Borre, Akos, Bertelsen, Rinder, Jensen
+ * =======  ========================================================================================
+ */
+
+#include "sturdr/peak-detector.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sturdr {
+
+// *=== PeakDetector ===*
+PeakDetector::PeakDetector(const std::size_t &top_k) : top_k_{std::max<std::size_t>(top_k, 1)} {
+  cands_.reserve(top_k_ + 1);
+  Reset();
+}
+
+// *=== Reset ===*
+void PeakDetector::Reset() {
+  cands_.clear();
+  sum_ = 0.0;
+  sum2_ = 0.0;
+  n_ = 0;
+  n_rows_ = 0;
+  in_pow_ = 0.0;
+  n_in_ = 0;
+}
+
+// *=== AddColumn ===*
+void PeakDetector::AddColumn(
+    const int &bin,
+    const int &peak_samp,
+    const double &peak,
+    const double &sum,
+    const double &sum2,
+    const uint64_t &n) {
+  sum_ += sum;
+  sum2_ += sum2;
+  n_ += n;
+  n_rows_ = n;
+
+  // sorted insert, ties keep the earlier bin first (the cell maxCoeff would report)
+  if (cands_.size() == top_k_ && peak <= cands_.back().power) {
+    return;
+  }
+  auto it = std::upper_bound(
+      cands_.begin(),
+      cands_.end(),
+      peak,
+      [](const double &p, const AcquisitionCandidate &c) { return p > c.power; });
+  cands_.insert(it, AcquisitionCandidate{{peak_samp, bin}, peak});
+  if (cands_.size() > top_k_) {
+    cands_.pop_back();
+  }
+}
+
+// *=== AddInputPower ===*
+void PeakDetector::AddInputPower(const double &sum_abs2, const uint64_t &n) {
+  in_pow_ += sum_abs2;
+  n_in_ += n;
+}
+
+// *=== Mean ===*
+double PeakDetector::Mean() const {
+  return sum_ / static_cast<double>(n_);
+}
+
+// *=== Sigma ===*
+double PeakDetector::Sigma() const {
+  double n = static_cast<double>(n_);
+  return std::sqrt(std::max(sum2_ - sum_ * sum_ / n, 0.0) / (n - 1.0));
+}
+
+// *=== Metric ===*
+double PeakDetector::Metric(int peak_idx[2]) const {
+  if (cands_.empty()) {
+    peak_idx[0] = 0;
+    peak_idx[1] = 0;
+    return 0.0;
+  }
+  peak_idx[0] = cands_[0].peak_idx[0];
+  peak_idx[1] = cands_[0].peak_idx[1];
+  return (cands_[0].power - Mean()) / Sigma();
+}
+
+// *=== GlrtMetric ===*
+double PeakDetector::GlrtMetric() const {
+  if (cands_.empty() || n_in_ == 0) {
+    return 0.0;
+  }
+  double p_hat = in_pow_ / static_cast<double>(n_in_);
+  return 2.0 * cands_[0].power * static_cast<double>(n_rows_) / p_hat;
+}
+
+}  // namespace sturdr
@@ -0,0 +1,189 @@
+/**
+ * *prn-scheduler.cpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/prn-scheduler.cpp
+ * @brief   Assignment of PRNs to channels remembering the searches that failed.
+ * @date    October 2026
+ * =======  ========================================================================================
+ */
+
+#include "sturdr/prn-scheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace sturdr {
+
+namespace {
+
+// consecutive failures counted (the back-off reaches its cap long before)
+constexpr uint16_t MAX_DOUBLINGS = 16;
+
+}  // namespace
+
+// *=== PrnScheduler ===*
+PrnScheduler::PrnScheduler(
+    const uint64_t &backoff_ms,
+    const uint64_t &max_backoff_ms,
+    std::shared_ptr<AcquisitionAiding> acq_aiding)
+    : backoff_ms_{backoff_ms},
+      max_backoff_ms_{std::max(max_backoff_ms, backoff_ms)},
+      acq_aiding_{acq_aiding},
+      in_use_{0},
+      now_ms_{0},
+      rr_ptr_{1},
+      order_seq_{0},
+      order_gen_{0},
+      n_order_{0} {
+  for (uint8_t i = 0; i < N_PRN; i++) {
+    n_fail_[i].store(0);
+    fail_ms_[i].store(0);
+    fail_metric_[i].store(0.0);
+    order_[i].store(0);
+  }
+}
+
+// *=== SetTime ===*
+void PrnScheduler::SetTime(const uint64_t &ms) {
+  now_ms_.store(ms, std::memory_order_relaxed);
+  if (acq_aiding_) {
+    uint32_t generation = acq_aiding_->Generation();
+    if (generation != order_gen_.load(std::memory_order_relaxed)) {
+      PublishOrder(generation);
+    }
+  }
+}
+
+// *=== Claim ===*
+uint8_t PrnScheduler::Claim() {
+  uint64_t now = now_ms_.load(std::memory_order_relaxed);
+  std::array<uint8_t, N_PRN> order;
+  uint8_t n_order = LoadOrder(order);
+
+  // PRNs without a remembered failure go first, PRNs out of their back-off are kept for later
+  uint32_t in_use = in_use_.load(std::memory_order_acquire);
+  std::array<std::pair<double, uint8_t>, N_PRN> retry;
+  uint8_t n_retry = 0;
+  for (uint8_t i = 0; i < n_order; i++) {
+    uint8_t prn = order[i];
+    if (in_use & (1u << (prn - 1))) {
+      continue;
+    }
+    uint16_t n_fail = n_fail_[prn - 1].load(std::memory_order_relaxed);
+    uint64_t age = now - std::min(now, fail_ms_[prn - 1].load(std::memory_order_relaxed));
+    if (n_fail == 0 || age >= 2 * max_backoff_ms_) {
+      if (TryClaim(prn)) {
+        return prn;
+      }
+    } else if (age >= Backoff(n_fail)) {
+      retry[n_retry++] = {fail_metric_[prn - 1].load(std::memory_order_relaxed), prn};
+    }
+  }
+
+  // then the PRN that came closest to detection
+  std::stable_sort(retry.begin(), retry.begin() + n_retry, [](const auto &a, const auto &b) {
+    return a.first > b.first;
+  });
+  for (uint8_t i = 0; i < n_retry; i++) {
+    if (TryClaim(retry[i].second)) {
+      return retry[i].second;
+    }
+  }
+  return 0;
+}
+
+// *=== Release ===*
+void PrnScheduler::Release(const uint8_t &prn) {
+  if (prn < 1 || prn > N_PRN) {
+    return;
+  }
+  in_use_.fetch_and(~(1u << (prn - 1)), std::memory_order_acq_rel);
+}
+
+// *=== Failed ===*
+void PrnScheduler::Failed(const uint8_t &prn, const double &metric) {
+  if (prn < 1 || prn > N_PRN) {
+    return;
+  }
+
+  // a failure long after the previous one starts a new back-off
+  uint64_t now = now_ms_.load(std::memory_order_relaxed);
+  uint64_t last = fail_ms_[prn - 1].load(std::memory_order_relaxed);
+  uint16_t n_fail = n_fail_[prn - 1].load(std::memory_order_relaxed);
+  if (n_fail == 0 || now - std::min(now, last) >= 2 * max_backoff_ms_) {
+    n_fail = 0;
+  }
+  n_fail_[prn - 1].store(std::min<uint16_t>(n_fail + 1, MAX_DOUBLINGS), std::memory_order_relaxed);
+  fail_ms_[prn - 1].store(now, std::memory_order_relaxed);
+  fail_metric_[prn - 1].store(metric, std::memory_order_relaxed);
+  Release(prn);
+}
+
+// *=== TryClaim ===*
+bool PrnScheduler::TryClaim(const uint8_t &prn) {
+  uint32_t bit = 1u << (prn - 1);
+  if (in_use_.fetch_or(bit, std::memory_order_acq_rel) & bit) {
+    return false;
+  }
+  rr_ptr_.store(prn % N_PRN + 1, std::memory_order_relaxed);
+  return true;
+}
+
+// *=== PublishOrder ===*
+void PrnScheduler::PublishOrder(const uint32_t &generation) {
+  // the aiding locks to sort its predictions, so that happens before the claims are held up
+  std::vector<uint8_t> order = acq_aiding_->SearchOrder();
+  uint32_t seq = order_seq_.load(std::memory_order_relaxed);
+  if ((seq & 1) || !order_seq_.compare_exchange_strong(seq, seq + 1, std::memory_order_relaxed)) {
+    return;  // another thread is publishing
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  uint8_t n = static_cast<uint8_t>(std::min<std::size_t>(order.size(), N_PRN));
+  for (uint8_t i = 0; i < n; i++) {
+    order_[i].store(order[i], std::memory_order_relaxed);
+  }
+  n_order_.store(n, std::memory_order_relaxed);
+  order_gen_.store(generation, std::memory_order_relaxed);
+  order_seq_.store(seq + 2, std::memory_order_release);
+}
+
+// *=== LoadOrder ===*
+uint8_t PrnScheduler::LoadOrder(std::array<uint8_t, N_PRN> &order) const {
+  // predicted visible satellites (highest first) once there is a fix, copied again when it was
+  // republished during the copy
+  while (true) {
+    uint32_t seq = order_seq_.load(std::memory_order_acquire);
+    if (seq & 1) {
+      continue;
+    }
+    uint32_t generation = order_gen_.load(std::memory_order_relaxed);
+    uint8_t n = n_order_.load(std::memory_order_relaxed);
+    for (uint8_t i = 0; i < n; i++) {
+      order[i] = order_[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (order_seq_.load(std::memory_order_relaxed) != seq) {
+      continue;
+    }
+    if (generation > 0) {
+      return n;
+    }
+    break;
+  }
+
+  // every PRN round robin after the last one handed out otherwise
+  uint8_t start = rr_ptr_.load(std::memory_order_relaxed);
+  for (uint8_t i = 0; i < N_PRN; i++) {
+    order[i] = (start - 1 + i) % N_PRN + 1;
+  }
+  return N_PRN;
+}
+
+// *=== Backoff ===*
+uint64_t PrnScheduler::Backoff(const uint16_t &n_fail) const {
+  return std::min(backoff_ms_ << (n_fail - 1), max_backoff_ms_);
+}
+
+}  // namespace sturdr
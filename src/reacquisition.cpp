@@ -0,0 +1,87 @@
+/**
+ * *reacquisition.cpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/reacquisition.cpp
+ * @brief   Loss of lock detection and the reacquisition search window that follows it.
+ * @date    October 2026
+ * =======  ========================================================================================
+ */
+
+#include "sturdr/reacquisition.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sturdr {
+
+// *=== Reacquisition ===*
+Reacquisition::Reacquisition(
+    const uint64_t &loss_ms,
+    const uint64_t &timeout_ms,
+    const double &width,
+    const double &rate,
+    const double &d_range,
+    const double &d_step)
+    : loss_ms_{loss_ms},
+      timeout_ms_{timeout_ms},
+      width_{width},
+      rate_{rate},
+      d_range_{d_range},
+      d_step_{d_step},
+      lost_ms_{0},
+      reacq_ms_{0},
+      doppler_{0.0} {
+}
+
+// *=== Start ===*
+void Reacquisition::Start(const double &doppler, const uint64_t &converge_ms) {
+  lost_ms_ = -static_cast<int64_t>(converge_ms);
+  doppler_ = doppler;
+}
+
+// *=== Update ===*
+bool Reacquisition::Update(const bool &code_lock, const double &doppler, const uint64_t &ms) {
+  // the loops wander off on noise while the lock is gone, so only locked epochs move the center
+  if (code_lock) {
+    lost_ms_ = 0;
+    doppler_ = doppler;
+    return false;
+  }
+  lost_ms_ += static_cast<int64_t>(ms);
+  if (loss_ms_ == 0 || lost_ms_ < static_cast<int64_t>(loss_ms_)) {
+    return false;
+  }
+  reacq_ms_ = 0;
+  return true;
+}
+
+// *=== Elapse ===*
+void Reacquisition::Elapse(const uint64_t &ms) {
+  reacq_ms_ += ms;
+}
+
+// *=== Window ===*
+DopplerWindow Reacquisition::Window() const {
+  int n_bins = 2 * static_cast<int>(d_range_ / d_step_) + 1;
+  int center = static_cast<int>(std::round((doppler_ + d_range_) / d_step_));
+  int half = static_cast<int>(std::ceil(Width() / d_step_));
+  int first = std::clamp(center - half, 0, n_bins - 1);
+  int last = std::clamp(center + half, first, n_bins - 1);
+  return DopplerWindow{first, last - first + 1};
+}
+
+// *=== Width ===*
+double Reacquisition::Width() const {
+  return width_ + rate_ * 0.001 * static_cast<double>(reacq_ms_);
+}
+
+// *=== Searched ===*
+ChannelState::ChannelState Reacquisition::Searched(const bool &found) const {
+  if (found) {
+    return ChannelState::TRACKING;
+  }
+  return (reacq_ms_ >= timeout_ms_) ? ChannelState::ACQUIRING : ChannelState::REACQUIRING;
+}
+
+}  // namespace sturdr
@@ -0,0 +1,156 @@
+/**
+ * *sample-ring.cpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/sample-ring.cpp
+ * @brief   Shared ring buffer of front end samples, stored as complex doubles/floats or natively.
+ * @date    October 2026
+ * =======  ========================================================================================
+ */
+
+#include "sturdr/sample-ring.hpp"
+
+#include <algorithm>
+
+namespace sturdr {
+
+namespace {
+
+// *=== Widen ===*
+// converts real or I/Q integer samples into complex samples of any precision
+template <typename Real, typename T>
+void Widen(const T in[], std::complex<Real> out[], const uint64_t &len) {
+  for (uint64_t i = 0; i < len; i++) {
+    if constexpr (std::is_arithmetic_v<T>) {
+      out[i] = std::complex<Real>(static_cast<Real>(in[i]), 0.0);
+    } else {
+      out[i] = std::complex<Real>(static_cast<Real>(in[i].real()), static_cast<Real>(in[i].imag()));
+    }
+  }
+}
+
+}  // namespace
+
+// *=== SampleRing ===*
+SampleRing::SampleRing(
+    const uint64_t &n_samp,
+    const uint8_t &n_ant,
+    const SampleFormat::SampleFormat &format,
+    const bool &packed)
+    : format_{format}, n_samp_{n_samp}, n_ant_{n_ant}, n_words_{(n_samp + 63) / 64 + 1} {
+  uint64_t n_values = (IsComplex() ? 2 : 1) * n_samp_ * static_cast<uint64_t>(n_ant_);
+  switch (format_) {
+    case SampleFormat::INT8:
+    case SampleFormat::CINT8:
+      i8_.assign(n_values, 0);
+      if (packed) {
+        bits_.assign(4 * n_words_ * static_cast<uint64_t>(n_ant_), 0);
+      }
+      break;
+    case SampleFormat::INT16:
+    case SampleFormat::CINT16:
+      i16_.assign(n_values, 0);
+      break;
+    case SampleFormat::CFLOAT:
+      cf_ = Eigen::MatrixXcf::Zero(n_samp_, n_ant_);
+      break;
+    default:
+      cd_ = Eigen::MatrixXcd::Zero(n_samp_, n_ant_);
+      break;
+  }
+}
+
+// *=== Read ===*
+template <typename Real>
+void SampleRing::Read(
+    std::complex<Real> out[], const uint8_t &ant, const uint64_t &ptr, const uint64_t &len) const {
+  switch (format_) {
+    case SampleFormat::INT8:
+      Widen(Int8(ant, ptr), out, len);
+      break;
+    case SampleFormat::INT16:
+      Widen(Int16(ant, ptr), out, len);
+      break;
+    case SampleFormat::CINT8:
+      Widen(reinterpret_cast<const std::complex<int8_t> *>(Int8(ant, ptr)), out, len);
+      break;
+    case SampleFormat::CINT16:
+      Widen(reinterpret_cast<const std::complex<int16_t> *>(Int16(ant, ptr)), out, len);
+      break;
+    case SampleFormat::CFLOAT:
+      Widen(cf_.col(ant).data() + ptr, out, len);
+      break;
+    default:
+      Widen(cd_.col(ant).data() + ptr, out, len);
+      break;
+  }
+}
+
+// *=== View ===*
+template <typename Real>
+Eigen::Ref<const Eigen::MatrixX<std::complex<Real>>> SampleRing::View(
+    const uint64_t &ptr,
+    const uint64_t &len,
+    const uint8_t &n_ant,
+    Eigen::MatrixX<std::complex<Real>> &scratch) const {
+  if constexpr (std::is_same_v<Real, double>) {
+    if (format_ == SampleFormat::CDOUBLE) {
+      return cd_.block(ptr, 0, len, n_ant);
+    }
+  } else {
+    if (format_ == SampleFormat::CFLOAT) {
+      return cf_.block(ptr, 0, len, n_ant);
+    }
+  }
+  scratch.resize(len, n_ant);
+  for (uint8_t j = 0; j < n_ant; j++) {
+    Read(scratch.col(j).data(), j, ptr, len);
+  }
+  return scratch;
+}
+
+// *=== Pack ===*
+void SampleRing::Pack(const uint8_t &ant, const uint64_t &ptr, const uint64_t &len) {
+  const int8_t *x = i8_.data() + Offset(ant, 0);
+  uint64_t *planes = bits_.data() + static_cast<uint64_t>(ant) * 4 * n_words_;
+  uint64_t stride = IsComplex() ? 2 : 1;
+
+  // every word touching [ptr, ptr + len) is rebuilt whole from the ring (its other samples are
+  // already stored there), so a word is only ever replaced by one plain store and never
+  // read-modified-written while the channels read its older samples
+  uint64_t w_end = (ptr + len + 63) >> 6;
+  for (uint64_t w = ptr >> 6; w < w_end; w++) {
+    uint64_t k = w << 6, n = std::min<uint64_t>(64, n_samp_ - k);
+    uint64_t word[4] = {0, 0, 0, 0};
+    for (uint64_t j = 0; j < n; j++) {
+      for (uint64_t c = 0; c < stride; c++) {
+        int8_t v = x[stride * (k + j) + c];
+        word[2 * c] |= static_cast<uint64_t>(v < 0) << j;
+        word[2 * c + 1] |= static_cast<uint64_t>(v > 1 || v < -1) << j;
+      }
+    }
+    for (uint64_t p = 0; p < 4; p++) {
+      planes[p * n_words_ + w] = word[p];
+    }
+  }
+}
+
+// *=== Bytes ===*
+std::size_t SampleRing::Bytes() const {
+  return static_cast<std::size_t>(cd_.size()) * sizeof(std::complex<double>) +
+         static_cast<std::size_t>(cf_.size()) * sizeof(std::complex<float>) +
+         i8_.size() * sizeof(int8_t) + i16_.size() * sizeof(int16_t) +
+         bits_.size() * sizeof(uint64_t);
+}
+
+// Explicit instantiation of the double and single precision accessors
+template void SampleRing::Read<double>(
+    std::complex<double>[], const uint8_t &, const uint64_t &, const uint64_t &) const;
+template void SampleRing::Read<float>(
+    std::complex<float>[], const uint8_t &, const uint64_t &, const uint64_t &) const;
+template Eigen::Ref<const Eigen::MatrixXcd> SampleRing::View<double>(
+    const uint64_t &, const uint64_t &, const uint8_t &, Eigen::MatrixXcd &) const;
+template Eigen::Ref<const Eigen::MatrixXcf> SampleRing::View<float>(
+    const uint64_t &, const uint64_t &, const uint8_t &, Eigen::MatrixXcf &) const;
+
+}  // namespace sturdr
@@ -0,0 +1,567 @@
+/**
+ * *simd-correlator.cpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/simd-correlator.cpp
+ * @brief   Vectorized correlator kernels selected at runtime by CPU feature detection.
+ * @date    October 2026
+ * @ref     1. "Intel 64 and IA-32 Architectures Optimization Reference Manual", 2023 - Intel
+ *          2. "A Software-Defined GPS and Galileo Receiver: A Single-Frequency Approach", 2007
+ *              - Borre, Akos, Bertelsen, Rinder, Jensen
+ * =======  ========================================================================================
+ */
+
+#include "sturdr/simd-correlator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <type_traits>
+
+#include "sturdr/carrier-nco.hpp"
+#include "sturdr/code-replica.hpp"
+#include "sturdr/data-type-adapters.hpp"
+
+#ifdef STURDR_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace sturdr {
+
+namespace {
+
+// number of samples processed per carrier replica block
+constexpr int CHUNK = 512;
+
+// currently selected SIMD level (-1 = not yet detected)
+std::atomic<int> active_level{-1};
+
+// *=== EplKernelGeneric ===*
+// portable lane-by-lane kernel, acc = {E_re, E_im, P_re, P_im, L_re, L_im}
+void EplKernelGeneric(
+    const double *x,
+    const double *c,
+    const int &n,
+    const double *code,
+    const double &p0,
+    const double &d_code,
+    const double &t_space,
+    double acc[6]) {
+  for (int k = 0; k < n; k++) {
+    double p = p0 + static_cast<double>(k) * d_code;
+    double w_re = x[2 * k] * c[2 * k] - x[2 * k + 1] * c[2 * k + 1];
+    double w_im = x[2 * k] * c[2 * k + 1] + x[2 * k + 1] * c[2 * k];
+    double ve = code[CodeReplica::ExpandedIndex(p + t_space)];
+    double vp = code[CodeReplica::ExpandedIndex(p)];
+    double vl = code[CodeReplica::ExpandedIndex(p - t_space)];
+    acc[0] += ve * w_re;
+    acc[1] += ve * w_im;
+    acc[2] += vp * w_re;
+    acc[3] += vp * w_im;
+    acc[4] += vl * w_re;
+    acc[5] += vl * w_im;
+  }
+}
+
+#ifdef STURDR_SIMD_X86
+
+// *=== EplKernelSse2 ===*
+// one complex sample per register, chip indexes resolved per lane
+void EplKernelSse2(
+    const double *x,
+    const double *c,
+    const int &n,
+    const double *code,
+    const double &p0,
+    const double &d_code,
+    const double &t_space,
+    double acc[6]) {
+  const __m128d sign = _mm_set_pd(0.0, -0.0);
+  __m128d e_acc = _mm_setzero_pd();
+  __m128d p_acc = _mm_setzero_pd();
+  __m128d l_acc = _mm_setzero_pd();
+  for (int k = 0; k < n; k++) {
+    double p = p0 + static_cast<double>(k) * d_code;
+
+    // carrier wipeoff
+    __m128d xv = _mm_loadu_pd(x + 2 * k);
+    __m128d cv = _mm_loadu_pd(c + 2 * k);
+    __m128d cr = _mm_unpacklo_pd(cv, cv);
+    __m128d ci = _mm_unpackhi_pd(cv, cv);
+    __m128d xs = _mm_shuffle_pd(xv, xv, 1);
+    __m128d w = _mm_add_pd(_mm_mul_pd(xv, cr), _mm_xor_pd(_mm_mul_pd(xs, ci), sign));
+
+    // code wipeoff
+    double ve = code[CodeReplica::ExpandedIndex(p + t_space)];
+    double vp = code[CodeReplica::ExpandedIndex(p)];
+    double vl = code[CodeReplica::ExpandedIndex(p - t_space)];
+    e_acc = _mm_add_pd(e_acc, _mm_mul_pd(w, _mm_set1_pd(ve)));
+    p_acc = _mm_add_pd(p_acc, _mm_mul_pd(w, _mm_set1_pd(vp)));
+    l_acc = _mm_add_pd(l_acc, _mm_mul_pd(w, _mm_set1_pd(vl)));
+  }
+  double tmp[2];
+  _mm_storeu_pd(tmp, e_acc);
+  acc[0] += tmp[0];
+  acc[1] += tmp[1];
+  _mm_storeu_pd(tmp, p_acc);
+  acc[2] += tmp[0];
+  acc[3] += tmp[1];
+  _mm_storeu_pd(tmp, l_acc);
+  acc[4] += tmp[0];
+  acc[5] += tmp[1];
+}
+
+// *=== Avx2 helpers ===*
+__attribute__((target("avx2,fma"))) inline __m256d Avx2ChipLookup(
+    const double *code, const __m256d &phase) {
+  const __m256d offset = _mm256_set1_pd(CodeReplica::PAD + 0.5);
+  __m128i idx = _mm256_cvttpd_epi32(_mm256_add_pd(phase, offset));
+  return _mm256_i32gather_pd(code, idx, 8);
+}
+__attribute__((target("avx2,fma"))) inline __m256d Avx2ComplexMul(
+    const __m256d &x, const __m256d &c) {
+  __m256d cr = _mm256_movedup_pd(c);
+  __m256d ci = _mm256_permute_pd(c, 0xF);
+  __m256d xs = _mm256_permute_pd(x, 0x5);
+  return _mm256_fmaddsub_pd(x, cr, _mm256_mul_pd(xs, ci));
+}
+
+// *=== EplKernelAvx2 ===*
+// four samples per iteration, (re, im) pairs interleaved across two registers
+__attribute__((target("avx2,fma"))) void EplKernelAvx2(
+    const double *x,
+    const double *c,
+    const int &n,
+    const double *code,
+    const double &p0,
+    const double &d_code,
+    const double &t_space,
+    double acc[6]) {
+  const __m256d lane = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+  const __m256d vd = _mm256_set1_pd(d_code);
+  const __m256d vp0 = _mm256_set1_pd(p0);
+  const __m256d vt = _mm256_set1_pd(t_space);
+  __m256d e_acc = _mm256_setzero_pd();
+  __m256d p_acc = _mm256_setzero_pd();
+  __m256d l_acc = _mm256_setzero_pd();
+
+  int k = 0;
+  for (; k + 4 <= n; k += 4) {
+    // code phase of each lane
+    __m256d p =
+        _mm256_fmadd_pd(_mm256_add_pd(_mm256_set1_pd(static_cast<double>(k)), lane), vd, vp0);
+    __m256d ve = Avx2ChipLookup(code, _mm256_add_pd(p, vt));
+    __m256d vp = Avx2ChipLookup(code, p);
+    __m256d vl = Avx2ChipLookup(code, _mm256_sub_pd(p, vt));
+
+    // carrier wipeoff
+    __m256d w0 = Avx2ComplexMul(_mm256_loadu_pd(x + 2 * k), _mm256_loadu_pd(c + 2 * k));
+    __m256d w1 = Avx2ComplexMul(_mm256_loadu_pd(x + 2 * k + 4), _mm256_loadu_pd(c + 2 * k + 4));
+
+    // code wipeoff (expand each code value across its re/im pair)
+    e_acc = _mm256_fmadd_pd(w0, _mm256_permute4x64_pd(ve, 0x50), e_acc);
+    e_acc = _mm256_fmadd_pd(w1, _mm256_permute4x64_pd(ve, 0xFA), e_acc);
+    p_acc = _mm256_fmadd_pd(w0, _mm256_permute4x64_pd(vp, 0x50), p_acc);
+    p_acc = _mm256_fmadd_pd(w1, _mm256_permute4x64_pd(vp, 0xFA), p_acc);
+    l_acc = _mm256_fmadd_pd(w0, _mm256_permute4x64_pd(vl, 0x50), l_acc);
+    l_acc = _mm256_fmadd_pd(w1, _mm256_permute4x64_pd(vl, 0xFA), l_acc);
+  }
+
+  double tmp[4];
+  _mm256_storeu_pd(tmp, e_acc);
+  acc[0] += tmp[0] + tmp[2];
+  acc[1] += tmp[1] + tmp[3];
+  _mm256_storeu_pd(tmp, p_acc);
+  acc[2] += tmp[0] + tmp[2];
+  acc[3] += tmp[1] + tmp[3];
+  _mm256_storeu_pd(tmp, l_acc);
+  acc[4] += tmp[0] + tmp[2];
+  acc[5] += tmp[1] + tmp[3];
+
+  // remaining samples
+  double pk = p0 + static_cast<double>(k) * d_code;
+  EplKernelGeneric(x + 2 * k, c + 2 * k, n - k, code, pk, d_code, t_space, acc);
+}
+
+// *=== Avx512 helpers ===*
+__attribute__((target("avx512f"))) inline __m512d Avx512ChipLookup(
+    const double *code, const __m512d &phase) {
+  const __m512d offset = _mm512_set1_pd(CodeReplica::PAD + 0.5);
+  __m256i idx = _mm512_cvttpd_epi32(_mm512_add_pd(phase, offset));
+  return _mm512_i32gather_pd(idx, code, 8);
+}
+__attribute__((target("avx512f"))) inline __m512d Avx512ComplexMul(
+    const __m512d &x, const __m512d &c) {
+  __m512d cr = _mm512_movedup_pd(c);
+  __m512d ci = _mm512_permute_pd(c, 0xFF);
+  __m512d xs = _mm512_permute_pd(x, 0x55);
+  return _mm512_fmaddsub_pd(x, cr, _mm512_mul_pd(xs, ci));
+}
+
+// *=== EplKernelAvx512 ===*
+// eight samples per iteration, (re, im) pairs interleaved across two registers
+__attribute__((target("avx512f"))) void EplKernelAvx512(
+    const double *x,
+    const double *c,
+    const int &n,
+    const double *code,
+    const double &p0,
+    const double &d_code,
+    const double &t_space,
+    double acc[6]) {
+  const __m512d lane = _mm512_set_pd(7.0, 6.0, 5.0, 4.0, 3.0, 2.0, 1.0, 0.0);
+  const __m512i lo = _mm512_set_epi64(3, 3, 2, 2, 1, 1, 0, 0);
+  const __m512i hi = _mm512_set_epi64(7, 7, 6, 6, 5, 5, 4, 4);
+  const __m512d vd = _mm512_set1_pd(d_code);
+  const __m512d vp0 = _mm512_set1_pd(p0);
+  const __m512d vt = _mm512_set1_pd(t_space);
+  __m512d e_acc = _mm512_setzero_pd();
+  __m512d p_acc = _mm512_setzero_pd();
+  __m512d l_acc = _mm512_setzero_pd();
+
+  int k = 0;
+  for (; k + 8 <= n; k += 8) {
+    // code phase of each lane
+    __m512d p =
+        _mm512_fmadd_pd(_mm512_add_pd(_mm512_set1_pd(static_cast<double>(k)), lane), vd, vp0);
+    __m512d ve = Avx512ChipLookup(code, _mm512_add_pd(p, vt));
+    __m512d vp = Avx512ChipLookup(code, p);
+    __m512d vl = Avx512ChipLookup(code, _mm512_sub_pd(p, vt));
+
+    // carrier wipeoff
+    __m512d w0 = Avx512ComplexMul(_mm512_loadu_pd(x + 2 * k), _mm512_loadu_pd(c + 2 * k));
+    __m512d w1 = Avx512ComplexMul(_mm512_loadu_pd(x + 2 * k + 8), _mm512_loadu_pd(c + 2 * k + 8));
+
+    // code wipeoff (expand each code value across its re/im pair)
+    e_acc = _mm512_fmadd_pd(w0, _mm512_permutexvar_pd(lo, ve), e_acc);
+    e_acc = _mm512_fmadd_pd(w1, _mm512_permutexvar_pd(hi, ve), e_acc);
+    p_acc = _mm512_fmadd_pd(w0, _mm512_permutexvar_pd(lo, vp), p_acc);
+    p_acc = _mm512_fmadd_pd(w1, _mm512_permutexvar_pd(hi, vp), p_acc);
+    l_acc = _mm512_fmadd_pd(w0, _mm512_permutexvar_pd(lo, vl), l_acc);
+    l_acc = _mm512_fmadd_pd(w1, _mm512_permutexvar_pd(hi, vl), l_acc);
+  }
+
+  double tmp[8];
+  double *out[3] = {acc, acc + 2, acc + 4};
+  __m512d sums[3] = {e_acc, p_acc, l_acc};
+  for (int j = 0; j < 3; j++) {
+    _mm512_storeu_pd(tmp, sums[j]);
+    out[j][0] += tmp[0] + tmp[2] + tmp[4] + tmp[6];
+    out[j][1] += tmp[1] + tmp[3] + tmp[5] + tmp[7];
+  }
+
+  // remaining samples
+  double pk = p0 + static_cast<double>(k) * d_code;
+  EplKernelGeneric(x + 2 * k, c + 2 * k, n - k, code, pk, d_code, t_space, acc);
+}
+
+#endif
+
+// *=== EplKernel ===*
+// routes a chunk to the kernel of the requested SIMD level
+void EplKernel(
+    const SimdLevel::SimdLevel &level,
+    const double *x,
+    const double *c,
+    const int &n,
+    const double *code,
+    const double &p0,
+    const double &d_code,
+    const double &t_space,
+    double acc[6]) {
+  switch (level) {
+#ifdef STURDR_SIMD_X86
+    case SimdLevel::AVX512:
+      EplKernelAvx512(x, c, n, code, p0, d_code, t_space, acc);
+      break;
+    case SimdLevel::AVX2:
+      EplKernelAvx2(x, c, n, code, p0, d_code, t_space, acc);
+      break;
+    case SimdLevel::SSE2:
+      EplKernelSse2(x, c, n, code, p0, d_code, t_space, acc);
+      break;
+#endif
+    default:
+      EplKernelGeneric(x, c, n, code, p0, d_code, t_space, acc);
+      break;
+  }
+}
+
+// *=== AccumulateBlocks ===*
+// chunked accumulation shared by every input sample type
+template <typename T>
+void AccumulateBlocks(
+    CarrierNco &nco,
+    const T *rfdata,
+    const uint64_t &n_samp,
+    const double *code,
+    double &rem_code_phase,
+    const double &d_code,
+    double &rem_carr_phase,
+    const double &d_carr,
+    const uint64_t &n_first_half,
+    const double &t_space,
+    std::complex<double> &E,
+    std::complex<double> &P1,
+    std::complex<double> &P2,
+    std::complex<double> &L) {
+  SimdLevel::SimdLevel level = GetSimdLevel();
+  uint64_t max_chunk = std::min<uint64_t>(CHUNK, CodeReplica::MaxBlockLength(d_code));
+  alignas(64) std::complex<double> carr[CHUNK];
+  alignas(64) std::complex<double> wide[CHUNK];
+  double acc1[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  double acc2[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+  // walk through the samples one chunk at a time, splitting at the prompt half boundary
+  uint64_t k = 0;
+  while (k < n_samp) {
+    uint64_t end = (k < n_first_half) ? n_first_half : n_samp;
+    int n = static_cast<int>(std::min<uint64_t>(end - k, max_chunk));
+    double kd = static_cast<double>(k);
+    double carr_phase = rem_carr_phase + kd * d_carr;
+    double code_phase = CodeReplica::WrapPhase(rem_code_phase + kd * d_code);
+    nco.Generate(carr, static_cast<uint64_t>(n), carr_phase, d_carr);
+
+    // compact samples are widened to double here, while the chunk is still in L1
+    const double *x;
+    if constexpr (std::is_same_v<T, std::complex<double>>) {
+      x = reinterpret_cast<const double *>(rfdata + k);
+    } else if constexpr (std::is_arithmetic_v<T>) {
+      TypeToIDouble<T>(rfdata + k, wide, n);
+      x = reinterpret_cast<const double *>(wide);
+    } else {
+      ITypeToIDouble<typename T::value_type>(rfdata + k, wide, n);
+      x = reinterpret_cast<const double *>(wide);
+    }
+    EplKernel(
+        level,
+        x,
+        reinterpret_cast<const double *>(carr),
+        n,
+        code,
+        code_phase,
+        d_code,
+        t_space,
+        (k < n_first_half) ? acc1 : acc2);
+    k += static_cast<uint64_t>(n);
+  }
+
+  // prompt halves share the early and late sums
+  E += std::complex<double>(acc1[0] + acc2[0], acc1[1] + acc2[1]);
+  P1 += std::complex<double>(acc1[2], acc1[3]);
+  P2 += std::complex<double>(acc2[2], acc2[3]);
+  L += std::complex<double>(acc1[4] + acc2[4], acc1[5] + acc2[5]);
+
+  // advance nco phases
+  rem_code_phase += static_cast<double>(n_samp) * d_code;
+  rem_carr_phase += static_cast<double>(n_samp) * d_carr;
+}
+
+}  // namespace
+
+// *=== DetectSimdLevel ===*
+SimdLevel::SimdLevel DetectSimdLevel() {
+#ifdef STURDR_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return SimdLevel::AVX512;
+  } else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return SimdLevel::AVX2;
+  } else if (__builtin_cpu_supports("sse2")) {
+    return SimdLevel::SSE2;
+  }
+#endif
+  return SimdLevel::GENERIC;
+}
+
+// *=== GetSimdLevel ===*
+SimdLevel::SimdLevel GetSimdLevel() {
+  int level = active_level.load(std::memory_order_relaxed);
+  if (level < 0) {
+    level = static_cast<int>(DetectSimdLevel());
+    active_level.store(level, std::memory_order_relaxed);
+  }
+  return static_cast<SimdLevel::SimdLevel>(level);
+}
+
+// *=== SetSimdLevel ===*
+void SetSimdLevel(const SimdLevel::SimdLevel &level) {
+  int max_level = static_cast<int>(DetectSimdLevel());
+  active_level.store(std::min(static_cast<int>(level), max_level), std::memory_order_relaxed);
+}
+
+// *=== AccumulateEPLSimd ===*
+void AccumulateEPLSimd(
+    const std::complex<double> *rfdata,
+    const uint64_t &n_samp,
+    const double *code,
+    double &rem_code_phase,
+    const double &d_code,
+    double &rem_carr_phase,
+    const double &d_carr,
+    const uint64_t &n_first_half,
+    const double &t_space,
+    std::complex<double> &E,
+    std::complex<double> &P1,
+    std::complex<double> &P2,
+    std::complex<double> &L) {
+  CarrierNco nco(GetCarrierNcoMode(), CHUNK);
+  AccumulateEPLSimd(
+      nco,
+      rfdata,
+      n_samp,
+      code,
+      rem_code_phase,
+      d_code,
+      rem_carr_phase,
+      d_carr,
+      n_first_half,
+      t_space,
+      E,
+      P1,
+      P2,
+      L);
+}
+void AccumulateEPLSimd(
+    CarrierNco &nco,
+    const std::complex<double> *rfdata,
+    const uint64_t &n_samp,
+    const double *code,
+    double &rem_code_phase,
+    const double &d_code,
+    double &rem_carr_phase,
+    const double &d_carr,
+    const uint64_t &n_first_half,
+    const double &t_space,
+    std::complex<double> &E,
+    std::complex<double> &P1,
+    std::complex<double> &P2,
+    std::complex<double> &L) {
+  AccumulateBlocks(
+      nco,
+      rfdata,
+      n_samp,
+      code,
+      rem_code_phase,
+      d_code,
+      rem_carr_phase,
+      d_carr,
+      n_first_half,
+      t_space,
+      E,
+      P1,
+      P2,
+      L);
+}
+template <typename T>
+void AccumulateEPLSimd(
+    CarrierNco &nco,
+    const T *rfdata,
+    const uint64_t &n_samp,
+    const double *code,
+    double &rem_code_phase,
+    const double &d_code,
+    double &rem_carr_phase,
+    const double &d_carr,
+    const uint64_t &n_first_half,
+    const double &t_space,
+    std::complex<double> &E,
+    std::complex<double> &P1,
+    std::complex<double> &P2,
+    std::complex<double> &L) {
+  AccumulateBlocks(
+      nco,
+      rfdata,
+      n_samp,
+      code,
+      rem_code_phase,
+      d_code,
+      rem_carr_phase,
+      d_carr,
+      n_first_half,
+      t_space,
+      E,
+      P1,
+      P2,
+      L);
+}
+
+// Explicit instantiation of AccumulateEPLSimd for compact (native front end) and single precision
+// samples
+template void AccumulateEPLSimd<int8_t>(
+    CarrierNco &,
+    const int8_t *,
+    const uint64_t &,
+    const double *,
+    double &,
+    const double &,
+    double &,
+    const double &,
+    const uint64_t &,
+    const double &,
+    std::complex<double> &,
+    std::complex<double> &,
+    std::complex<double> &,
+    std::complex<double> &);
+template void AccumulateEPLSimd<int16_t>(
+    CarrierNco &,
+    const int16_t *,
+    const uint64_t &,
+    const double *,
+    double &,
+    const double &,
+    double &,
+    const double &,
+    const uint64_t &,
+    const double &,
+    std::complex<double> &,
+    std::complex<double> &,
+    std::complex<double> &,
+    std::complex<double> &);
+template void AccumulateEPLSimd<std::complex<int8_t>>(
+    CarrierNco &,
+    const std::complex<int8_t> *,
+    const uint64_t &,
+    const double *,
+    double &,
+    const double &,
+    double &,
+    const double &,
+    const uint64_t &,
+    const double &,
+    std::complex<double> &,
+    std::complex<double> &,
+    std::complex<double> &,
+    std::complex<double> &);
+template void AccumulateEPLSimd<std::complex<int16_t>>(
+    CarrierNco &,
+    const std::complex<int16_t> *,
+    const uint64_t &,
+    const double *,
+    double &,
+    const double &,
+    double &,
+    const double &,
+    const uint64_t &,
+    const double &,
+    std::complex<double> &,
+    std::complex<double> &,
+    std::complex<double> &,
+    std::complex<double> &);
+template void AccumulateEPLSimd<std::complex<float>>(
+    CarrierNco &,
+    const std::complex<float> *,
+    const uint64_t &,
+    const double *,
+    double &,
+    const double &,
+    double &,
+    const double &,
+    const uint64_t &,
+    const double &,
+    std::complex<double> &,
+    std::complex<double> &,
+    std::complex<double> &,
+    std::complex<double> &);
+
+}  // namespace sturdr
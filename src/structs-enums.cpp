@@ -136,6 +136,9 @@ std::ostream& operator<<(std::ostream& os, const sturdr::ChannelState::ChannelSt
     case sturdr::ChannelState::ChannelState::TRACKING:
       os << "TRACKING";
       break;
+    case sturdr::ChannelState::ChannelState::REACQUIRING:
+      os << "REACQUIRING";
+      break;
   }
   return os;
 }
@@ -63,7 +63,28 @@ PYBIND11_MODULE(_sturdr_core, h) {
   // PcpsSearch
   acq.def(
       "PcpsSearch",
-      &PcpsSearch,
+      [](FftwWrapper &p,
+         const Eigen::Ref<const Eigen::VectorXcd> &rfdata,
+         const bool code[1023],
+         const double &d_range,
+         const double &d_step,
+         const double &samp_freq,
+         const double &code_freq,
+         const double &intmd_freq,
+         const uint8_t &c_per,
+         const uint8_t &nc_per) {
+        // python callers pass the raw code, the receiver passes cached spectra
+        return PcpsSearch<double>(
+            p,
+            rfdata,
+            CodeSpectrum<double>(p, code, samp_freq, code_freq),
+            d_range,
+            d_step,
+            samp_freq,
+            intmd_freq,
+            c_per,
+            nc_per);
+      },
       py::arg("p"),
       py::arg("rfdata"),
       py::arg("code"),
@@ -134,7 +155,7 @@ PYBIND11_MODULE(_sturdr_core, h) {
   // Peak2NoiseFloorTest
   acq.def(
       "Peak2NoiseFloorTest",
-      &Peak2NoiseFloorTest,
+      &Peak2NoiseFloorTest<double>,
       py::arg("corr_map"),
       py::arg("peak_idx"),
       py::arg("metric"),
@@ -870,7 +891,22 @@ PYBIND11_MODULE(_sturdr_core, h) {
   // AccumulateEPL
   gnss.def(
       "AccumulateEPL",
-      &AccumulateEPL,
+      py::overload_cast<
+          const Eigen::Ref<const Eigen::VectorXcd> &,
+          const bool *,
+          double &,
+          double &,
+          double &,
+          double &,
+          double &,
+          double &,
+          uint64_t &,
+          uint64_t &,
+          double &,
+          std::complex<double> &,
+          std::complex<double> &,
+          std::complex<double> &,
+          std::complex<double> &>(&AccumulateEPL),
       py::arg("rfdata"),
       py::arg("code"),
       py::arg("rem_code_phase"),
@@ -19,19 +19,61 @@
 #include <chrono>
 #include <complex>
 #include <cstdint>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <navtools/constants.hpp>
+#include <satutils/gnss-constants.hpp>
 #include <string>
 #include <thread>
+#include <unordered_set>
 #include <vector>
 
-#include "sturdr/data-type-adapters.hpp"
+#include "sturdr/acquisition.hpp"
+#include "sturdr/code-replica.hpp"
 #include "sturdr/fftw-wrapper.hpp"
 #include "sturdr/structs-enums.hpp"
 
 namespace sturdr {
 
+namespace {
+
+// *=== YamlKeys ===*
+// every key written in the config file, so a missing optional key can be told from a bad value
+std::unordered_set<std::string> YamlKeys(const std::string &fname) {
+  std::unordered_set<std::string> keys;
+  std::ifstream file(fname);
+  std::string line;
+  while (std::getline(file, line)) {
+    size_t first = line.find_first_not_of(" \t");
+    size_t colon = line.find(':');
+    if (first == std::string::npos || line[first] == '#' || colon == std::string::npos ||
+        colon <= first) {
+      continue;
+    }
+    size_t last = line.find_last_not_of(" \t", colon - 1);
+    keys.insert(line.substr(first, last - first + 1));
+  }
+  return keys;
+}
+
+// *=== GetOptionalVar ===*
+// optional yaml keys keep their default value when they are missing from the config file, a key
+// that is present must parse
+template <typename T>
+void GetOptionalVar(
+    sturdio::YamlParser &yp,
+    const std::unordered_set<std::string> &keys,
+    T &var,
+    const std::string &key) {
+  if (keys.contains(key)) {
+    var = yp.GetVar<T>(key);
+  }
+}
+
+}  // namespace
+
 SturDR::SturDR(const std::string yaml_fname)
     : yp_{sturdio::YamlParser(yaml_fname)},
       conf_{
@@ -90,15 +132,22 @@ SturDR::SturDR(const std::string yaml_fname)
       shm_ptr_{0},
       shm_file_size_samp_{conf_.general.ms_chunk_size * samp_per_ms_},
       shm_read_size_samp_{conf_.general.ms_read_size * samp_per_ms_},
-      shm_{std::make_shared<Eigen::MatrixXcd>(
-          Eigen::MatrixXcd::Zero(shm_file_size_samp_, conf_.antenna.n_ant))},
+      shm_{nullptr},
       running_{std::make_shared<bool>(true)},
       n_dopp_bins_{
           2 * static_cast<uint64_t>(
                   conf_.acquisition.doppler_range / conf_.acquisition.doppler_step) +
           1},
       fftw_plans_{std::make_shared<FftwWrapper>()},
-      prn_ptr_{1},
+      fftwf_plans_{nullptr},
+      acq_ctx_{nullptr},
+      acq_ctx_f_{nullptr},
+      acq_pool_{nullptr},
+      acq_pool_f_{nullptr},
+      acq_engine_{nullptr},
+      acq_aiding_{nullptr},
+      batch_correlator_{nullptr},
+      prn_scheduler_{nullptr},
       barrier1_{std::make_shared<ConcurrentBarrier>(conf_.rfsignal.max_channels + 1)},
       barrier2_{std::make_shared<ConcurrentBarrier>(conf_.rfsignal.max_channels + 1)},
       // log_{spdlog::stdout_color_mt<spdlog::async_factory>("sturdr-console")},
@@ -107,6 +156,39 @@ SturDR::SturDR(const std::string yaml_fname)
   // setup terminal/console logger
   log_->set_pattern("\033[1;34m[%D %T.%e][%^%l%$\033[1;34m]: \033[0m%v");
   log_->set_level(conf_.general.log_level);
+
+  // optional parameters
+  std::unordered_set<std::string> keys = YamlKeys(yaml_fname);
+  GetOptionalVar(yp_, keys, conf_.rfsignal.compact_ring, "compact_ring");
+  GetOptionalVar(yp_, keys, conf_.rfsignal.single_precision, "single_precision");
+  GetOptionalVar(yp_, keys, conf_.acquisition.cache_carrier, "cache_carrier");
+  GetOptionalVar(yp_, keys, conf_.acquisition.freq_domain_search, "freq_domain_search");
+  GetOptionalVar(yp_, keys, conf_.acquisition.async_acquisition, "async_acquisition");
+  GetOptionalVar(yp_, keys, conf_.acquisition.acquisition_workers, "acquisition_workers");
+  GetOptionalVar(yp_, keys, conf_.acquisition.max_acquisitions, "max_acquisitions");
+  GetOptionalVar(yp_, keys, conf_.acquisition.fftw_threads, "fftw_threads");
+  GetOptionalVar(yp_, keys, conf_.acquisition.acquisition_threads, "acquisition_threads");
+  GetOptionalVar(yp_, keys, conf_.acquisition.fft_planning, "fft_planning");
+  GetOptionalVar(yp_, keys, conf_.acquisition.fft_wisdom_dir, "fft_wisdom_dir");
+  GetOptionalVar(yp_, keys, conf_.acquisition.fft_warmup, "fft_warmup");
+  GetOptionalVar(yp_, keys, conf_.acquisition.acquisition_rate, "acquisition_rate");
+  GetOptionalVar(yp_, keys, conf_.acquisition.aided_acquisition, "aided_acquisition");
+  GetOptionalVar(yp_, keys, conf_.acquisition.ephemeris_file, "ephemeris_file");
+  GetOptionalVar(yp_, keys, conf_.acquisition.elevation_mask, "elevation_mask");
+  GetOptionalVar(yp_, keys, conf_.acquisition.aided_doppler_sigma, "aided_doppler_sigma");
+  GetOptionalVar(yp_, keys, conf_.acquisition.fine_acquisition, "fine_acquisition");
+  GetOptionalVar(yp_, keys, conf_.acquisition.prn_backoff_ms, "prn_backoff_ms");
+  GetOptionalVar(yp_, keys, conf_.acquisition.prn_backoff_max_ms, "prn_backoff_max_ms");
+  GetOptionalVar(yp_, keys, conf_.tracking.batch_correlate, "batch_correlate");
+  GetOptionalVar(yp_, keys, conf_.tracking.fixed_point_correlate, "fixed_point_correlate");
+  GetOptionalVar(yp_, keys, conf_.tracking.packed_correlate, "packed_correlate");
+  GetOptionalVar(yp_, keys, conf_.tracking.multi_correlator_taps, "multi_correlator_taps");
+  GetOptionalVar(yp_, keys, conf_.tracking.multi_correlator_span, "multi_correlator_span");
+  GetOptionalVar(yp_, keys, conf_.tracking.loss_of_lock_ms, "loss_of_lock_ms");
+  GetOptionalVar(yp_, keys, conf_.tracking.reacq_timeout_ms, "reacq_timeout_ms");
+  GetOptionalVar(yp_, keys, conf_.tracking.reacq_doppler_width, "reacq_doppler_width");
+  GetOptionalVar(yp_, keys, conf_.tracking.reacq_doppler_rate, "reacq_doppler_rate");
+
   log_->trace("scenario: {}", conf_.general.scenario);
   log_->trace("ms_to_process: {}", conf_.general.ms_to_process);
   log_->trace("ms_chunk_size: {}", conf_.general.ms_chunk_size);
@@ -123,6 +205,8 @@ SturDR::SturDR(const std::string yaml_fname)
   log_->trace("bit_depth: {}", conf_.rfsignal.bit_depth);
   log_->trace("signals: {}", conf_.rfsignal.signals);
   log_->trace("max_channels: {}", conf_.rfsignal.max_channels);
+  log_->trace("compact_ring: {}", conf_.rfsignal.compact_ring);
+  log_->trace("single_precision: {}", conf_.rfsignal.single_precision);
   log_->trace("is_multi_antenna: {}", conf_.antenna.is_multi_antenna);
   log_->trace("n_ant: {}", conf_.antenna.n_ant);
   log_->trace("doppler_range: {}", conf_.acquisition.doppler_range);
@@ -130,6 +214,24 @@ SturDR::SturDR(const std::string yaml_fname)
   log_->trace("num_coh_per: {}", conf_.acquisition.num_coh_per);
   log_->trace("num_noncoh_per: {}", conf_.acquisition.num_noncoh_per);
   log_->trace("threshold: {}", conf_.acquisition.threshold);
+  log_->trace("cache_carrier: {}", conf_.acquisition.cache_carrier);
+  log_->trace("freq_domain_search: {}", conf_.acquisition.freq_domain_search);
+  log_->trace("async_acquisition: {}", conf_.acquisition.async_acquisition);
+  log_->trace("acquisition_workers: {}", conf_.acquisition.acquisition_workers);
+  log_->trace("max_acquisitions: {}", conf_.acquisition.max_acquisitions);
+  log_->trace("fftw_threads: {}", conf_.acquisition.fftw_threads);
+  log_->trace("acquisition_threads: {}", conf_.acquisition.acquisition_threads);
+  log_->trace("fft_planning: {}", conf_.acquisition.fft_planning);
+  log_->trace("fft_wisdom_dir: {}", conf_.acquisition.fft_wisdom_dir);
+  log_->trace("fft_warmup: {}", conf_.acquisition.fft_warmup);
+  log_->trace("acquisition_rate: {}", conf_.acquisition.acquisition_rate);
+  log_->trace("aided_acquisition: {}", conf_.acquisition.aided_acquisition);
+  log_->trace("ephemeris_file: {}", conf_.acquisition.ephemeris_file);
+  log_->trace("elevation_mask: {}", conf_.acquisition.elevation_mask);
+  log_->trace("aided_doppler_sigma: {}", conf_.acquisition.aided_doppler_sigma);
+  log_->trace("fine_acquisition: {}", conf_.acquisition.fine_acquisition);
+  log_->trace("prn_backoff_ms: {}", conf_.acquisition.prn_backoff_ms);
+  log_->trace("prn_backoff_max_ms: {}", conf_.acquisition.prn_backoff_max_ms);
   log_->trace("min_converg_time_ms: {}", conf_.tracking.min_converg_time_ms);
   log_->trace("tap_epl_wide: {}", conf_.tracking.tap_epl_wide);
   log_->trace("tap_epl: {}", conf_.tracking.tap_epl_standard);
@@ -144,6 +246,15 @@ SturDR::SturDR(const std::string yaml_fname)
   log_->trace("fll_bandwidth_narrow: {}", conf_.tracking.fll_bw_narrow);
   log_->trace("dll_bandwidth_narrow: {}", conf_.tracking.dll_bw_narrow);
   log_->trace("cno_alpha: {}", conf_.tracking.cno_alpha);
+  log_->trace("batch_correlate: {}", conf_.tracking.batch_correlate);
+  log_->trace("fixed_point_correlate: {}", conf_.tracking.fixed_point_correlate);
+  log_->trace("packed_correlate: {}", conf_.tracking.packed_correlate);
+  log_->trace("multi_correlator_taps: {}", conf_.tracking.multi_correlator_taps);
+  log_->trace("multi_correlator_span: {}", conf_.tracking.multi_correlator_span);
+  log_->trace("loss_of_lock_ms: {}", conf_.tracking.loss_of_lock_ms);
+  log_->trace("reacq_timeout_ms: {}", conf_.tracking.reacq_timeout_ms);
+  log_->trace("reacq_doppler_width: {}", conf_.tracking.reacq_doppler_width);
+  log_->trace("reacq_doppler_rate: {}", conf_.tracking.reacq_doppler_rate);
   log_->trace("meas_freq: {}", conf_.navigation.meas_freq);
   log_->trace("process_std_vel: {}", conf_.navigation.process_std_vel);
   log_->trace("process_std_att: {}", conf_.navigation.process_std_att);
@@ -155,11 +266,162 @@ SturDR::SturDR(const std::string yaml_fname)
   log_->trace("use_cno: {}", conf_.navigation.use_cno);
   log_->trace("do_vt: {}", conf_.navigation.do_vt);
 
-  // Create FFT plans
-  fftw_plans_->Create1dFftPlan(samp_per_ms_, true);
-  fftw_plans_->Create1dFftPlan(samp_per_ms_, false);
-  fftw_plans_->CreateManyFftPlan(samp_per_ms_, n_dopp_bins_, true, false);
-  fftw_plans_->CreateManyFftPlan(samp_per_ms_, n_dopp_bins_, false, false);
+  // Allocate the shared sample ring, keeping integer samples in their native type if requested
+  SampleFormat::SampleFormat format =
+      conf_.rfsignal.compact_ring
+          ? NativeSampleFormat(conf_.rfsignal.is_complex, conf_.rfsignal.bit_depth)
+          : SampleFormat::CDOUBLE;
+  if (conf_.rfsignal.single_precision && format == SampleFormat::CDOUBLE) {
+    format = SampleFormat::CFLOAT;
+  }
+  shm_ = std::make_shared<SampleRing>(
+      shm_file_size_samp_, conf_.antenna.n_ant, format, conf_.tracking.packed_correlate);
+  log_->debug("Sample ring: {:.1f} MB", static_cast<double>(shm_->Bytes()) / 1048576.0);
+  if (conf_.tracking.fixed_point_correlate && !shm_->IsInteger()) {
+    log_->warn("fixed_point_correlate requires integer samples and compact_ring, ignoring");
+  }
+  if (conf_.tracking.packed_correlate && !shm_->IsPacked()) {
+    log_->warn("packed_correlate requires 8 bit samples and compact_ring, ignoring");
+  }
+
+  // Share one correlator between the single antenna channels if requested
+  if (conf_.tracking.batch_correlate && !conf_.antenna.is_multi_antenna) {
+    batch_correlator_ = std::make_shared<BatchCorrelator>(shm_, conf_.rfsignal.max_channels);
+  }
+
+  // Build the shared code replica tables before any channel thread needs them
+  GpsL1caReplica(1);
+
+  // Set up FFT planning (the acquisition contexts create the plans of the rate they search at)
+  // many-FFT plans may split their Doppler bins across FFTW's own threads, timed plans are loaded
+  // from the wisdom of earlier runs on this host when there is some
+  const std::string &wisdom_dir = conf_.acquisition.fft_wisdom_dir;
+  if (!fftw_plans_->SetPlannerEffort(conf_.acquisition.fft_planning)) {
+    log_->warn("unknown fft_planning '{}', using estimate", conf_.acquisition.fft_planning);
+  }
+  if (!wisdom_dir.empty() && fftw_plans_->ImportWisdom(wisdom_dir)) {
+    log_->debug("loaded fftw wisdom {}", FftwWrapper::WisdomFile(wisdom_dir));
+  }
+  fftw_plans_->SetThreads(conf_.acquisition.fftw_threads);
+  if (conf_.rfsignal.single_precision) {
+    fftwf_plans_ = std::make_shared<FftwWrapperF>();
+    fftwf_plans_->SetPlannerEffort(conf_.acquisition.fft_planning);
+    if (!wisdom_dir.empty() && fftwf_plans_->ImportWisdom(wisdom_dir)) {
+      log_->debug("loaded fftwf wisdom {}", FftwWrapperF::WisdomFile(wisdom_dir));
+    }
+    fftwf_plans_->SetThreads(conf_.acquisition.fftw_threads);
+  }
+
+  // Transform every PRN's code and build the Doppler grid's carrier once instead of on each
+  // acquisition attempt (the double context only searches when there is no single precision one),
+  // at 'acquisition_rate' when the front end samples faster than the code needs
+  acq_ctx_ = std::make_shared<AcquisitionContext>(
+      fftw_plans_,
+      conf_.rfsignal.samp_freq,
+      satutils::GPS_CA_CODE_RATE<>,
+      conf_.rfsignal.intmd_freq,
+      conf_.acquisition.doppler_range,
+      conf_.acquisition.doppler_step,
+      conf_.acquisition.cache_carrier && !fftwf_plans_,
+      conf_.acquisition.freq_domain_search,
+      conf_.acquisition.acquisition_rate);
+  if (fftwf_plans_) {
+    acq_ctx_f_ = std::make_shared<AcquisitionContextF>(
+        fftwf_plans_,
+        conf_.rfsignal.samp_freq,
+        satutils::GPS_CA_CODE_RATE<>,
+        conf_.rfsignal.intmd_freq,
+        conf_.acquisition.doppler_range,
+        conf_.acquisition.doppler_step,
+        conf_.acquisition.cache_carrier,
+        conf_.acquisition.freq_domain_search,
+        conf_.acquisition.acquisition_rate);
+  }
+  uint64_t acq_samp = acq_ctx_->PeriodSamples();
+  if (acq_ctx_->Decimation() > 1) {
+    log_->debug(
+        "acquisition decimated by {} to {} samples per code period",
+        acq_ctx_->Decimation(),
+        acq_samp);
+  }
+
+  // a circular code correlation cannot be zero padded, only the sampling rate can avoid lengths
+  // with large prime factors
+  if (fftw_plans_->PaddedSize(acq_samp) != static_cast<int>(acq_samp)) {
+    log_->warn(
+        "{} samples per code period have large prime factors, {} would transform faster",
+        acq_samp,
+        FftwWrapper::SmoothSize(acq_samp));
+  }
+
+  // Split the Doppler bins of each search across 'acquisition_threads' threads (idle cores during
+  // a cold start, a busy pool falls back to the searching thread)
+  if (conf_.acquisition.acquisition_threads > 1) {
+    std::shared_ptr<WorkerPool> workers =
+        std::make_shared<WorkerPool>(conf_.acquisition.acquisition_threads);
+    if (acq_ctx_f_) {
+      acq_ctx_f_->SetWorkers(workers);
+    } else {
+      acq_ctx_->SetWorkers(workers);
+    }
+  }
+
+  // Every search runs in one of 'max_acquisitions' preallocated workspaces, so acquisition never
+  // allocates and its memory does not grow with the number of channels (searches are reduced by
+  // the streaming detector, a power map is only needed to sum non-coherent periods, and buffers of
+  // the decimating, frequency-domain and batched searches only exist when those are enabled)
+  bool keep_map = conf_.acquisition.num_noncoh_per > 1;
+  if (acq_ctx_f_) {
+    acq_pool_f_ = std::make_shared<AcquisitionWorkspacePoolF>(
+        acq_samp,
+        n_dopp_bins_,
+        acq_ctx_f_->SpectraCols(),
+        conf_.acquisition.num_coh_per,
+        conf_.acquisition.num_noncoh_per,
+        acq_ctx_f_->Decimation(),
+        acq_ctx_f_->FreqDomain(),
+        conf_.acquisition.async_acquisition,
+        conf_.acquisition.max_acquisitions,
+        keep_map);
+  } else {
+    acq_pool_ = std::make_shared<AcquisitionWorkspacePool>(
+        acq_samp,
+        n_dopp_bins_,
+        acq_ctx_->SpectraCols(),
+        conf_.acquisition.num_coh_per,
+        conf_.acquisition.num_noncoh_per,
+        acq_ctx_->Decimation(),
+        acq_ctx_->FreqDomain(),
+        conf_.acquisition.async_acquisition,
+        conf_.acquisition.max_acquisitions,
+        keep_map);
+  }
+
+  // every plan exists now, save what was timed for the next run and touch the plans once
+  if (!wisdom_dir.empty()) {
+    if (!fftw_plans_->ExportWisdom(wisdom_dir) ||
+        (fftwf_plans_ && !fftwf_plans_->ExportWisdom(wisdom_dir))) {
+      log_->warn("could not write fftw wisdom to {}", wisdom_dir);
+    }
+  }
+  if (conf_.acquisition.fft_warmup) {
+    fftw_plans_->Warmup();
+    if (fftwf_plans_) {
+      fftwf_plans_->Warmup();
+    }
+  }
+
+  // Search outside of the tracking barriers if requested
+  if (conf_.acquisition.async_acquisition) {
+    acq_engine_ = std::make_shared<AcquisitionEngine>(
+        acq_ctx_,
+        acq_ctx_f_,
+        acq_pool_,
+        acq_pool_f_,
+        conf_.acquisition.num_coh_per,
+        conf_.acquisition.num_noncoh_per,
+        conf_.acquisition.acquisition_workers);
+  }
 
   // read in the antenna positions if necessary
   if (conf_.antenna.n_ant > 1) {
@@ -174,8 +436,20 @@ SturDR::SturDR(const std::string yaml_fname)
     // std::cout << "ant_pos: \n" << conf_.antenna.ant_xyz << "\n";
   }
 
+  // Predict which satellites are up and where their Dopplers lie once the navigator has a fix, the
+  // ephemerides of an earlier run are read before the navigator starts its own log
+  if (conf_.acquisition.aided_acquisition) {
+    acq_aiding_ = std::make_shared<AcquisitionAiding>(
+        conf_.acquisition.elevation_mask / navtools::RAD2DEG<>,
+        conf_.acquisition.aided_doppler_sigma);
+    if (!conf_.acquisition.ephemeris_file.empty()) {
+      std::size_t n_eph = acq_aiding_->LoadEphemerides(conf_.acquisition.ephemeris_file);
+      log_->debug("loaded {} ephemerides from {}", n_eph, conf_.acquisition.ephemeris_file);
+    }
+  }
+
   // start navigator
-  navigator_ = std::make_unique<Navigator>(conf_, nav_queue_, running_);
+  navigator_ = std::make_unique<Navigator>(conf_, nav_queue_, running_, acq_aiding_);
 }
 
 // *=== ~SturDR ===*
@@ -260,6 +534,9 @@ void SturDR::Start() {
   barrier1_->NotifyComplete();
   barrier2_->NotifyComplete();
   nav_queue_->NotifyComplete();
+  if (acq_engine_) {
+    acq_engine_->Stop();
+  }
   for (uint8_t i = 0; i < (uint8_t)conf_.rfsignal.max_channels; i++) {
     if (!conf_.antenna.is_multi_antenna) {
       gps_l1ca_channels_[i].Join();
@@ -272,38 +549,17 @@ void SturDR::Start() {
   spdlog::shutdown();
 }
 
-// *=== GenNewPrn ===*
-void SturDR::GetNewPrn(uint8_t& prn) {
-  std::unique_lock<std::mutex> lock(prn_mtx_);
-
-  // remove prn from log
-  prns_in_use_[prn] = false;
-
-  // search for next available prn
-  while (prns_in_use_[prn_ptr_]) {
-    prn_ptr_ = prn_ptr_ % 32 + 1;
-  }
-
-  // log new prn
-  prn = prn_ptr_;
-  prns_in_use_[prn_ptr_] = true;
-  prn_ptr_ = prn_ptr_ % 32 + 1;
-}
-
 // *=== InitChannels ===*
 void SturDR::InitChannels() {
   // TODO: more constellation initializers
 
-  // initialize available prn map
-  for (uint8_t i = 1; i <= 32; i++) {
-    prns_in_use_.insert({i, false});
-  }
+  // PRNs are handed out by priority, a PRN that failed a search waits out a back-off before it is
+  // searched again (idle channels return to acquisition as PRNs come out of theirs)
+  prn_scheduler_ = std::make_shared<PrnScheduler>(
+      conf_.acquisition.prn_backoff_ms, conf_.acquisition.prn_backoff_max_ms, acq_aiding_);
 
   // initialize channels of requested type
   if (conf_.rfsignal.signals == "gps_l1ca") {
-    std::function<void(uint8_t&)> get_new_prn_func =
-        std::bind(&SturDR::GetNewPrn, this, std::placeholders::_1);
-
     if (!conf_.antenna.is_multi_antenna) {
       gps_l1ca_channels_.reserve(conf_.rfsignal.max_channels);
       for (uint8_t i = 1; i <= (uint8_t)conf_.rfsignal.max_channels; i++) {
@@ -315,8 +571,14 @@ void SturDR::InitChannels() {
             barrier1_,
             barrier2_,
             nav_queue_,
-            fftw_plans_,
-            get_new_prn_func);
+            acq_ctx_,
+            acq_ctx_f_,
+            acq_pool_,
+            acq_pool_f_,
+            acq_engine_,
+            acq_aiding_,
+            batch_correlator_,
+            prn_scheduler_);
         gps_l1ca_channels_[i - 1].Start();
       }
     } else {
@@ -330,8 +592,14 @@ void SturDR::InitChannels() {
             barrier1_,
             barrier2_,
             nav_queue_,
-            fftw_plans_,
-            get_new_prn_func);
+            acq_ctx_,
+            acq_ctx_f_,
+            acq_pool_,
+            acq_pool_f_,
+            acq_engine_,
+            acq_aiding_,
+            nullptr,
+            prn_scheduler_);
         gps_l1ca_array_channels_[i - 1].Start();
       }
     }
@@ -350,10 +618,7 @@ void SturDR::Run() {
   std::vector<T> rf_stream(shm_read_size_samp_);
   bf_[0].fseek<T>(static_cast<int>(conf_.general.ms_to_skip * samp_per_ms_));
   bf_[0].fread<T>(rf_stream.data(), shm_read_size_samp_);
-  TypeToIDouble<T>(
-      rf_stream.data(),
-      shm_->col(0).segment(shm_ptr_, shm_read_size_samp_).data(),
-      shm_read_size_samp_);
+  shm_->Write(rf_stream.data(), 0, shm_ptr_, shm_read_size_samp_);
   shm_ptr_ += shm_read_size_samp_;
   shm_ptr_ %= shm_file_size_samp_;
 
@@ -365,6 +630,9 @@ void SturDR::Run() {
 
   barrier1_->Wait();
   for (int i = 0; i <= n; i += ndot) {
+    // prn back-offs run on file time
+    prn_scheduler_->SetTime(static_cast<uint64_t>(i));
+
     // check for screen printouts every second
     if (!(i % 1000)) {
       log_->info("File time: {:.3f} s ... Processing Time: {:.3f} s", (float)i / 1000.0, sw);
@@ -381,10 +649,7 @@ void SturDR::Run() {
       // read next signal data while channels are processing
       barrier2_->Wait();
       bf_[0].fread<T>(rf_stream.data(), shm_read_size_samp_);
-      TypeToIDouble<T>(
-          rf_stream.data(),
-          shm_->col(0).segment(shm_ptr_, shm_read_size_samp_).data(),
-          shm_read_size_samp_);
+      shm_->Write(rf_stream.data(), 0, shm_ptr_, shm_read_size_samp_);
       shm_ptr_ += shm_read_size_samp_;
       shm_ptr_ %= shm_file_size_samp_;
 
@@ -405,10 +670,7 @@ void SturDR::RunComplex() {
   bf_[0].fseekc<T>(static_cast<int>(conf_.general.ms_to_skip * samp_per_ms_));
   bf_[0].freadc<T>(rf_stream.data(), shm_read_size_samp_);
 
-  ITypeToIDouble<T>(
-      rf_stream.data(),
-      shm_->col(0).segment(shm_ptr_, shm_read_size_samp_).data(),
-      shm_read_size_samp_);
+  shm_->Write(rf_stream.data(), 0, shm_ptr_, shm_read_size_samp_);
   shm_ptr_ += shm_read_size_samp_;
   shm_ptr_ %= shm_file_size_samp_;
 
@@ -420,6 +682,9 @@ void SturDR::RunComplex() {
 
   barrier1_->Wait();
   for (int i = 0; i <= n; i += ndot) {
+    // prn back-offs run on file time
+    prn_scheduler_->SetTime(static_cast<uint64_t>(i));
+
     // check for screen printouts every second
     if (!(i % 1000)) {
       log_->info("File time: {:.3f} s ... Processing Time: {:.3f} s", (float)i / 1000.0, sw);
@@ -452,10 +717,7 @@ void SturDR::RunComplex() {
       // read next signal data while channels are processing
       barrier2_->Wait();
       bf_[0].freadc<T>(rf_stream.data(), shm_read_size_samp_);
-      ITypeToIDouble<T>(
-          rf_stream.data(),
-          shm_->col(0).segment(shm_ptr_, shm_read_size_samp_).data(),
-          shm_read_size_samp_);
+      shm_->Write(rf_stream.data(), 0, shm_ptr_, shm_read_size_samp_);
       shm_ptr_ += shm_read_size_samp_;
       shm_ptr_ %= shm_file_size_samp_;
 
@@ -477,10 +739,7 @@ void SturDR::RunArray() {
   for (uint8_t j = 0; j < conf_.antenna.n_ant; j++) {
     bf_[j].fseek<T>(static_cast<int>(conf_.general.ms_to_skip * samp_per_ms_));
     bf_[j].fread<T>(rf_stream.data(), shm_read_size_samp_);
-    TypeToIDouble<T>(
-        rf_stream.data(),
-        shm_->col(j).segment(shm_ptr_, shm_read_size_samp_).data(),
-        shm_read_size_samp_);
+    shm_->Write(rf_stream.data(), j, shm_ptr_, shm_read_size_samp_);
   }
   shm_ptr_ += shm_read_size_samp_;
   shm_ptr_ %= shm_file_size_samp_;
@@ -493,6 +752,9 @@ void SturDR::RunArray() {
 
   barrier1_->Wait();
   for (int i = 0; i <= n; i += ndot) {
+    // prn back-offs run on file time
+    prn_scheduler_->SetTime(static_cast<uint64_t>(i));
+
     // check for screen printouts every second
     if (!(i % 1000)) {
       log_->info("File time: {:.3f} s ... Processing Time: {:.3f} s", (float)i / 1000.0, sw);
@@ -510,10 +772,7 @@ void SturDR::RunArray() {
       barrier2_->Wait();
       for (uint8_t j = 0; j < conf_.antenna.n_ant; j++) {
         bf_[j].fread<T>(rf_stream.data(), shm_read_size_samp_);
-        TypeToIDouble<T>(
-            rf_stream.data(),
-            shm_->col(j).segment(shm_ptr_, shm_read_size_samp_).data(),
-            shm_read_size_samp_);
+        shm_->Write(rf_stream.data(), j, shm_ptr_, shm_read_size_samp_);
       }
       shm_ptr_ += shm_read_size_samp_;
       shm_ptr_ %= shm_file_size_samp_;
@@ -535,10 +794,7 @@ void SturDR::RunComplexArray() {
   for (uint8_t j = 0; j < conf_.antenna.n_ant; j++) {
     bf_[j].fseekc<T>(static_cast<int>(conf_.general.ms_to_skip * samp_per_ms_));
     bf_[j].freadc<T>(rf_stream.data(), shm_read_size_samp_);
-    ITypeToIDouble<T>(
-        rf_stream.data(),
-        shm_->col(j).segment(shm_ptr_, shm_read_size_samp_).data(),
-        shm_read_size_samp_);
+    shm_->Write(rf_stream.data(), j, shm_ptr_, shm_read_size_samp_);
   }
   shm_ptr_ += shm_read_size_samp_;
   shm_ptr_ %= shm_file_size_samp_;
@@ -551,6 +807,9 @@ void SturDR::RunComplexArray() {
 
   barrier1_->Wait();
   for (int i = 0; i <= n; i += ndot) {
+    // prn back-offs run on file time
+    prn_scheduler_->SetTime(static_cast<uint64_t>(i));
+
     // check for screen printouts every second
     if (!(i % 1000)) {
       log_->info("File time: {:.3f} s ... Processing Time: {:.3f} s", (float)i / 1000.0, sw);
@@ -568,10 +827,7 @@ void SturDR::RunComplexArray() {
       barrier2_->Wait();
       for (uint8_t j = 0; j < conf_.antenna.n_ant; j++) {
         bf_[j].freadc<T>(rf_stream.data(), shm_read_size_samp_);
-        ITypeToIDouble<T>(
-            rf_stream.data(),
-            shm_->col(j).segment(shm_ptr_, shm_read_size_samp_).data(),
-            shm_read_size_samp_);
+        shm_->Write(rf_stream.data(), j, shm_ptr_, shm_read_size_samp_);
       }
       shm_ptr_ += shm_read_size_samp_;
       shm_ptr_ %= shm_file_size_samp_;
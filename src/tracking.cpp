@@ -156,13 +156,16 @@ void TrackingKF::Init(
     const double &init_carr_doppler,
     const double &init_code_phase,
     const double &intmd_freq,
-    const double &code_freq) {
+    const double &code_freq,
+    const double &init_doppler_var,
+    const double &init_code_var) {
   // Initialize state and covariance
   x_ << init_carr_phase, init_carr_doppler, 0.0, init_code_phase, 0.0;
   // P_.diagonal() << navtools::PI_SQU<double> / 3.0, navtools::PI_SQU<> * 125e3, 1000.0, 1.0,
   // 100.0;
-  P_.diagonal() << navtools::PI_SQU<double> / 3.0, navtools::PI_SQU<> * 62.5e3,
-      navtools::PI_SQU<> * 1e3, 5e-1, 5e2;
+  P_.setZero();
+  P_.diagonal() << navtools::PI_SQU<double> / 3.0, init_doppler_var, navtools::PI_SQU<> * 1e3,
+      init_code_var, 5e2;
 
   // Initialize dynamic model
   // make_F(init_k, init_T);
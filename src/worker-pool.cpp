@@ -0,0 +1,111 @@
+/**
+ * *worker-pool.cpp*
+ *
+ * =======  ========================================================================================
+ * @file    sturdr/worker-pool.cpp
+ * @brief   Persistent threads splitting one loop of independent tasks.
+ * @date    October 2026
+ * =======  ========================================================================================
+ */
+
+#include "sturdr/worker-pool.hpp"
+
+namespace sturdr {
+
+// *=== WorkerPool ===*
+WorkerPool::WorkerPool(const uint16_t &n_threads)
+    : fn_{nullptr}, n_{0}, next_{0}, active_{0}, gen_{0}, stop_{false} {
+  for (uint16_t i = 1; i < n_threads; i++) {
+    workers_.emplace_back(&WorkerPool::Work, this);
+  }
+}
+
+// *=== ~WorkerPool ===*
+WorkerPool::~WorkerPool() {
+  {
+    std::unique_lock<std::mutex> lock(mtx_);
+    stop_ = true;
+  }
+  start_cv_.notify_all();
+  for (std::thread &w : workers_) {
+    if (w.joinable()) {
+      w.join();
+    }
+  }
+}
+
+// *=== ParallelFor ===*
+void WorkerPool::ParallelFor(const int &n, const std::function<void(const int &)> &fn) {
+  std::unique_lock<std::mutex> owner(run_mtx_, std::try_to_lock);
+  if (!owner.owns_lock() || workers_.empty() || n < 2) {
+    for (int i = 0; i < n; i++) {
+      fn(i);
+    }
+    return;
+  }
+
+  // publish the loop, help with it, then wait for the helpers to leave it
+  {
+    std::unique_lock<std::mutex> lock(mtx_);
+    fn_ = &fn;
+    n_ = n;
+    next_.store(0, std::memory_order_relaxed);
+    active_ = workers_.size();
+    err_ = nullptr;
+    gen_++;
+  }
+  start_cv_.notify_all();
+  Run(fn, n);
+  std::exception_ptr err;
+  {
+    std::unique_lock<std::mutex> lock(mtx_);
+    done_cv_.wait(lock, [this] { return active_ == 0; });
+    fn_ = nullptr;
+    err = err_;
+  }
+  if (err) {
+    std::rethrow_exception(err);
+  }
+}
+
+// *=== Run ===*
+void WorkerPool::Run(const std::function<void(const int &)> &fn, const int &n) {
+  try {
+    for (int i = next_.fetch_add(1); i < n; i = next_.fetch_add(1)) {
+      fn(i);
+    }
+  } catch (...) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (!err_) {
+      err_ = std::current_exception();
+    }
+  }
+}
+
+// *=== Work ===*
+void WorkerPool::Work() {
+  uint64_t seen = 0;
+  while (true) {
+    const std::function<void(const int &)> *fn;
+    int n;
+    {
+      std::unique_lock<std::mutex> lock(mtx_);
+      start_cv_.wait(lock, [this, seen] { return stop_ || gen_ != seen; });
+      if (stop_) {
+        return;
+      }
+      seen = gen_;
+      fn = fn_;
+      n = n_;
+    }
+    Run(*fn, n);
+    {
+      std::unique_lock<std::mutex> lock(mtx_);
+      if (--active_ == 0) {
+        done_cv_.notify_one();
+      }
+    }
+  }
+}
+
+}  // namespace sturdr
@@ -0,0 +1,123 @@
+/**
+ * *test-common.hpp*
+ *
+ * =======  ========================================================================================
+ * @file    tests/test-common.hpp
+ * @brief   Logger, signal generators and scenarios shared by the test programs.
+ * @date    October 2026
+ * =======  ========================================================================================
+ */
+
+#ifndef STURDR_TEST_COMMON_HPP
+#define STURDR_TEST_COMMON_HPP
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "sturdr/code-replica.hpp"
+
+constexpr double TWO_PI = 6.283185307179586476925286766559;
+
+/**
+ * @brief Correlators and NCO remainders after one integration period
+ */
+struct Epl {
+  std::complex<double> E, P1, P2, L;
+  double rem_code_phase, rem_carr_phase;
+};
+
+/**
+ * *=== TestConsole ===*
+ * @brief Creates the 'sturdr-console' logger every test reports to
+ * @param file  Name of the test source file
+ * @return Console logger
+ */
+inline std::shared_ptr<spdlog::logger> TestConsole(const std::string &file) {
+  std::shared_ptr<spdlog::logger> console = spdlog::stdout_color_mt("sturdr-console");
+  console->set_pattern("\033[1;34m[%D %T.%e][%^%l%$\033[1;34m]: \033[0m%v");
+  console->set_level(spdlog::level::debug);
+  console->debug("{} initializing!", file);
+  return console;
+}
+
+/**
+ * *=== ComplexNoise ===*
+ * @brief Complex white gaussian noise of unit variance per component
+ * @param n_samp  Number of samples
+ * @param gen     Random number generator
+ * @return Noise samples
+ */
+inline Eigen::VectorXcd ComplexNoise(const uint64_t &n_samp, std::mt19937 &gen) {
+  std::normal_distribution<double> noise(0.0, 1.0);
+  Eigen::VectorXcd x(n_samp);
+  for (std::complex<double> &v : x) {
+    v = std::complex<double>(noise(gen), noise(gen));
+  }
+  return x;
+}
+
+/**
+ * *=== GpsL1caSignal ===*
+ * @brief GPS L1 C/A signal in ComplexNoise. Sample 'i' holds chip floor((code_phase + i) *
+ *        code_freq / samp_freq), evaluated in that order so whole sample shifts put chip edges
+ *        exactly where they belong (an accumulated phase step lands some of them a sample late)
+ * @param prn         Satellite PRN
+ * @param samp_freq   Sampling frequency [Hz]
+ * @param code_freq   Code frequency [Hz]
+ * @param code_phase  Code phase of the first sample [samples]
+ * @param carr_freq   Carrier frequency [Hz]
+ * @param amp         Signal amplitude
+ * @param n_samp      Number of samples
+ * @param gen         Random number generator
+ * @return Signal samples
+ */
+inline Eigen::VectorXcd GpsL1caSignal(
+    const uint8_t &prn,
+    const double &samp_freq,
+    const double &code_freq,
+    const double &code_phase,
+    const double &carr_freq,
+    const double &amp,
+    const uint64_t &n_samp,
+    std::mt19937 &gen) {
+  const sturdr::CodeReplica &code = sturdr::GpsL1caReplica(prn);
+  Eigen::VectorXcd x = ComplexNoise(n_samp, gen);
+  for (uint64_t i = 0; i < n_samp; i++) {
+    double phase = std::floor((code_phase + static_cast<double>(i)) * code_freq / samp_freq);
+    int chip = static_cast<int>(sturdr::CodeReplica::WrapPhase(phase));
+    x(i) += static_cast<double>(code.f32[chip]) *
+            std::polar(amp, TWO_PI * carr_freq * static_cast<double>(i) / samp_freq);
+  }
+  return x;
+}
+
+/**
+ * @brief Acquisition scenario, 4 ms of PRN 7 (code advanced by 1234 samples, 1100 Hz Doppler) at
+ *        half the noise amplitude, searched over +/-3 kHz in 250 Hz steps
+ */
+constexpr double ACQ_SAMP_FREQ = 2.046e6;
+constexpr double ACQ_INTMD_FREQ = 4321.0;
+constexpr double ACQ_D_RANGE = 3000.0;
+constexpr double ACQ_D_STEP = 250.0;
+
+/**
+ * *=== AcquisitionSignal ===*
+ * @brief Samples of the acquisition scenario
+ * @param seed  Noise seed
+ * @return 4 ms of samples at ACQ_SAMP_FREQ
+ */
+inline Eigen::VectorXcd AcquisitionSignal(const unsigned &seed) {
+  std::mt19937 gen(seed);
+  return GpsL1caSignal(
+      7, ACQ_SAMP_FREQ, 1.023e6, 1234.0, ACQ_INTMD_FREQ + 1100.0, 0.5, 4 * 2046, gen);
+}
+
+#endif
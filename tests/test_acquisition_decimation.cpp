@@ -0,0 +1,114 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "sturdr/acquisition-workspace.hpp"
+#include "sturdr/acquisition.hpp"
+#include "sturdr/fftw-wrapper.hpp"
+#include "test-common.hpp"
+
+constexpr double INTMD_FREQ = 12345.0;
+constexpr double DOPPLER = 750.0;
+constexpr double D_RANGE = 1000.0;
+constexpr double D_STEP = 250.0;
+
+// circular distance between two code phases [samples]
+double CodeDistance(const double &a, const double &b, const double &n) {
+  double d = std::fmod(std::abs(a - b), n);
+  return std::min(d, n - d);
+}
+
+// searches PRN 7 advanced by every offset in 'offsets' at the front end rate and decimated to
+// 'acq_freq', returns the number of searches mapping to the wrong front end code phase or bin
+int Compare(
+    std::shared_ptr<spdlog::logger> console,
+    const double &samp_freq,
+    const double &acq_freq,
+    const std::vector<int> &offsets) {
+  auto plans = std::make_shared<sturdr::FftwWrapper>();
+  sturdr::AcquisitionContext full(plans, samp_freq, 1.023e6, INTMD_FREQ, D_RANGE, D_STEP);
+  sturdr::AcquisitionContext dec(
+      plans, samp_freq, 1.023e6, INTMD_FREQ, D_RANGE, D_STEP, true, false, acq_freq);
+  uint64_t n_full = full.PeriodSamples();
+  uint64_t n_bins = static_cast<uint64_t>(full.DopplerBins().size());
+  int d = static_cast<int>(dec.Decimation());
+  sturdr::AcquisitionWorkspace ws_full(n_full, n_bins, full.SpectraCols(), 2, 1, 1, false, true);
+  sturdr::AcquisitionWorkspace ws_dec(
+      dec.PeriodSamples(), n_bins, dec.SpectraCols(), 2, 1, dec.Decimation(), false, true);
+
+  // the decimated code is sampled at every D'th front end instant, so lags scale by exactly D
+  int n_fail = 0;
+  for (int k = 0; k < static_cast<int>(dec.PeriodSamples()); k++) {
+    if (dec.FullRateSample(k) != k * d) {
+      console->error("D = {}: sample {} maps to {}", d, k, dec.FullRateSample(k));
+      n_fail++;
+      break;
+    }
+  }
+
+  std::mt19937 gen(21);
+  for (const int &offset : offsets) {
+    // 2 ms of signal, the correlation peaks at front end sample (n - offset) % n
+    Eigen::VectorXcd x = GpsL1caSignal(
+        7, samp_freq, 1.023e6, offset, INTMD_FREQ + DOPPLER, 1.0, 2 * n_full, gen);
+    double truth = static_cast<double>((n_full - offset) % n_full);
+    sturdr::AcquisitionResult a = sturdr::PcpsDetect<double>(full, ws_full, x, 7, 2, 1);
+    sturdr::AcquisitionResult b = sturdr::PcpsDetect<double>(dec, ws_dec, x, 7, 2, 1);
+    std::vector<sturdr::AcquisitionResult> m =
+        sturdr::PcpsSearchMany<double>(dec, ws_dec, x, {7}, 2, 1);
+
+    // the decimated peak is the output sample holding the true phase, within half an output
+    // sample of it, and the batched search maps it the same way
+    double n = static_cast<double>(n_full);
+    bool ok = CodeDistance(a.peak_idx[0], truth, n) <= 1.0 &&
+              CodeDistance(b.peak_idx[0], truth, n) <= 0.5 * d &&
+              CodeDistance(b.code_phase, truth, n) <= 0.5 * d && a.peak_idx[1] == b.peak_idx[1] &&
+              m[0].peak_idx[0] == b.peak_idx[0] && m[0].peak_idx[1] == b.peak_idx[1];
+    if (ok) {
+      console->info(
+          "D = {}, true phase {}: full rate {} (bin {}), decimated {} refined {:.2f} (bin {})",
+          d,
+          truth,
+          a.peak_idx[0],
+          a.peak_idx[1],
+          b.peak_idx[0],
+          b.code_phase,
+          b.peak_idx[1]);
+    } else {
+      console->error(
+          "D = {}, true phase {}: full rate {} (bin {}), decimated {} refined {:.2f} (bin {}), "
+          "batched {} (bin {})",
+          d,
+          truth,
+          a.peak_idx[0],
+          a.peak_idx[1],
+          b.peak_idx[0],
+          b.code_phase,
+          b.peak_idx[1],
+          m[0].peak_idx[0],
+          m[0].peak_idx[1]);
+      n_fail++;
+    }
+  }
+  return n_fail;
+}
+
+int main() {
+  std::shared_ptr<spdlog::logger> console = TestConsole("test_acquisition_decimation.cpp");
+
+  // even (4) and odd (3) decimation, phases on and between output samples, next to the code wrap
+  int n_fail = 0;
+  n_fail += Compare(console, 8.184e6, 2.0e6, {0, 1, 2, 3, 1234, 4095, 8181, 8183});
+  n_fail += Compare(console, 6.138e6, 2.0e6, {0, 1, 2, 1234, 6136, 6137});
+
+  if (n_fail > 0) {
+    console->error("{} decimated searches map to the wrong code phase!", n_fail);
+    return 1;
+  }
+  console->info("every decimated search maps to the front end code phase!");
+  return 0;
+}
@@ -0,0 +1,111 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <random>
+
+#include "sturdr/acquisition-workspace.hpp"
+#include "sturdr/acquisition.hpp"
+#include "sturdr/fftw-wrapper.hpp"
+#include "test-common.hpp"
+
+constexpr double L1_FREQ = 1575.42e6;
+constexpr double INTMD_FREQ = 12345.0;
+constexpr double D_RANGE = 5000.0;
+constexpr double D_STEP = 250.0;
+
+// circular distance between two code phases [samples]
+double CodeDistance(const double &a, const double &b, const double &n) {
+  double d = std::fmod(std::abs(a - b), n);
+  return std::min(d, n - d);
+}
+
+// searches 1 ms of PRN 7 at 'doppler', then advances the result by 'delay' samples the way an
+// asynchronous search is handed to tracking and compares it to the code period that really starts
+// there, returns 1 when the advanced result misses it
+int Compare(
+    std::shared_ptr<spdlog::logger> console,
+    sturdr::AcquisitionContext &ctx,
+    sturdr::AcquisitionWorkspace &ws,
+    const double &doppler,
+    const double &offset,
+    const uint64_t &delay) {
+  // the code is scaled by the carrier Doppler, a period lasts 'n_code' samples
+  uint64_t n_samp = ctx.PeriodSamples();
+  double samp_freq = static_cast<double>(n_samp) * 1000.0;
+  double code_freq = 1.023e6 * (1.0 + doppler / L1_FREQ);
+  double n_code = 1023.0 * samp_freq / code_freq;
+  double n = static_cast<double>(n_samp);
+  double delayed = offset + static_cast<double>(delay);
+  double truth = n_code * std::ceil(delayed / n_code) - delayed;
+
+  // the snapshot, and the samples the channel reads once the search completes
+  std::mt19937 gen(25);
+  Eigen::VectorXcd x0 =
+      GpsL1caSignal(7, samp_freq, code_freq, offset, INTMD_FREQ + doppler, 1.0, n_samp, gen);
+  Eigen::VectorXcd x1 =
+      GpsL1caSignal(7, samp_freq, code_freq, delayed, INTMD_FREQ + doppler, 1.0, n_samp, gen);
+  sturdr::AcquisitionResult found = sturdr::PcpsDetect<double>(ctx, ws, x0, 7, 1, 1);
+  sturdr::AcquisitionResult later = sturdr::PcpsDetect<double>(ctx, ws, x1, 7, 1, 1);
+  sturdr::AcquisitionResult advanced = found;
+  double found_doppler = -D_RANGE + static_cast<double>(found.peak_idx[1]) * D_STEP;
+  sturdr::AdvanceCodePhase(advanced, found_doppler, L1_FREQ, delay, n_samp);
+
+  // the advanced result lands where a search of the later samples does (both interpolate chip
+  // edges sampled twice per chip, so within a sample of the true phase), without the drift the
+  // snapshot's code phase is several samples off
+  bool ok = CodeDistance(advanced.code_phase, later.code_phase, n) <= 0.5 &&
+            CodeDistance(advanced.peak_idx[0], later.peak_idx[0], n) <= 1.0 &&
+            CodeDistance(advanced.code_phase, truth, n) <= 1.5 &&
+            CodeDistance(found.code_phase, later.code_phase, n) > 5.0;
+  if (ok) {
+    console->info(
+        "Doppler {} Hz, {} samples later: true phase {:.2f}, advanced {} refined {:.2f}, searched "
+        "later {:.2f} (found {:.2f})",
+        doppler,
+        delay,
+        truth,
+        advanced.peak_idx[0],
+        advanced.code_phase,
+        later.code_phase,
+        found.code_phase);
+    return 0;
+  }
+  console->error(
+      "Doppler {} Hz, {} samples later: true phase {:.2f}, advanced {} refined {:.2f}, searched "
+      "later {} refined {:.2f} (found {:.2f})",
+      doppler,
+      delay,
+      truth,
+      advanced.peak_idx[0],
+      advanced.code_phase,
+      later.peak_idx[0],
+      later.code_phase,
+      found.code_phase);
+  return 1;
+}
+
+int main() {
+  std::shared_ptr<spdlog::logger> console = TestConsole("test_acquisition_drift.cpp");
+  auto plans = std::make_shared<sturdr::FftwWrapper>();
+  sturdr::AcquisitionContext ctx(plans, 2.046e6, 1.023e6, INTMD_FREQ, D_RANGE, D_STEP);
+  uint64_t n_samp = ctx.PeriodSamples();
+  uint64_t n_bins = static_cast<uint64_t>(ctx.DopplerBins().size());
+  sturdr::AcquisitionWorkspace ws(n_samp, n_bins, ctx.SpectraCols(), 1, 1);
+
+  // a search completing 2 s after its snapshot, drifting both ways and across the code wrap
+  int n_fail = 0;
+  uint64_t delay = 2000 * n_samp;
+  n_fail += Compare(console, ctx, ws, 4000.0, 100.0, delay);
+  n_fail += Compare(console, ctx, ws, 4000.0, 2040.0, delay);
+  n_fail += Compare(console, ctx, ws, -3500.0, 1.0, delay);
+  n_fail += Compare(console, ctx, ws, -3500.0, 1234.0, delay);
+
+  if (n_fail > 0) {
+    console->error("{} delayed results miss the code period they are handed to!", n_fail);
+    return 1;
+  }
+  console->info("every delayed result follows the code Doppler drift!");
+  return 0;
+}
@@ -0,0 +1,113 @@
+#include <Eigen/Dense>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <vector>
+
+#include "sturdr/acquisition-workspace.hpp"
+#include "sturdr/acquisition.hpp"
+#include "sturdr/fftw-wrapper.hpp"
+#include "sturdr/worker-pool.hpp"
+#include "test-common.hpp"
+
+// every field of two results is exactly equal
+bool Same(const sturdr::AcquisitionResult &a, const sturdr::AcquisitionResult &b) {
+  return a.prn == b.prn && a.peak_idx[0] == b.peak_idx[0] && a.peak_idx[1] == b.peak_idx[1] &&
+         a.metric == b.metric && a.code_phase == b.code_phase && a.bin == b.bin &&
+         a.code_var == b.code_var && a.bin_var == b.bin_var;
+}
+
+// runs the same searches on a context splitting the Doppler bins across 'n_threads' threads and on
+// one searching every bin in the calling thread, returns the number of results that differ
+template <typename Real>
+int Compare(
+    std::shared_ptr<spdlog::logger> console,
+    const Eigen::VectorXcd &signal,
+    const bool &freq_domain,
+    const uint8_t &c_per,
+    const uint8_t &nc_per,
+    const uint16_t &n_threads,
+    const sturdr::DopplerWindow &window) {
+  auto plans = std::make_shared<sturdr::BasicFftwWrapper<Real>>();
+  sturdr::BasicAcquisitionContext<Real> serial(
+      plans, ACQ_SAMP_FREQ, 1.023e6, ACQ_INTMD_FREQ, ACQ_D_RANGE, ACQ_D_STEP, true, freq_domain);
+  sturdr::BasicAcquisitionContext<Real> split(
+      plans, ACQ_SAMP_FREQ, 1.023e6, ACQ_INTMD_FREQ, ACQ_D_RANGE, ACQ_D_STEP, true, freq_domain);
+  split.SetWorkers(std::make_shared<sturdr::WorkerPool>(n_threads));
+  uint64_t n_samp = serial.PeriodSamples();
+  uint64_t n_bins = static_cast<uint64_t>(serial.DopplerBins().size());
+  sturdr::BasicAcquisitionWorkspace<Real> ws_serial(
+      n_samp, n_bins, serial.SpectraCols(), c_per, nc_per, 1, freq_domain, true);
+  sturdr::BasicAcquisitionWorkspace<Real> ws_split(
+      n_samp, n_bins, split.SpectraCols(), c_per, nc_per, 1, freq_domain, true);
+  Eigen::VectorX<std::complex<Real>> x =
+      signal.head(n_samp * c_per * nc_per).template cast<std::complex<Real>>();
+
+  // full maps, streamed detections and batched searches must not depend on the split
+  const uint8_t prn = 7;
+  bool map_ok = sturdr::PcpsSearch<Real>(serial, ws_serial, x, prn, c_per, nc_per) ==
+                sturdr::PcpsSearch<Real>(split, ws_split, x, prn, c_per, nc_per);
+  sturdr::AcquisitionResult det_serial =
+      sturdr::PcpsDetect<Real>(serial, ws_serial, x, prn, c_per, nc_per, false, window);
+  sturdr::AcquisitionResult det_split =
+      sturdr::PcpsDetect<Real>(split, ws_split, x, prn, c_per, nc_per, false, window);
+  bool det_ok = Same(det_serial, det_split) &&
+                ws_serial.detector.GlrtMetric() == ws_split.detector.GlrtMetric();
+  std::vector<sturdr::AcquisitionResult> many_serial =
+      sturdr::PcpsSearchMany<Real>(serial, ws_serial, x, {prn, 12}, c_per, nc_per, {window});
+  std::vector<sturdr::AcquisitionResult> many_split =
+      sturdr::PcpsSearchMany<Real>(split, ws_split, x, {prn, 12}, c_per, nc_per, {window});
+  bool many_ok = Same(many_serial[0], many_split[0]) && Same(many_serial[1], many_split[1]);
+
+  if (map_ok && det_ok && many_ok) {
+    console->info(
+        "{} bytes, freq_domain {}, c_per {}, nc_per {}, {} threads, bins [{}, +{}]: peak ({}, {}) "
+        "metric {:.4f}",
+        sizeof(Real),
+        freq_domain,
+        c_per,
+        nc_per,
+        n_threads,
+        window.first_bin,
+        window.num_bins,
+        det_split.peak_idx[0],
+        det_split.peak_idx[1],
+        det_split.metric);
+    return 0;
+  }
+  console->error(
+      "{} bytes, freq_domain {}, c_per {}, nc_per {}, {} threads, bins [{}, +{}]: map {}, detect "
+      "{}, many {}",
+      sizeof(Real),
+      freq_domain,
+      c_per,
+      nc_per,
+      n_threads,
+      window.first_bin,
+      window.num_bins,
+      map_ok ? "same" : "DIFFERENT",
+      det_ok ? "same" : "DIFFERENT",
+      many_ok ? "same" : "DIFFERENT");
+  return 1;
+}
+
+int main() {
+  std::shared_ptr<spdlog::logger> console = TestConsole("test_acquisition_threads.cpp");
+  Eigen::VectorXcd signal = AcquisitionSignal(18);
+
+  // uneven splits of the 25 bins (and of an aided window of 9), in time and frequency domain
+  int n_fail = 0;
+  n_fail += Compare<double>(console, signal, false, 1, 1, 3, {});
+  n_fail += Compare<double>(console, signal, false, 2, 2, 4, {});
+  n_fail += Compare<double>(console, signal, false, 1, 2, 3, {14, 9});
+  n_fail += Compare<double>(console, signal, true, 2, 1, 3, {});
+  n_fail += Compare<float>(console, signal, false, 1, 2, 4, {});
+  n_fail += Compare<float>(console, signal, true, 1, 1, 3, {14, 9});
+
+  if (n_fail > 0) {
+    console->error("{} threaded searches differ from the single thread search!", n_fail);
+    return 1;
+  }
+  console->info("every threaded search is bit-identical to the single thread search!");
+  return 0;
+}
@@ -0,0 +1,180 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+#include "sturdr/code-replica.hpp"
+#include "sturdr/fixed-correlator.hpp"
+#include "sturdr/gnss-signal.hpp"
+#include "sturdr/sample-ring.hpp"
+#include "sturdr/simd-correlator.hpp"
+#include "test-common.hpp"
+
+constexpr double SAMP_FREQ = 20e6;
+constexpr double INTMD_FREQ = 5e6;
+constexpr double DOPPLER = 1234.5;
+constexpr uint64_t N_SAMP = 20000;
+constexpr double CODE_PHASE = 345.6;
+
+// one integration period in two calls, on the double or the fixed-point path, widened at the end
+// like ChannelGpsL1ca::Dump
+Epl Run(const sturdr::SampleRing &ring, const sturdr::CodeReplica &code, const bool &fixed) {
+  double code_freq = 1.023e6 + DOPPLER / 1540.0;
+  double carr_freq = TWO_PI * (INTMD_FREQ + DOPPLER);
+  double carr_jit = 0.0;
+  double samp_freq = SAMP_FREQ;
+  double t_space = 0.25;
+  uint64_t half_samp = N_SAMP / 2;
+  uint64_t samp_remaining = N_SAMP;
+  Epl r{0.0, 0.0, 0.0, 0.0, CODE_PHASE, 0.0};
+  sturdr::FixedEPL epl;
+  const uint64_t split[3] = {0, 7777, N_SAMP};
+  for (int k = 0; k < 2; k++) {
+    uint64_t n = split[k + 1] - split[k];
+    if (fixed) {
+      sturdr::AccumulateEPLFixed(
+          ring,
+          split[k],
+          n,
+          code,
+          r.rem_code_phase,
+          code_freq,
+          r.rem_carr_phase,
+          carr_freq,
+          carr_jit,
+          samp_freq,
+          half_samp,
+          samp_remaining,
+          t_space,
+          epl);
+    } else {
+      sturdr::AccumulateEPL(
+          ring,
+          split[k],
+          n,
+          code,
+          r.rem_code_phase,
+          code_freq,
+          r.rem_carr_phase,
+          carr_freq,
+          carr_jit,
+          samp_freq,
+          half_samp,
+          samp_remaining,
+          t_space,
+          r.E,
+          r.P1,
+          r.P2,
+          r.L);
+    }
+  }
+  if (fixed) {
+    sturdr::WidenEPL(epl, r.E, r.P1, r.P2, r.L);
+  }
+  return r;
+}
+
+int main() {
+  std::shared_ptr<spdlog::logger> console = TestConsole("test_fixed_correlator.cpp");
+
+  // 1 ms of PRN 7 at 0 dB per sample SNR, quantized to each native format (the replica rounds to
+  // the nearest chip, so the generated code starts half a chip further in)
+  const sturdr::CodeReplica &code = sturdr::GpsL1caReplica(7);
+  std::mt19937 gen(7);
+  double code_freq = 1.023e6 + DOPPLER / 1540.0;
+  Eigen::VectorXcd signal = GpsL1caSignal(
+      7,
+      SAMP_FREQ,
+      code_freq,
+      (CODE_PHASE + 0.5) * SAMP_FREQ / code_freq,
+      INTMD_FREQ + DOPPLER,
+      1.0,
+      N_SAMP,
+      gen);
+  auto quantize = [](const double &x, const double &scale, const double &lim) {
+    return std::clamp(std::round(x * scale), -lim, lim);
+  };
+  std::vector<int8_t> r8(N_SAMP);
+  std::vector<int16_t> r16(N_SAMP);
+  std::vector<std::complex<int8_t>> c8(N_SAMP);
+  std::vector<std::complex<int16_t>> c16(N_SAMP);
+  for (uint64_t i = 0; i < N_SAMP; i++) {
+    r8[i] = static_cast<int8_t>(quantize(signal(i).real(), 32.0, 127.0));
+    r16[i] = static_cast<int16_t>(quantize(signal(i).real(), 4096.0, 32767.0));
+    c8[i] = std::complex<int8_t>(
+        static_cast<int8_t>(quantize(signal(i).real(), 32.0, 127.0)),
+        static_cast<int8_t>(quantize(signal(i).imag(), 32.0, 127.0)));
+    c16[i] = std::complex<int16_t>(
+        static_cast<int16_t>(quantize(signal(i).real(), 4096.0, 32767.0)),
+        static_cast<int16_t>(quantize(signal(i).imag(), 4096.0, 32767.0)));
+  }
+  sturdr::SampleRing ring_r8(N_SAMP, 1, sturdr::SampleFormat::INT8);
+  sturdr::SampleRing ring_r16(N_SAMP, 1, sturdr::SampleFormat::INT16);
+  sturdr::SampleRing ring_c8(N_SAMP, 1, sturdr::SampleFormat::CINT8);
+  sturdr::SampleRing ring_c16(N_SAMP, 1, sturdr::SampleFormat::CINT16);
+  ring_r8.Write(r8.data(), 0, 0, N_SAMP);
+  ring_r16.Write(r16.data(), 0, 0, N_SAMP);
+  ring_c8.Write(c8.data(), 0, 0, N_SAMP);
+  ring_c16.Write(c16.data(), 0, 0, N_SAMP);
+
+  // the 64 phase carrier table is off by at most half a step (pi/64 rad) and half an LSB of its
+  // amplitude, so each correlator may differ from the double path by that fraction of the prompt
+  const double tol =
+      std::sin(TWO_PI / sturdr::FIXED_CARR_SIZE / 2.0) + 0.5 / sturdr::FIXED_CARR_AMP;
+  const std::pair<const char *, const sturdr::SampleRing *> rings[4] = {
+      {"INT8", &ring_r8}, {"INT16", &ring_r16}, {"CINT8", &ring_c8}, {"CINT16", &ring_c16}};
+  sturdr::SimdLevel::SimdLevel best = sturdr::DetectSimdLevel();
+  int n_fail = 0;
+  for (const auto &[name, ring] : rings) {
+    sturdr::SetSimdLevel(sturdr::SimdLevel::SCALAR);
+    Epl ref = Run(*ring, code, false);
+    double prompt = std::abs(ref.P1 + ref.P2);
+    if (prompt <= std::max(std::abs(ref.E), std::abs(ref.L))) {
+      console->error("{}: the double path did not find the prompt peak!", name);
+      n_fail++;
+      continue;
+    }
+
+    // generic and avx2 integer kernels
+    for (int lvl = sturdr::SimdLevel::SCALAR; lvl <= static_cast<int>(best); lvl++) {
+      sturdr::SetSimdLevel(static_cast<sturdr::SimdLevel::SimdLevel>(lvl));
+      Epl fix = Run(*ring, code, true);
+      double err = std::max(
+                       {std::abs(fix.E - ref.E),
+                        std::abs(fix.P1 - ref.P1),
+                        std::abs(fix.P2 - ref.P2),
+                        std::abs(fix.L - ref.L)}) /
+                   prompt;
+      double nco_err = std::max(
+          std::abs(fix.rem_code_phase - ref.rem_code_phase),
+          std::abs(fix.rem_carr_phase - ref.rem_carr_phase));
+      if (err > tol || nco_err > 1e-9) {
+        console->error(
+            "{} level {}: correlator error {:.3e} of the prompt (tolerance {:.3e}), nco error "
+            "{:.3e}",
+            name,
+            lvl,
+            err,
+            tol,
+            nco_err);
+        n_fail++;
+      } else {
+        console->info(
+            "{} level {}: correlator error {:.3e} of the prompt (tolerance {:.3e})",
+            name,
+            lvl,
+            err,
+            tol);
+      }
+    }
+  }
+
+  if (n_fail > 0) {
+    console->error("{} fixed-point correlators disagree with the double path!", n_fail);
+    return 1;
+  }
+  console->info("every fixed-point correlator matches the double path!");
+  return 0;
+}
@@ -0,0 +1,190 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+#include "sturdr/code-replica.hpp"
+#include "sturdr/fixed-correlator.hpp"
+#include "sturdr/gnss-signal.hpp"
+#include "sturdr/packed-correlator.hpp"
+#include "sturdr/sample-ring.hpp"
+#include "sturdr/simd-correlator.hpp"
+#include "test-common.hpp"
+
+constexpr double SAMP_FREQ = 20e6;
+constexpr double DOPPLER = 1234.5;
+constexpr uint64_t N_SAMP = 20000;
+constexpr double CODE_PHASE = 345.6;
+
+// one integration period in two calls, on the double or the packed path, widened at the end like
+// ChannelGpsL1ca::Dump
+Epl Run(
+    const sturdr::SampleRing &ring,
+    const sturdr::CodeReplica &code,
+    const double &intmd_freq,
+    const double &carr_phase,
+    const bool &packed) {
+  double code_freq = 1.023e6 + DOPPLER / 1540.0;
+  double carr_freq = TWO_PI * intmd_freq;
+  double carr_jit = 0.0;
+  double samp_freq = SAMP_FREQ;
+  double t_space = 0.25;
+  uint64_t half_samp = N_SAMP / 2;
+  uint64_t samp_remaining = N_SAMP;
+  Epl r{0.0, 0.0, 0.0, 0.0, CODE_PHASE, carr_phase};
+  sturdr::FixedEPL epl;
+  const uint64_t split[3] = {0, 7777, N_SAMP};
+  for (int k = 0; k < 2; k++) {
+    uint64_t n = split[k + 1] - split[k];
+    if (packed) {
+      sturdr::AccumulateEPLPacked(
+          ring,
+          split[k],
+          n,
+          code,
+          r.rem_code_phase,
+          code_freq,
+          r.rem_carr_phase,
+          carr_freq,
+          carr_jit,
+          samp_freq,
+          half_samp,
+          samp_remaining,
+          t_space,
+          epl);
+    } else {
+      sturdr::AccumulateEPL(
+          ring,
+          split[k],
+          n,
+          code,
+          r.rem_code_phase,
+          code_freq,
+          r.rem_carr_phase,
+          carr_freq,
+          carr_jit,
+          samp_freq,
+          half_samp,
+          samp_remaining,
+          t_space,
+          r.E,
+          r.P1,
+          r.P2,
+          r.L);
+    }
+  }
+  if (packed) {
+    sturdr::WidenEPL(epl, r.E, r.P1, r.P2, r.L);
+  }
+  return r;
+}
+
+// largest correlator difference relative to the prompt, after mapping 'ref' through 'gain'
+double MaxError(const Epl &a, const Epl &ref, const std::complex<double> &gain) {
+  return std::max(
+             {std::abs(a.E - gain * ref.E),
+              std::abs(a.P1 - gain * ref.P1),
+              std::abs(a.P2 - gain * ref.P2),
+              std::abs(a.L - gain * ref.L)}) /
+         std::abs(gain * (ref.P1 + ref.P2));
+}
+
+int main() {
+  std::shared_ptr<spdlog::logger> console = TestConsole("test_packed_correlator.cpp");
+
+  // 1 ms of PRN 7 in noise, either at baseband (carrier already wiped) or at an intermediate
+  // frequency, quantized to 2-bit sign/magnitude (+/-1, +/-3), the generated code starts half a
+  // chip further in as the replica rounds to the nearest chip
+  const sturdr::CodeReplica &code = sturdr::GpsL1caReplica(7);
+  std::mt19937 gen(7);
+  double code_freq = 1.023e6 + DOPPLER / 1540.0;
+  auto make_ring = [&](const double &amp, const double &freq) {
+    double code_phase = (CODE_PHASE + 0.5) * SAMP_FREQ / code_freq;
+    Eigen::VectorXcd s =
+        GpsL1caSignal(7, SAMP_FREQ, code_freq, code_phase, freq, amp, N_SAMP, gen);
+    auto quantize = [](const double &v) {
+      return static_cast<int8_t>((v < 0.0 ? -1 : 1) * (std::abs(v) > 1.0 ? 3 : 1));
+    };
+    std::vector<std::complex<int8_t>> x(N_SAMP);
+    for (uint64_t i = 0; i < N_SAMP; i++) {
+      x[i] = std::complex<int8_t>(quantize(s(i).real()), quantize(s(i).imag()));
+    }
+
+    // written in blocks that do not line up with the 64 sample plane words
+    sturdr::SampleRing ring(N_SAMP, 1, sturdr::SampleFormat::CINT8, true);
+    for (uint64_t k = 0; k < N_SAMP; k += 1000) {
+      ring.Write(x.data() + k, 0, k, std::min<uint64_t>(1000, N_SAMP - k));
+    }
+    return ring;
+  };
+  sturdr::SampleRing baseband = make_ring(1.0, 0.0);
+  sturdr::SampleRing intmd = make_ring(0.25, 5e6 + DOPPLER);
+
+  sturdr::SimdLevel::SimdLevel best = sturdr::DetectSimdLevel();
+  int n_fail = 0;
+  auto check = [&](const char *name, const double &err, const double &tol, const int &lvl) {
+    if (err > tol) {
+      console->error(
+          "{} level {}: correlator error {:.3e} of the prompt (tolerance {:.3e})",
+          name,
+          lvl,
+          err,
+          tol);
+      n_fail++;
+    } else {
+      console->info(
+          "{} level {}: correlator error {:.3e} of the prompt (tolerance {:.3e})",
+          name,
+          lvl,
+          err,
+          tol);
+    }
+  };
+
+  // with a carrier of constant phase 'phi' the square wave replica is exactly
+  // (sgn(cos(phi)) - i*sgn(sin(phi))) where the double path applies exp(-i*phi), so the two only
+  // differ by the rounding of the fixed-point code phase
+  const double quadrant_phases[4] = {0.3, 2.0, 3.5, 5.0};
+  for (const double &phi : quadrant_phases) {
+    sturdr::SetSimdLevel(sturdr::SimdLevel::SCALAR);
+    Epl ref = Run(baseband, code, 0.0, phi, false);
+    std::complex<double> gain =
+        std::complex<double>(std::cos(phi) < 0 ? -1.0 : 1.0, std::sin(phi) < 0 ? 1.0 : -1.0) *
+        std::polar(1.0, phi);
+    for (int lvl = sturdr::SimdLevel::SCALAR; lvl <= static_cast<int>(best); lvl++) {
+      sturdr::SetSimdLevel(static_cast<sturdr::SimdLevel::SimdLevel>(lvl));
+      Epl pkd = Run(baseband, code, 0.0, phi, true);
+      check("baseband", MaxError(pkd, ref, gain), 1e-3, lvl);
+    }
+  }
+
+  // a moving carrier is replaced by a square wave, (4/pi)*exp(-i*theta) plus odd harmonics
+  // holding the rest of its power (2 - 16/pi^2), so the packed correlators are the double ones
+  // scaled by 4/pi plus noise of that power times the sample energy, allowed up to 5 sigma (the
+  // signal is kept 12 dB below the noise so its own quantization harmonics stay negligible)
+  sturdr::SetSimdLevel(sturdr::SimdLevel::SCALAR);
+  Epl ref = Run(intmd, code, 5e6 + DOPPLER, 0.0, false);
+  std::vector<std::complex<double>> x(N_SAMP);
+  intmd.Read(x.data(), 0, 0, N_SAMP);
+  double energy = 0.0;
+  for (const std::complex<double> &v : x) {
+    energy += std::norm(v);
+  }
+  const double PI = TWO_PI / 2.0;
+  double tol = 5.0 * std::sqrt(energy * (2.0 - 16.0 / (PI * PI))) /
+               std::abs(4.0 / PI * (ref.P1 + ref.P2));
+  for (int lvl = sturdr::SimdLevel::SCALAR; lvl <= static_cast<int>(best); lvl++) {
+    sturdr::SetSimdLevel(static_cast<sturdr::SimdLevel::SimdLevel>(lvl));
+    Epl pkd = Run(intmd, code, 5e6 + DOPPLER, 0.0, true);
+    check("intermediate frequency", MaxError(pkd, ref, 4.0 / PI), tol, lvl);
+  }
+
+  if (n_fail > 0) {
+    console->error("{} packed correlators disagree with the double path!", n_fail);
+    return 1;
+  }
+  console->info("every packed correlator matches the double path!");
+  return 0;
+}
@@ -0,0 +1,112 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "sturdr/acquisition-workspace.hpp"
+#include "sturdr/acquisition.hpp"
+#include "sturdr/fftw-wrapper.hpp"
+#include "test-common.hpp"
+
+// relative difference of two metrics
+double RelError(const double &a, const double &b) {
+  return std::abs(a - b) / std::max(1.0, std::abs(b));
+}
+
+// compares the streaming detector (PcpsDetect and PcpsSearchMany) with the full map tests, returns
+// the number of mismatches
+template <typename Real>
+int Compare(
+    std::shared_ptr<spdlog::logger> console,
+    const Eigen::VectorXcd &signal,
+    const uint8_t &c_per,
+    const uint8_t &nc_per) {
+  auto plans = std::make_shared<sturdr::BasicFftwWrapper<Real>>();
+  sturdr::BasicAcquisitionContext<Real> ctx(
+      plans, ACQ_SAMP_FREQ, 1.023e6, ACQ_INTMD_FREQ, ACQ_D_RANGE, ACQ_D_STEP);
+  uint64_t n_samp = ctx.PeriodSamples();
+  uint64_t n_bins = static_cast<uint64_t>(ctx.DopplerBins().size());
+  sturdr::BasicAcquisitionWorkspace<Real> ws(
+      n_samp, n_bins, ctx.SpectraCols(), c_per, nc_per, 1, false, true);
+  Eigen::VectorX<std::complex<Real>> x =
+      signal.head(n_samp * c_per * nc_per).template cast<std::complex<Real>>();
+  // only the summation order differs (single precision searches sum the input power in float)
+  const double tol = std::is_same_v<Real, double> ? 1e-9 : 1e-5;
+
+  // full maps of the signal's PRN and a PRN that is absent
+  const std::vector<uint8_t> prns = {7, 12};
+  int n_fail = 0;
+  std::vector<sturdr::AcquisitionResult> many =
+      sturdr::PcpsSearchMany<Real>(ctx, ws, x, prns, c_per, nc_per);
+  for (std::size_t k = 0; k < prns.size(); k++) {
+    Eigen::MatrixXd map =
+        sturdr::PcpsSearch<Real>(ctx, ws, x, prns[k], c_per, nc_per).template cast<double>();
+    int p2n_idx[2], glrt_idx[2];
+    double p2n, glrt;
+    sturdr::Peak2NoiseFloorTest<double>(map, p2n_idx, p2n);
+    sturdr::GlrtTest(map, glrt_idx, glrt, x.template cast<std::complex<double>>());
+
+    // streamed reductions of the same map
+    sturdr::AcquisitionResult det = sturdr::PcpsDetect<Real>(ctx, ws, x, prns[k], c_per, nc_per);
+    double det_glrt = ws.detector.GlrtMetric();
+
+    bool ok = det.peak_idx[0] == p2n_idx[0] && det.peak_idx[1] == p2n_idx[1] &&
+              many[k].peak_idx[0] == p2n_idx[0] && many[k].peak_idx[1] == p2n_idx[1] &&
+              RelError(det.metric, p2n) < tol && RelError(many[k].metric, p2n) < tol &&
+              RelError(det_glrt, glrt) < tol;
+    if (ok) {
+      console->info(
+          "{} bytes, c_per {}, nc_per {}, prn {}: peak ({}, {}) p2n {:.4f} glrt {:.1f}",
+          sizeof(Real),
+          c_per,
+          nc_per,
+          prns[k],
+          p2n_idx[0],
+          p2n_idx[1],
+          p2n,
+          glrt);
+    } else {
+      console->error(
+          "{} bytes, c_per {}, nc_per {}, prn {}: map peak ({}, {}) p2n {} glrt {} | detect "
+          "({}, {}) p2n {} glrt {} | many ({}, {}) p2n {}",
+          sizeof(Real),
+          c_per,
+          nc_per,
+          prns[k],
+          p2n_idx[0],
+          p2n_idx[1],
+          p2n,
+          glrt,
+          det.peak_idx[0],
+          det.peak_idx[1],
+          det.metric,
+          det_glrt,
+          many[k].peak_idx[0],
+          many[k].peak_idx[1],
+          many[k].metric);
+      n_fail++;
+    }
+  }
+  return n_fail;
+}
+
+int main() {
+  std::shared_ptr<spdlog::logger> console = TestConsole("test_peak_detector.cpp");
+  Eigen::VectorXcd signal = AcquisitionSignal(17);
+
+  int n_fail = 0;
+  n_fail += Compare<double>(console, signal, 1, 1);
+  n_fail += Compare<double>(console, signal, 2, 1);
+  n_fail += Compare<double>(console, signal, 1, 3);
+  n_fail += Compare<float>(console, signal, 2, 2);
+
+  if (n_fail > 0) {
+    console->error("{} streamed detections disagree with the full map tests!", n_fail);
+    return 1;
+  }
+  console->info("every streamed detection matches the full map tests!");
+  return 0;
+}
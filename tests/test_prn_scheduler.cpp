@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "sturdr/prn-scheduler.hpp"
+#include "test-common.hpp"
+
+constexpr uint64_t BACKOFF_MS = 1000;
+constexpr uint64_t MAX_BACKOFF_MS = 8000;
+
+int n_fail = 0;
+
+// compares a claimed PRN with the one expected
+void Check(
+    std::shared_ptr<spdlog::logger> console,
+    const std::string &what,
+    const uint8_t &prn,
+    const uint8_t &expected) {
+  if (prn == expected) {
+    console->info("{}: claimed {}", what, prn);
+  } else {
+    console->error("{}: claimed {}, expected {}", what, prn, expected);
+    n_fail++;
+  }
+}
+
+// claims every PRN, so later claims only see the PRNs that are failed or released
+void HoldAll(std::shared_ptr<spdlog::logger> console, sturdr::PrnScheduler &s) {
+  std::vector<uint8_t> held;
+  for (uint8_t prn = s.Claim(); prn > 0; prn = s.Claim()) {
+    held.push_back(prn);
+  }
+  std::sort(held.begin(), held.end());
+  if (held.size() != sturdr::PrnScheduler::N_PRN ||
+      std::adjacent_find(held.begin(), held.end()) != held.end()) {
+    console->error("{} distinct PRNs handed out instead of 32!", held.size());
+    n_fail++;
+  }
+}
+
+int main() {
+  std::shared_ptr<spdlog::logger> console = TestConsole("test_prn_scheduler.cpp");
+
+  // consecutive failures double the back-off up to its cap, a claim is refused 1 ms before the
+  // back-off ends and granted when it does
+  {
+    sturdr::PrnScheduler s(BACKOFF_MS, MAX_BACKOFF_MS);
+    HoldAll(console, s);
+    uint64_t now = 0;
+    const uint64_t expected[6] = {1000, 2000, 4000, 8000, 8000, 8000};
+    for (const uint64_t &backoff : expected) {
+      s.Failed(5, 1.0);
+      s.SetTime(now + backoff - 1);
+      Check(console, "back-off " + std::to_string(backoff) + " ms - 1", s.Claim(), 0);
+      now += backoff;
+      s.SetTime(now);
+      Check(console, "back-off " + std::to_string(backoff) + " ms", s.Claim(), 5);
+    }
+
+    // a failure just inside twice the cap continues the capped back-off
+    s.Failed(5, 1.0);
+    now += 2 * MAX_BACKOFF_MS - 1;
+    s.SetTime(now);
+    Check(console, "retry just before forgetting", s.Claim(), 5);
+    s.Failed(5, 1.0);
+    s.SetTime(now + MAX_BACKOFF_MS - 1);
+    Check(console, "still capped", s.Claim(), 0);
+
+    // one twice the cap after the last is forgotten and starts over at the first back-off
+    now += 2 * MAX_BACKOFF_MS;
+    s.SetTime(now);
+    Check(console, "forgotten", s.Claim(), 5);
+    s.Failed(5, 1.0);
+    s.SetTime(now + BACKOFF_MS - 1);
+    Check(console, "restarted back-off - 1", s.Claim(), 0);
+    s.SetTime(now + BACKOFF_MS);
+    Check(console, "restarted back-off", s.Claim(), 5);
+  }
+
+  // PRNs out of their back-off are retried highest metric first, after every PRN without a
+  // remembered failure (including one whose failure was forgotten)
+  {
+    sturdr::PrnScheduler s(BACKOFF_MS, MAX_BACKOFF_MS);
+    HoldAll(console, s);
+    s.Failed(11, 9.0);
+    s.SetTime(2 * MAX_BACKOFF_MS);
+    s.Failed(3, 1.2);
+    s.Failed(9, 2.5);
+    s.Failed(20, 1.8);
+    s.Release(30);
+    s.SetTime(2 * MAX_BACKOFF_MS + BACKOFF_MS);
+    const uint8_t expected[6] = {11, 30, 9, 20, 3, 0};
+    for (const uint8_t &prn : expected) {
+      Check(console, "retry order", s.Claim(), prn);
+    }
+  }
+
+  // without a back-off a failed PRN is handed out again at once, in round robin order
+  {
+    sturdr::PrnScheduler s(0, 0);
+    HoldAll(console, s);
+    s.Failed(7, 1.0);
+    s.Release(3);
+    const uint8_t expected[3] = {3, 7, 0};
+    for (const uint8_t &prn : expected) {
+      Check(console, "no back-off", s.Claim(), prn);
+    }
+  }
+
+  // once the aiding has predicted, claims follow its order (every PRN without an ephemeris, in
+  // order) instead of the round robin, which would go on after the last PRN handed out
+  {
+    auto aiding = std::make_shared<sturdr::AcquisitionAiding>(0.0, 100.0);
+    sturdr::PrnScheduler s(BACKOFF_MS, MAX_BACKOFF_MS, aiding);
+    Check(console, "round robin", s.Claim(), 1);
+    s.Release(1);
+    Check(console, "round robin", s.Claim(), 2);
+    s.Release(2);
+    aiding->Predict(0.0, Eigen::Vector3d(6378137.0, 0.0, 0.0), Eigen::Vector3d::Zero(), 0.0);
+    Check(console, "prediction not published yet", s.Claim(), 3);
+    s.Release(3);
+    s.SetTime(1);
+    Check(console, "aided order", s.Claim(), 1);
+    Check(console, "aided order", s.Claim(), 2);
+  }
+
+  if (n_fail > 0) {
+    console->error("{} claims disagree with the back-off schedule!", n_fail);
+    return 1;
+  }
+  console->info("every claim follows the back-off schedule!");
+  return 0;
+}
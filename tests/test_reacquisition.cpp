@@ -0,0 +1,120 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "sturdr/reacquisition.hpp"
+#include "test-common.hpp"
+
+constexpr uint64_t LOSS_MS = 1000;
+constexpr uint64_t TIMEOUT_MS = 5000;
+constexpr uint64_t CONVERGE_MS = 500;
+constexpr double WIDTH = 250.0;
+constexpr double RATE = 500.0;
+constexpr double D_RANGE = 5000.0;
+constexpr double D_STEP = 250.0;
+
+int n_fail = 0;
+
+// compares a value with the one expected
+template <typename T>
+void Check(
+    std::shared_ptr<spdlog::logger> console,
+    const std::string &what,
+    const T &value,
+    const T &expected) {
+  if (value == expected) {
+    console->info("{}: {}", what, value);
+  } else {
+    console->error("{}: {}, expected {}", what, value, expected);
+    n_fail++;
+  }
+}
+
+// compares a search window with the bins expected
+void CheckWindow(
+    std::shared_ptr<spdlog::logger> console,
+    const std::string &what,
+    const sturdr::DopplerWindow &window,
+    const int &first_bin,
+    const int &num_bins) {
+  Check(console, what + " first bin", window.first_bin, first_bin);
+  Check(console, what + " bins", window.num_bins, num_bins);
+}
+
+// 1 ms epochs without code lock until the track is lost, returns the time it took [ms]
+uint64_t LoseLock(sturdr::Reacquisition &r, const double &noisy_doppler) {
+  uint64_t ms = 0;
+  while (ms < 100000) {
+    ms++;
+    if (r.Update(false, noisy_doppler, 1)) {
+      break;
+    }
+  }
+  return ms;
+}
+
+int main() {
+  std::shared_ptr<spdlog::logger> console = TestConsole("test_reacquisition.cpp");
+
+  // TRACKING -> REACQUIRING -> TRACKING: the loss comes 'loss_of_lock_ms' after the last lock and
+  // the window centers on that epoch's Doppler, not the noise tracked after it
+  {
+    sturdr::Reacquisition r(LOSS_MS, TIMEOUT_MS, WIDTH, RATE, D_RANGE, D_STEP);
+    r.Start(1100.0, CONVERGE_MS);
+    for (int i = 0; i <= 50; i++) {
+      r.Update(true, 1100.0 + i, 1);
+    }
+    Check(console, "locked to lost (ms)", LoseLock(r, 3000.0), LOSS_MS);
+    Check(console, "window center (Hz)", r.Doppler(), 1150.0);
+    Check(console, "time reacquiring (ms)", r.Elapsed(), uint64_t{0});
+    CheckWindow(console, "first window", r.Window(), 24, 3);
+
+    // the window only widens with the time spent searching, asking for it changes nothing
+    CheckWindow(console, "same window", r.Window(), 24, 3);
+    r.Elapse(1000);
+    Check(console, "half width after 1 s (Hz)", r.Width(), 750.0);
+    CheckWindow(console, "window after 1 s", r.Window(), 22, 7);
+    Check<int>(console, "missed", r.Searched(false), sturdr::ChannelState::REACQUIRING);
+    Check<int>(console, "found", r.Searched(true), sturdr::ChannelState::TRACKING);
+
+    // the next track gets the grace period again, and its loss starts a new narrow window
+    r.Start(900.0, CONVERGE_MS);
+    Check(console, "unlocked track to lost (ms)", LoseLock(r, -400.0), CONVERGE_MS + LOSS_MS);
+    Check(console, "acquired window center (Hz)", r.Doppler(), 900.0);
+    CheckWindow(console, "restarted window", r.Window(), 23, 3);
+  }
+
+  // TRACKING -> REACQUIRING -> ACQUIRING: the window widens until the timeout, clamped to the
+  // grid, then the channel falls back to a full acquisition (and IDLE if that fails too)
+  {
+    sturdr::Reacquisition r(LOSS_MS, TIMEOUT_MS, WIDTH, RATE, D_RANGE, D_STEP);
+    r.Start(4900.0, CONVERGE_MS);
+    r.Update(true, 4900.0, 1);
+    LoseLock(r, 0.0);
+    for (int i = 0; i < 4; i++) {
+      r.Elapse(1000);
+      Check<int>(
+          console, "missed before timeout", r.Searched(false), sturdr::ChannelState::REACQUIRING);
+    }
+    CheckWindow(console, "clamped window", r.Window(), 31, 10);
+    r.Elapse(999);
+    Check<int>(
+        console, "1 ms before timeout", r.Searched(false), sturdr::ChannelState::REACQUIRING);
+    r.Elapse(1);
+    Check<int>(console, "timed out", r.Searched(false), sturdr::ChannelState::ACQUIRING);
+  }
+
+  // a loss time of 0 never loses the track
+  {
+    sturdr::Reacquisition r(0, TIMEOUT_MS, WIDTH, RATE, D_RANGE, D_STEP);
+    r.Start(0.0, CONVERGE_MS);
+    Check(console, "never lost (ms)", LoseLock(r, 0.0), uint64_t{100000});
+  }
+
+  if (n_fail > 0) {
+    console->error("{} reacquisition steps went wrong!", n_fail);
+    return 1;
+  }
+  console->info("every loss of lock and reacquisition step is as expected!");
+  return 0;
+}
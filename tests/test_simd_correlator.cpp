@@ -0,0 +1,86 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <complex>
+#include <array>
+#include <random>
+#include <satutils/code-gen.hpp>
+
+#include "sturdr/gnss-signal.hpp"
+#include "sturdr/simd-correlator.hpp"
+#include "test-common.hpp"
+
+// one call of the Eigen AccumulateEPL overload at the currently selected simd level
+Epl Run(const Eigen::VectorXcd &signal, const std::array<bool, 1023> &code, double rem_code_phase) {
+  double code_freq = 1.023e6 + 1.7;
+  double carr_freq = TWO_PI * 5001234.5;
+  double carr_jit = 3.0;
+  double samp_freq = 20e6;
+  double t_space = 0.25;
+  uint64_t samp_remaining = static_cast<uint64_t>(signal.size());
+  uint64_t half_samp = samp_remaining / 2;
+  Epl r{0.0, 0.0, 0.0, 0.0, rem_code_phase, 0.3};
+  sturdr::AccumulateEPL(
+      signal,
+      code.data(),
+      r.rem_code_phase,
+      code_freq,
+      r.rem_carr_phase,
+      carr_freq,
+      carr_jit,
+      samp_freq,
+      half_samp,
+      samp_remaining,
+      t_space,
+      r.E,
+      r.P1,
+      r.P2,
+      r.L);
+  return r;
+}
+
+double MaxError(const Epl &a, const Epl &b) {
+  return std::max(
+      {std::abs(a.E - b.E),
+       std::abs(a.P1 - b.P1),
+       std::abs(a.P2 - b.P2),
+       std::abs(a.L - b.L),
+       std::abs(a.rem_code_phase - b.rem_code_phase),
+       std::abs(a.rem_carr_phase - b.rem_carr_phase)});
+}
+
+int main() {
+  std::shared_ptr<spdlog::logger> console = TestConsole("test_simd_correlator.cpp");
+
+  // random samples, 2 ms so every block crosses the code wrap at least once
+  std::mt19937 gen(42);
+  Eigen::VectorXcd signal = ComplexNoise(40000, gen);
+  std::array<bool, 1023> code;
+  satutils::CodeGenCA(code.data(), 7);
+
+  // negative remainder (the code starts after the block), start just before the wrap, mid code
+  const double phases[3] = {-3.7, 1022.6, 511.25};
+  const double tol = 1e-9;
+  sturdr::SimdLevel::SimdLevel best = sturdr::DetectSimdLevel();
+  int n_fail = 0;
+  for (const double &phase : phases) {
+    sturdr::SetSimdLevel(sturdr::SimdLevel::SCALAR);
+    Epl ref = Run(signal, code, phase);
+    for (int lvl = sturdr::SimdLevel::GENERIC; lvl <= static_cast<int>(best); lvl++) {
+      sturdr::SetSimdLevel(static_cast<sturdr::SimdLevel::SimdLevel>(lvl));
+      double err = MaxError(Run(signal, code, phase), ref) / std::max(1.0, std::abs(ref.P1));
+      if (err > tol) {
+        console->error("level {} rem_code_phase {}: error {:.3e}", lvl, phase, err);
+        n_fail++;
+      } else {
+        console->info("level {} rem_code_phase {}: error {:.3e}", lvl, phase, err);
+      }
+    }
+  }
+
+  if (n_fail > 0) {
+    console->error("{} simd kernels disagree with the scalar reference!", n_fail);
+    return 1;
+  }
+  console->info("every simd kernel matches the scalar reference!");
+  return 0;
+}